@@ -0,0 +1,169 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/BSpline.h>
+
+#include <cmath>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("B-spline evaluation.")
+{
+    GIVEN("A clamped cubic B-spline with 4 control points")
+    {
+        Position<2> p0{0., 0.};
+        Position<2> p1{1., 3.};
+        Position<2> p2{4., 3.};
+        Position<2> p3{5., 0.};
+        auto bspline = BSpline<3, 2>::ClampedUniform({p0, p1, p2, p3});
+
+        THEN("It is the Bezier curve over the same control points.")
+        {
+            Bezier<4, 2> bezier{p0, p1, p2, p3};
+            for (double t : {0., 0.2, 0.5, 0.75, 1.})
+            {
+                REQUIRE_THAT(bspline.evaluate(t), Approximates(evaluate(bezier, t), 1e-12));
+            }
+        }
+    }
+
+    GIVEN("A quadratic B-spline with a non-uniform clamped knot vector")
+    {
+        BSpline<2, 2> bspline{
+            {{0., 0.}, {1., 2.}, {3., 3.}, {5., 1.}, {6., 4.}},
+            {0., 0., 0., 1., 2.5, 3., 3., 3.},
+        };
+
+        THEN("Knot spans are found by binary search.")
+        {
+            CHECK(bspline.findSpan(0.) == 2);
+            CHECK(bspline.findSpan(0.5) == 2);
+            CHECK(bspline.findSpan(1.) == 3);
+            CHECK(bspline.findSpan(2.6) == 4);
+            CHECK(bspline.findSpan(3.) == 4);
+            CHECK(bspline.findSpan(-1.) == 2);
+        }
+
+        THEN("It interpolates its end control points.")
+        {
+            REQUIRE(bspline.evaluate(0.) == bspline.controlPoints().front());
+            REQUIRE_THAT(bspline.evaluate(3.), Approximates(bspline.controlPoints().back(), 1e-12));
+        }
+
+        THEN("Its derivative matches finite differences.")
+        {
+            const double h = 1e-6;
+            auto derivative = bspline.derivative();
+            for (double u : {0.3, 1., 1.7, 2.9})
+            {
+                Vec<2> finite = (bspline.evaluate(u + h) - bspline.evaluate(u - h)) / (2 * h);
+                REQUIRE_THAT(bspline.evaluateDerivative(u), Approximates(finite, 1e-5));
+                REQUIRE_THAT(derivative.evaluate(u).as<Vec>(), Approximates(bspline.evaluateDerivative(u), 1e-12));
+            }
+        }
+
+        THEN("Knot insertion does not change its shape.")
+        {
+            BSpline<2, 2> refined = bspline;
+            refined.insertKnot(1.7);
+            refined.insertKnot(1.);
+            REQUIRE(refined.controlPoints().size() == bspline.controlPoints().size() + 2);
+            for (double u = 0.; u <= 3.; u += 0.1)
+            {
+                REQUIRE_THAT(refined.evaluate(u), Approximates(bspline.evaluate(u), 1e-12));
+            }
+        }
+
+        THEN("It can be split into Bezier segments, one per knot span.")
+        {
+            std::vector<Bezier<3, 2>> segments = bspline.toBezierSegments();
+            const std::vector<double> breaks{0., 1., 2.5, 3.};
+            REQUIRE(segments.size() == 3);
+            for (std::size_t segmentId = 0; segmentId != segments.size(); ++segmentId)
+            {
+                const double low = breaks[segmentId];
+                const double high = breaks[segmentId + 1];
+                for (double s : {0., 0.25, 0.5, 1.})
+                {
+                    REQUIRE_THAT(evaluate(segments[segmentId], s),
+                                 Approximates(bspline.evaluate(low + s * (high - low)), 1e-12));
+                }
+            }
+        }
+    }
+
+    GIVEN("A cubic B-spline with an unclamped uniform knot vector")
+    {
+        BSpline<3, 3> bspline{
+            {{0., 0., 0.}, {1., 2., 0.}, {3., 3., 1.}, {5., 1., 2.}, {6., 4., 2.}, {8., 0., 0.}},
+            {0., 1., 2., 3., 4., 5., 6., 7., 8., 9.},
+        };
+
+        THEN("Its domain excludes the first and last degree spans.")
+        {
+            REQUIRE(bspline.domain() == std::pair{3., 6.});
+        }
+
+        THEN("It can be split into Bezier segments.")
+        {
+            std::vector<Bezier<4, 3>> segments = bspline.toBezierSegments();
+            REQUIRE(segments.size() == 3);
+            for (std::size_t segmentId = 0; segmentId != segments.size(); ++segmentId)
+            {
+                for (double s : {0., 0.3, 1.})
+                {
+                    REQUIRE_THAT(evaluate(segments[segmentId], s),
+                                 Approximates(bspline.evaluate(3. + segmentId + s), 1e-12));
+                }
+            }
+        }
+    }
+}
+
+
+SCENARIO("NURBS evaluation.")
+{
+    GIVEN("A quarter circle as a rational quadratic")
+    {
+        Nurbs<2, 2> quarter{
+            {{1., 0.}, {1., 1.}, {0., 1.}},
+            {1., std::sqrt(2.) / 2., 1.},
+            {0., 0., 0., 1., 1., 1.},
+        };
+
+        THEN("All its positions are on the unit circle.")
+        {
+            REQUIRE(quarter.evaluate(0.) == Position<2>{1., 0.});
+            REQUIRE_THAT(quarter.evaluate(1.), Approximates(Position<2>{0., 1.}, 1e-12));
+            for (double u = 0.; u <= 1.; u += 0.05)
+            {
+                REQUIRE(quarter.evaluate(u).as<Vec>().getNorm() == Approx(1.));
+            }
+        }
+
+        THEN("Its derivative is tangent to the circle, and matches finite differences.")
+        {
+            const double h = 1e-6;
+            for (double u : {0.1, 0.5, 0.8})
+            {
+                Vec<2> derivative = quarter.evaluateDerivative(u);
+                REQUIRE(derivative.dot(quarter.evaluate(u).as<Vec>()) == Approx(0.).margin(1e-12));
+                Vec<2> finite = (quarter.evaluate(u + h) - quarter.evaluate(u - h)) / (2 * h);
+                REQUIRE_THAT(derivative, Approximates(finite, 1e-5));
+            }
+        }
+
+        THEN("Its homogeneous Bezier segments project on the circle.")
+        {
+            auto segments = quarter.toHomogeneousBezierSegments();
+            REQUIRE(segments.size() == 1);
+            Position<3> homogeneous = evaluate(segments.front(), 0.3);
+            REQUIRE_THAT((Position<2>{homogeneous.x() / homogeneous.z(), homogeneous.y() / homogeneous.z()}),
+                         Approximates(quarter.evaluate(0.3), 1e-12));
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "catch.hpp"
+
+#include <math/Interpolation/BakedEasing.h>
+#include <math/Interpolation/ParameterAnimation.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    template <class T_easing, class T_reference>
+    double measureMaxError(const T_easing & aEasing, const T_reference & aReference)
+    {
+        double maxError = 0.;
+        for (int sample = 0; sample <= 10000; ++sample)
+        {
+            const double x = sample / 10000.;
+            maxError = std::max(maxError, std::abs(aEasing.ease(x) - aReference.ease(x)));
+        }
+        return maxError;
+    }
+
+
+    // Two segments, joined with aligned handles.
+    ease::Bezier<double> makeMultiSegmentBezier()
+    {
+        ease::Bezier<double> bezier;
+        const std::array<double, 7> x{0., 0.25, 0.35, 0.5, 0.65, 0.75, 1.};
+        const std::array<double, 7> y{0., 0., 0.4, 0.5, 0.6, 1., 1.};
+        std::copy(x.begin(), x.end(), bezier.mXValues.begin());
+        std::copy(y.begin(), y.end(), bezier.mYValues.begin());
+        bezier.mOnCurveCount = 3;
+        return bezier;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Baked easing.")
+{
+    GIVEN("A smoothstep baked with linear reconstruction")
+    {
+        ease::BakedEase<double, ease::SmoothStep, 65> baked;
+        ease::SmoothStep<double> smoothStep;
+
+        THEN("It is exact at the samples and the ends.")
+        {
+            CHECK(baked.ease(0.) == 0.);
+            CHECK(baked.ease(1.) == 1.);
+            CHECK(baked.ease(0.5) == smoothStep.ease(0.5));
+            CHECK(baked.ease(0.25) == smoothStep.ease(0.25));
+        }
+
+        THEN("Inputs outside of [0, 1] are clamped.")
+        {
+            CHECK(baked.ease(-1.) == 0.);
+            CHECK(baked.ease(2.) == 1.);
+        }
+
+        THEN("The error is within the documented bound.")
+        {
+            // |f''| = |6 - 12x| <= 6
+            const double bound = baked.getErrorBound(6.);
+            CHECK(baked.getBakingError() <= bound);
+            CHECK(measureMaxError(baked, smoothStep) <= bound);
+            // The bound is reached at the middle of the first interval.
+            CHECK(baked.getBakingError() == Approx(bound).epsilon(0.05));
+        }
+    }
+
+    GIVEN("A smoothstep baked with cubic Hermite reconstruction")
+    {
+        ease::BakedEase<double, ease::SmoothStep, 5, ease::Reconstruction::CubicHermite> baked;
+
+        THEN("The cubic is reconstructed exactly, even with few samples.")
+        {
+            CHECK(baked.getBakingError() <= 1e-9);
+            CHECK(measureMaxError(baked, ease::SmoothStep<double>{}) <= 1e-9);
+        }
+    }
+
+    GIVEN("A Bezier easing with several segments")
+    {
+        const ease::Bezier<double> bezier = makeMultiSegmentBezier();
+
+        ease::BakedEase<double, ease::Bezier, 256> linear{bezier};
+        ease::BakedEase<double, ease::Bezier, 256, ease::Reconstruction::CubicHermite> hermite{bezier};
+
+        THEN("The baked easings approximate it.")
+        {
+            CHECK(bezier.ease(0.5) == Approx(0.5));
+            CHECK(measureMaxError(linear, bezier) <= 1e-4);
+            CHECK(measureMaxError(hermite, bezier) <= 1e-5);
+            CHECK(hermite.getBakingError() <= linear.getBakingError());
+        }
+
+        THEN("The knots are the ones of the source.")
+        {
+            REQUIRE(linear.getKnots() == bezier.getKnots());
+        }
+    }
+
+    GIVEN("A clamped animation with a baked easing")
+    {
+        const double period = 2.;
+        auto animation = makeParameterAnimation<Clamp, None, ease::Baked<ease::SmoothStep>::type>(period);
+        auto reference = makeParameterAnimation<Clamp, None, ease::SmoothStep>(period);
+
+        THEN("It follows the source easing.")
+        {
+            CHECK(animation.at(0.) == 0.);
+            CHECK(animation.at(period) == 1.);
+            for (double time : {0.2, 0.5, 1., 1.7})
+            {
+                CHECK(animation.at(time) == Approx(reference.at(time)).margin(1e-5));
+            }
+            CHECK(animation.at(3 * period) == 1.);
+        }
+    }
+
+    GIVEN("A full range periodic animation baking a Bezier easing")
+    {
+        const double period = 0.5;
+        const ease::Bezier<double> bezier = makeMultiSegmentBezier();
+        ParameterAnimation<double, FullRange, periodic::Repeat,
+                           ease::Baked<ease::Bezier, 512, ease::Reconstruction::CubicHermite>::type>
+            animation{bezier, period};
+
+        THEN("It follows the source easing, scaled by the period.")
+        {
+            for (double time : {0.1, 0.3, 0.6, 0.85})
+            {
+                const double normalized = std::fmod(time, period) / period;
+                CHECK(animation.at(time) == Approx(bezier.ease(normalized) * period).margin(1e-4));
+            }
+        }
+    }
+
+    GIVEN("Animations sharing a baked Bezier easing")
+    {
+        using Baked_t = ease::Baked<ease::Bezier, 512, ease::Reconstruction::CubicHermite>;
+        const ease::Bezier<double> bezier = makeMultiSegmentBezier();
+        const Baked_t::type<double> baked{bezier};
+
+        std::vector<ParameterAnimation<double, Clamp, None, Baked_t::shared>> animations;
+        for (double period : {0.5, 1., 2.})
+        {
+            animations.emplace_back(baked, period);
+        }
+        ParameterAnimation<double, Clamp, None, Baked_t::type> owning{bezier, 2.};
+
+        THEN("They reference its table instead of copying it.")
+        {
+            CHECK(sizeof(Baked_t::shared<double>) == sizeof(void *));
+            CHECK(&animations[1].mEaser.getBaked() == &baked);
+            CHECK(animations[2].getKnots() == bezier.getKnots());
+        }
+
+        THEN("They ease as an animation owning the baked easing.")
+        {
+            for (double time : {0., 0.2, 0.45, 1., 1.7, 2., 3.})
+            {
+                REQUIRE(animations[2].at(time) == owning.at(time));
+                REQUIRE(animations[0].at(time / 4) == Approx(owning.at(time)).margin(1e-12));
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/BezierPatch.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    // Bicubic height field over [0, 3]^2.
+    BezierPatch<4, 4, 3> makeBicubic()
+    {
+        return {
+            Position<3>{0., 0., 0.}, Position<3>{1., 0., 1.}, Position<3>{2., 0., -1.}, Position<3>{3., 0., 0.},
+            Position<3>{0., 1., 2.}, Position<3>{1., 1., 3.}, Position<3>{2., 1., 0.}, Position<3>{3., 1., 1.},
+            Position<3>{0., 2., -1.}, Position<3>{1., 2., 0.}, Position<3>{2., 2., 4.}, Position<3>{3., 2., 2.},
+            Position<3>{0., 3., 0.}, Position<3>{1., 3., 1.}, Position<3>{2., 3., 1.}, Position<3>{3., 3., 0.},
+        };
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Bezier patch evaluation.")
+{
+    GIVEN("A bilinear patch")
+    {
+        BezierPatch<2, 2, 3> bilinear{
+            Position<3>{0., 0., 0.}, Position<3>{2., 0., 0.},
+            Position<3>{0., 4., 0.}, Position<3>{2., 4., 0.},
+        };
+
+        THEN("It interpolates its corners, and is planar.")
+        {
+            REQUIRE(evaluate(bilinear, 0., 0.) == bilinear.at(0, 0));
+            REQUIRE(evaluate(bilinear, 1., 0.) == bilinear.at(1, 0));
+            REQUIRE(evaluate(bilinear, 0., 1.) == bilinear.at(0, 1));
+            REQUIRE(evaluate(bilinear, 1., 1.) == bilinear.at(1, 1));
+            REQUIRE_THAT(evaluate(bilinear, 0.25, 0.5), Approximates(Position<3>{0.5, 2., 0.}, 1e-12));
+        }
+
+        THEN("Its partial derivatives are the edges, and its normal is along z.")
+        {
+            REQUIRE_THAT(evaluatePartialU(bilinear, 0.3, 0.6), Approximates(Vec<3>{2., 0., 0.}, 1e-12));
+            REQUIRE_THAT(evaluatePartialV(bilinear, 0.3, 0.6), Approximates(Vec<3>{0., 4., 0.}, 1e-12));
+            REQUIRE_THAT(normal(bilinear, 0.5, 0.5), Approximates(UnitVec<3>{Vec<3>{0., 0., 1.}}, 1e-12));
+        }
+    }
+
+    GIVEN("A bicubic patch")
+    {
+        BezierPatch<4, 4, 3> bicubic = makeBicubic();
+
+        THEN("Its rows and columns are its control points curves.")
+        {
+            REQUIRE(bicubic.getRow(1) == Bezier<4, 3>{
+                Position<3>{0., 1., 2.}, Position<3>{1., 1., 3.}, Position<3>{2., 1., 0.}, Position<3>{3., 1., 1.}});
+            REQUIRE(bicubic.getColumn(2) == Bezier<4, 3>{
+                Position<3>{2., 0., -1.}, Position<3>{2., 1., 0.}, Position<3>{2., 2., 4.}, Position<3>{2., 3., 1.}});
+        }
+
+        THEN("Its tensor product evaluation matches evaluating the rows, then the resulting column.")
+        {
+            for (double u : {0., 0.2, 0.7})
+            {
+                for (double v : {0.1, 0.5, 1.})
+                {
+                    Bezier<4, 3> column{
+                        evaluate(bicubic.getRow(0), u), evaluate(bicubic.getRow(1), u),
+                        evaluate(bicubic.getRow(2), u), evaluate(bicubic.getRow(3), u)};
+                    REQUIRE_THAT(evaluate(bicubic, u, v), Approximates(evaluate(column, v), 1e-12));
+                }
+            }
+        }
+
+        THEN("Its partial derivatives match finite differences, and its normal is orthogonal to them.")
+        {
+            const double h = 1e-6;
+            for (double u : {0.2, 0.5, 0.9})
+            {
+                for (double v : {0.1, 0.6})
+                {
+                    Vec<3> partialU = (evaluate(bicubic, u + h, v) - evaluate(bicubic, u - h, v)) / (2 * h);
+                    Vec<3> partialV = (evaluate(bicubic, u, v + h) - evaluate(bicubic, u, v - h)) / (2 * h);
+                    REQUIRE_THAT(evaluatePartialU(bicubic, u, v), Approximates(partialU, 1e-6));
+                    REQUIRE_THAT(evaluatePartialV(bicubic, u, v), Approximates(partialV, 1e-6));
+
+                    UnitVec<3> n = normal(bicubic, u, v);
+                    REQUIRE(n.dot(partialU) == Approx(0.).margin(1e-6));
+                    REQUIRE(n.dot(partialV) == Approx(0.).margin(1e-6));
+                    // The height field is oriented upward.
+                    REQUIRE(n.z() > 0.);
+                }
+            }
+        }
+    }
+}
+
+
+SCENARIO("Bezier patch tessellation.")
+{
+    GIVEN("A bicubic patch")
+    {
+        BezierPatch<4, 4, 3> bicubic = makeBicubic();
+
+        THEN("The vertex grid is evaluated row by row, with exact corners.")
+        {
+            const std::size_t uCount = 9;
+            const std::size_t vCount = 5;
+            std::vector<Position<3>> vertices(uCount * vCount, Position<3>::Zero());
+            tessellate(bicubic, uCount, vCount, std::span<Position<3>>{vertices});
+
+            for (std::size_t v = 0; v != vCount; ++v)
+            {
+                for (std::size_t u = 0; u != uCount; ++u)
+                {
+                    REQUIRE_THAT(vertices[v * uCount + u],
+                                 Approximates(evaluate(bicubic, u / double(uCount - 1), v / double(vCount - 1)), 1e-12));
+                }
+            }
+            REQUIRE(vertices.front() == bicubic.at(0, 0));
+            REQUIRE(vertices[uCount - 1] == bicubic.at(3, 0));
+            REQUIRE(vertices[(vCount - 1) * uCount] == bicubic.at(0, 3));
+            REQUIRE(vertices.back() == bicubic.at(3, 3));
+        }
+    }
+}
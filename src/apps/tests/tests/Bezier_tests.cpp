@@ -1,8 +1,15 @@
 #include "catch.hpp"
 
+#include "CustomCatchMatchers.h"
+
 #include <math/Interpolation/Interpolation.h>
 #include <math/Curves/Bezier.h>
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
 
 using namespace ad::math;
 
@@ -113,3 +120,293 @@ SCENARIO("Bezier evaluation and subdivision")
         }
     }
 }
+
+
+SCENARIO("Bezier tessellation")
+{
+    GIVEN("A degree 4 Bezier (cubic)")
+    {
+        Bezier<4, 2> bezier{
+            Position<2>{-200.,   0.},
+            Position<2>{-100., 500.},
+            Position<2>{ 100., 450.},
+            Position<2>{ 300., -20.},
+        };
+
+        THEN("Its power basis form evaluates to the same positions.")
+        {
+            auto coefficients = toPowerBasis(bezier);
+            for (double t : {0., 0.2, 0.5, 0.9, 1.})
+            {
+                Vec<2> value = coefficients[0] + t * coefficients[1] + t * t * coefficients[2]
+                               + t * t * t * coefficients[3];
+                REQUIRE_THAT(value.as<Position>(), Approximates(evaluate(bezier, t), 1e-9));
+            }
+        }
+
+        WHEN("It is tessellated in a buffer")
+        {
+            std::vector<Position<2>> samples(101, Position<2>::Zero());
+            tessellate(bezier, samples);
+
+            THEN("The samples are the evaluations at evenly spaced parameters.")
+            {
+                REQUIRE(samples.front() == bezier.start());
+                REQUIRE(samples.back() == bezier.end());
+                for (std::size_t sampleId = 0; sampleId != samples.size(); ++sampleId)
+                {
+                    REQUIRE_THAT(samples[sampleId], Approximates(evaluate(bezier, sampleId / 100.), 1e-8));
+                }
+            }
+        }
+    }
+
+    GIVEN("Bezier curves of other degrees")
+    {
+        Bezier<2, 3> line{Position<3>{0., 0., 0.}, Position<3>{3., 6., 9.}};
+        Bezier<6, 1> quintic{
+            Position<1>{0.}, Position<1>{5.}, Position<1>{-3.}, Position<1>{2.}, Position<1>{8.}, Position<1>{1.}};
+
+        THEN("They can be tessellated, including in less samples than control points.")
+        {
+            std::array<Position<3>, 4> lineSamples = makeFilledArray<4>(Position<3>::Zero());
+            tessellate(line, std::span<Position<3>>{lineSamples});
+            REQUIRE(lineSamples[1] == Position<3>{1., 2., 3.});
+
+            for (std::size_t count : {1, 2, 3, 17})
+            {
+                std::vector<Position<1>> samples(count, Position<1>::Zero());
+                tessellate(quintic, samples);
+                REQUIRE(samples.front() == quintic.start());
+                for (std::size_t sampleId = 1; sampleId + 1 < count; ++sampleId)
+                {
+                    REQUIRE_THAT(samples[sampleId],
+                                 Approximates(evaluate(quintic, sampleId / double(count - 1)), 1e-9));
+                }
+            }
+        }
+    }
+}
+
+
+namespace {
+
+
+    template <int N_dimension>
+    double distanceToPolyline(Position<N_dimension> aPosition, const std::vector<Position<N_dimension>> & aPolyline)
+    {
+        double result = std::numeric_limits<double>::max();
+        for (std::size_t vertexId = 0; vertexId + 1 < aPolyline.size(); ++vertexId)
+        {
+            Vec<N_dimension> edge = aPolyline[vertexId + 1] - aPolyline[vertexId];
+            Vec<N_dimension> offset = aPosition - aPolyline[vertexId];
+            double ratio = std::clamp(offset.dot(edge) / edge.getNormSquared(), 0., 1.);
+            result = std::min(result, (offset - ratio * edge).getNorm());
+        }
+        return result;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Bezier adaptive flattening")
+{
+    GIVEN("A degree 4 Bezier (cubic)")
+    {
+        Bezier<4, 2> bezier{
+            Position<2>{-200.,   0.},
+            Position<2>{-100., 500.},
+            Position<2>{ 100., 450.},
+            Position<2>{ 300., -20.},
+        };
+
+        THEN("The polyline stays within tolerance of the curve, with less vertices for larger tolerances.")
+        {
+            std::size_t previousCount = std::numeric_limits<std::size_t>::max();
+            for (double tolerance : {0.1, 1., 10.})
+            {
+                std::vector<Position<2>> polyline;
+                flatten(bezier, tolerance, std::back_inserter(polyline));
+
+                REQUIRE(polyline.front() == bezier.start());
+                REQUIRE(polyline.back() == bezier.end());
+                REQUIRE(polyline.size() < previousCount);
+                previousCount = polyline.size();
+
+                for (double t = 0.; t <= 1.; t += 0.001)
+                {
+                    REQUIRE(distanceToPolyline(evaluate(bezier, t), polyline) <= tolerance);
+                }
+            }
+        }
+    }
+
+    GIVEN("A straight Bezier")
+    {
+        Bezier<3, 3> straight{Position<3>{0., 0., 0.}, Position<3>{1., 1., 1.}, Position<3>{4., 4., 4.}};
+
+        THEN("It is flattened to a single segment.")
+        {
+            std::vector<Position<3>> polyline;
+            flatten(straight, 0.01, std::back_inserter(polyline));
+            REQUIRE(polyline == std::vector<Position<3>>{straight.start(), straight.end()});
+        }
+    }
+
+    GIVEN("A closed loop Bezier, with coinciding endpoints")
+    {
+        Bezier<4, 2> loop{Position<2>{0., 0.}, Position<2>{10., 10.}, Position<2>{-10., 10.}, Position<2>{0., 0.}};
+
+        THEN("It is still subdivided.")
+        {
+            std::vector<Position<2>> polyline;
+            flatten(loop, 0.05, std::back_inserter(polyline));
+            REQUIRE(polyline.size() > 4);
+            for (double t = 0.; t <= 1.; t += 0.01)
+            {
+                REQUIRE(distanceToPolyline(evaluate(loop, t), polyline) <= 0.05);
+            }
+        }
+    }
+}
+
+
+SCENARIO("Bezier differential geometry")
+{
+    GIVEN("A cubic Bezier")
+    {
+        Bezier<4, 2> bezier{
+            Position<2>{-200.,   0.},
+            Position<2>{-100., 500.},
+            Position<2>{ 100., 450.},
+            Position<2>{ 300., -20.},
+        };
+
+        THEN("Its derivatives match finite differences.")
+        {
+            const double h = 1e-5;
+            for (double t : {0.1, 0.5, 0.8})
+            {
+                Vec<2> velocity = (evaluate(bezier, t + h) - evaluate(bezier, t - h)) / (2 * h);
+                REQUIRE_THAT(evaluateDerivative(bezier, t), Approximates(velocity, 1e-4));
+
+                Vec<2> acceleration = (evaluateDerivative(bezier, t + h) - evaluateDerivative(bezier, t - h)) / (2 * h);
+                REQUIRE_THAT(evaluateSecondDerivative(bezier, t), Approximates(acceleration, 1e-4));
+            }
+        }
+
+        THEN("Its hodograph evaluates to its derivative.")
+        {
+            Bezier<3, 2> hodograph = derivative(bezier);
+            for (double t : {0., 0.3, 1.})
+            {
+                REQUIRE_THAT(evaluate(hodograph, t).as<Vec>(), Approximates(evaluateDerivative(bezier, t), 1e-9));
+            }
+        }
+
+        THEN("Its tangents are unit vectors along the derivative.")
+        {
+            UnitVec<2> startTangent = tangent(bezier, 0.);
+            REQUIRE_THAT(startTangent, Approximates(UnitVec<2>{bezier[1] - bezier[0]}, 1e-12));
+            REQUIRE(tangent(bezier, 0.4).getNorm() == Approx(1.));
+        }
+
+        THEN("Its bounding box contains the curve, and is tight.")
+        {
+            Rectangle<double> bounds = boundingBox(bezier);
+
+            Position<2> low = bezier.start();
+            Position<2> high = bezier.start();
+            for (double t = 0.; t <= 1.; t += 1e-4)
+            {
+                Position<2> sample = evaluate(bezier, t);
+                REQUIRE(bounds.contains(sample));
+                low = min(low, sample);
+                high = max(high, sample);
+            }
+            REQUIRE_THAT(bounds.origin(), Approximates(low, 1e-3));
+            REQUIRE_THAT(bounds.topRight(), Approximates(high, 1e-3));
+        }
+    }
+
+    GIVEN("A Bezier with its start handle on its start point")
+    {
+        Bezier<4, 2> bezier{Position<2>{0., 0.}, Position<2>{0., 0.}, Position<2>{1., 1.}, Position<2>{2., 0.}};
+
+        THEN("Its start tangent is taken from the second derivative.")
+        {
+            REQUIRE_THAT(tangent(bezier, 0.), Approximates(UnitVec<2>{Vec<2>{1., 1.}}, 1e-12));
+        }
+    }
+
+    GIVEN("A quadratic Bezier describing the parabola y = x^2")
+    {
+        Bezier<3, 2> parabola{Position<2>{-1., 1.}, Position<2>{0., -1.}, Position<2>{1., 1.}};
+
+        THEN("Its curvature matches the analytic curvature.")
+        {
+            // Parameterization is x = 2t - 1, curvature of y = x^2 is 2 / (1 + 4x^2)^(3/2).
+            for (double t : {0., 0.25, 0.5, 0.9})
+            {
+                const double x = 2 * t - 1;
+                REQUIRE(curvature(parabola, t) == Approx(2. / std::pow(1 + 4 * x * x, 1.5)));
+            }
+        }
+
+        THEN("Its bounding box touches the vertex.")
+        {
+            REQUIRE(boundingBox(parabola) == Rectangle<double>{{-1., 0.}, {2., 1.}});
+        }
+    }
+
+    GIVEN("A straight Bezier")
+    {
+        Bezier<4, 3> straight{
+            Position<3>{0., 0., 0.}, Position<3>{1., 2., 3.}, Position<3>{2., 4., 6.}, Position<3>{3., 6., 9.}};
+
+        THEN("Its curvature is null.")
+        {
+            REQUIRE(curvature(straight, 0.3) == Approx(0.).margin(1e-12));
+        }
+    }
+
+    GIVEN("A 3D cubic Bezier")
+    {
+        Bezier<4, 3> bezier{
+            Position<3>{0., 0., 0.}, Position<3>{1., 3., -2.}, Position<3>{3., -1., 4.}, Position<3>{4., 1., 0.}};
+
+        THEN("Its bounding box contains the curve, and is tight.")
+        {
+            Box<double> bounds = boundingBox(bezier);
+            Position<3> low = bezier.start();
+            Position<3> high = bezier.start();
+            for (double t = 0.; t <= 1.; t += 1e-4)
+            {
+                Position<3> sample = evaluate(bezier, t);
+                REQUIRE(bounds.contains(sample));
+                low = min(low, sample);
+                high = max(high, sample);
+            }
+            REQUIRE_THAT(bounds.origin(), Approximates(low, 1e-6));
+            REQUIRE_THAT((bounds.origin() + bounds.dimension().as<Vec>()), Approximates(high, 1e-6));
+        }
+    }
+
+    GIVEN("A quintic Bezier")
+    {
+        Bezier<6, 2> quintic{
+            Position<2>{0., 0.}, Position<2>{1., 4.}, Position<2>{2., -3.},
+            Position<2>{3., 5.}, Position<2>{4., -2.}, Position<2>{5., 1.}};
+
+        THEN("Its bounding box, from the control points, contains the curve.")
+        {
+            Rectangle<double> bounds = boundingBox(quintic);
+            REQUIRE(bounds == Rectangle<double>{{0., -3.}, {5., 8.}});
+            for (double t = 0.; t <= 1.; t += 1e-3)
+            {
+                REQUIRE(bounds.contains(evaluate(quintic, t)));
+            }
+        }
+    }
+}
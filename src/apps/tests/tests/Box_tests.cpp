@@ -255,6 +255,33 @@ SCENARIO("Box growing from points.")
 }
 
 
+SCENARIO("Box from points.")
+{
+    GIVEN("A set of points")
+    {
+        std::vector<Position<3>> points{
+            {1., 2., 3.},
+            {-5., 10., 0.},
+            {4., -1., 8.},
+            {0., 0., -2.},
+        };
+
+        THEN("The bulk construction gives the same box as growing a box one point at a time.")
+        {
+            Box<double> grown{points.front(), Size<3>::Zero()};
+            for (auto point : points)
+            {
+                grown.extendTo(point);
+            }
+
+            Box<double> bulk = Box<double>::FromPoints(points);
+            REQUIRE(bulk == grown);
+            REQUIRE(bulk == Box<double>{{-5., -1., -2.}, {9., 11., 10.}});
+        }
+    }
+}
+
+
 SCENARIO("Box boolean operations.")
 {
     GIVEN("A box")
@@ -2,6 +2,9 @@
 
 #include <math/Curves/CardinalCubic.h>
 
+#include <iterator>
+#include <vector>
+
 
 using namespace ad::math;
 
@@ -61,6 +64,25 @@ SCENARIO("Cardinal Cubic curve API.")
 
             REQUIRE(catmullRom.toBezier() == expectedBezier);
         }
+
+        THEN("It can be tessellated")
+        {
+            std::array<Position<2>, 5> samples = makeFilledArray<5>(Position<2>::Zero());
+            tessellate(catmullRom, std::span<Position<2>>{samples});
+            for (std::size_t sampleId = 0; sampleId != samples.size(); ++sampleId)
+            {
+                REQUIRE(samples[sampleId].equalsWithinTolerance(expectedPositions[sampleId], gEpsilon));
+            }
+        }
+
+        THEN("It can be flattened")
+        {
+            std::vector<Position<2>> polyline;
+            flatten(catmullRom, 0.01, std::back_inserter(polyline));
+            REQUIRE(polyline.front() == b);
+            REQUIRE(polyline.back() == c);
+            REQUIRE(polyline.size() > 2);
+        }
     }
 }
 
@@ -107,3 +129,40 @@ SCENARIO("Cardinal Cubic comparison.")
         }
     }
 }
+
+
+SCENARIO("Cardinal Cubic differential geometry.")
+{
+    GIVEN("A Catmull-Rom cubic")
+    {
+        CardinalCubic<2> catmullRom{
+            0., Position<2>{-100., -60.}, Position<2>{-20., 20.}, Position<2>{20., 20.}, Position<2>{100., -60.}};
+
+        THEN("Its bounding box contains the curve.")
+        {
+            Rectangle<double> bounds = boundingBox(catmullRom);
+            REQUIRE(bounds == boundingBox(catmullRom.toBezier()));
+            for (double t = 0.; t <= 1.; t += 1e-3)
+            {
+                // Cardinal evaluation rounds differently than the equivalent Bezier.
+                Position<2> sample = catmullRom.evaluate(t);
+                REQUIRE(sample.x() >= bounds.xMin() - 1e-9);
+                REQUIRE(sample.x() <= bounds.xMax() + 1e-9);
+                REQUIRE(sample.y() >= bounds.yMin() - 1e-9);
+                REQUIRE(sample.y() <= bounds.yMax() + 1e-9);
+            }
+            // The curve overshoots the segment between its end points.
+            REQUIRE(bounds.yMax() > 20.);
+        }
+
+        THEN("Its tangents follow its derivative.")
+        {
+            for (double t : {0., 0.5, 1.})
+            {
+                REQUIRE(tangent(catmullRom, t).dot(catmullRom.evaluateDerivative(t))
+                        == Approx(catmullRom.evaluateDerivative(t).getNorm()));
+            }
+            REQUIRE(curvature(catmullRom, 0.5) == Approx(curvature(catmullRom.toBezier(), 0.5)));
+        }
+    }
+}
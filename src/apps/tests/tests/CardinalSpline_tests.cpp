@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/CardinalSpline.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Cardinal spline evaluation.")
+{
+    GIVEN("A Catmull-Rom spline over several control points")
+    {
+        std::vector<Position<2>> points{
+            {-10., 0.}, {0., 0.}, {10., 5.}, {15., 20.}, {5., 30.}, {-5., 25.}, {-10., 10.},
+        };
+        CardinalSpline<2> spline{0., points};
+
+        THEN("It has a segment for each inner pair of control points.")
+        {
+            REQUIRE(spline.segmentCount() == 4);
+            REQUIRE(spline.getSegment(1) == CardinalCubic<2>{0., points[1], points[2], points[3], points[4]});
+        }
+
+        THEN("It interpolates the inner control points at integral parameters.")
+        {
+            for (std::size_t segmentId = 0; segmentId <= spline.segmentCount(); ++segmentId)
+            {
+                REQUIRE_THAT(spline.evaluate(static_cast<double>(segmentId)),
+                             Approximates(points[segmentId + 1], 1e-12));
+            }
+        }
+
+        THEN("It evaluates each segment over its parameter range.")
+        {
+            REQUIRE(spline.evaluate(2.25) == spline.getSegment(2).evaluate(0.25));
+            REQUIRE(spline.evaluate(-1.) == spline.evaluate(0.));
+            REQUIRE(spline.evaluate(10.) == spline.evaluate(4.));
+        }
+
+        THEN("Its derivative matches finite differences.")
+        {
+            const double h = 1e-6;
+            for (double parameter : {0.3, 1.5, 3.9})
+            {
+                Vec<2> finite = (spline.evaluate(parameter + h) - spline.evaluate(parameter - h)) / (2 * h);
+                REQUIRE_THAT(spline.evaluateDerivative(parameter), Approximates(finite, 1e-5));
+            }
+        }
+    }
+}
+
+
+SCENARIO("Cardinal spline arc length parameterization.")
+{
+    GIVEN("A Catmull-Rom spline over evenly spaced collinear points")
+    {
+        CardinalSpline<3> spline{0., {{0., 0., 0.}, {1., 0., 0.}, {2., 0., 0.}, {3., 0., 0.}, {4., 0., 0.}}};
+
+        THEN("Its length is the distance between the inner control points, traversed linearly.")
+        {
+            REQUIRE(spline.getLength() == Approx(2.));
+            REQUIRE_THAT(spline.evaluateAtDistance(0.5), Approximates(Position<3>{1.5, 0., 0.}, 1e-12));
+            REQUIRE_THAT(spline.evaluateAtDistance(1.75), Approximates(Position<3>{2.75, 0., 0.}, 1e-12));
+        }
+    }
+
+    GIVEN("A curved cardinal spline")
+    {
+        std::vector<Position<2>> points{
+            {-10., 0.}, {0., 0.}, {10., 5.}, {15., 20.}, {5., 30.}, {-5., 25.}, {-10., 10.},
+        };
+        CardinalSpline<2> spline{0.3, points};
+
+        THEN("Its length matches a dense polyline approximation.")
+        {
+            double polylineLength = 0.;
+            const int sampleCount = 40000;
+            for (int sampleId = 0; sampleId != sampleCount; ++sampleId)
+            {
+                const double step = spline.segmentCount() / double(sampleCount);
+                polylineLength += (spline.evaluate((sampleId + 1) * step) - spline.evaluate(sampleId * step)).getNorm();
+            }
+            REQUIRE(spline.getLength() == Approx(polylineLength).epsilon(1e-6));
+        }
+
+        THEN("Evaluation at distance has constant speed.")
+        {
+            const double step = spline.getLength() / 1000;
+            for (int sampleId = 0; sampleId != 1000; ++sampleId)
+            {
+                const double travelled =
+                    (spline.evaluateAtDistance((sampleId + 1) * step) - spline.evaluateAtDistance(sampleId * step))
+                    .getNorm();
+                // The chord is slightly shorter than the arc.
+                REQUIRE(travelled == Approx(step).epsilon(1e-3));
+            }
+        }
+
+        THEN("A cursor returns the same positions as the spline, for increasing or decreasing distances.")
+        {
+            CardinalSpline<2>::Cursor cursor{spline};
+            for (double distance = 0.; distance <= spline.getLength(); distance += 0.37)
+            {
+                REQUIRE(cursor.getParameterAtDistance(distance) == spline.getParameterAtDistance(distance));
+            }
+            for (double distance : {12., 3., 50., 0.})
+            {
+                REQUIRE(cursor.evaluateAtDistance(distance) == spline.evaluateAtDistance(distance));
+            }
+            REQUIRE(cursor.getParameterAtDistance(spline.getLength() + 1.) == Approx(spline.segmentCount()));
+        }
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <math/Matrix.h>
 #include <math/Vector.h>
+#include <math/Curves/CardinalCubic.h>
+#include <math/Interpolation/ParameterAnimation.h>
 
 
 using namespace ad::math;
@@ -315,3 +317,68 @@ SCENARIO("Specialized vector types can be constant expressions")
         }
     }
 }
+
+
+SCENARIO("Curves can be evaluated in constant expressions")
+{
+    GIVEN("A constexpr cubic Bezier")
+    {
+        constexpr Bezier<4, 2> cBezier{
+            Position<2>{0., 0.}, Position<2>{0.5, 0.}, Position<2>{0.25, 1.}, Position<2>{1., 1.}};
+
+        THEN("Evaluation and subdivision are constant expressions")
+        {
+            constexpr Position<2> start = evaluate(cBezier, 0.);
+            REQUIRE(std::bool_constant<start == Position<2>{0., 0.}>::value);
+
+            constexpr auto halves = subdivide(cBezier, 0.5);
+            REQUIRE(std::bool_constant<halves.first.end() == evaluate(cBezier, 0.5)>::value);
+            REQUIRE(std::bool_constant<halves.second.start() == evaluate(cBezier, 0.5)>::value);
+
+            constexpr Vec<2> derivative = evaluateDerivative(cBezier, 0.);
+            REQUIRE(std::bool_constant<derivative == Vec<2>{1.5, 0.}>::value);
+        }
+
+        THEN("A table of its positions can be built at compile time")
+        {
+            constexpr auto table = makeSampledArray<256>([&](double t){ return evaluate(cBezier, t); });
+            REQUIRE(std::bool_constant<table.size() == 256>::value);
+            REQUIRE(std::bool_constant<table.front() == cBezier.start()>::value);
+            REQUIRE(std::bool_constant<table.back() == cBezier.end()>::value);
+            REQUIRE(table[100] == evaluate(cBezier, 100. / 255.));
+        }
+    }
+
+    GIVEN("A constexpr cardinal cubic")
+    {
+        constexpr CardinalCubic<2> cCardinal{
+            0.5, Position<2>{-1., 0.}, Position<2>{0., 0.}, Position<2>{1., 1.}, Position<2>{2., 1.}};
+
+        THEN("Its evaluation, and conversion to Bezier, are constant expressions")
+        {
+            constexpr Position<2> start = cCardinal.evaluate(0.);
+            REQUIRE(std::bool_constant<start == cCardinal[1]>::value);
+            constexpr Bezier<4, 2> bezier = cCardinal.toBezier();
+            REQUIRE(std::bool_constant<bezier.end() == cCardinal[2]>::value);
+        }
+    }
+}
+
+
+SCENARIO("Easing lookup tables can be generated at compile time")
+{
+    GIVEN("A 256 entries smooth step ramp")
+    {
+        constexpr auto ramp = makeSampledArray<256>([](double t){ return ease::SmoothStep<double>{}.ease(t); });
+
+        THEN("It is the easing function sampled over [0, 1]")
+        {
+            REQUIRE(std::bool_constant<ramp.front() == 0.>::value);
+            REQUIRE(std::bool_constant<ramp.back() == 1.>::value);
+            for (std::size_t entry = 0; entry != ramp.size(); ++entry)
+            {
+                REQUIRE(ramp[entry] == ease::SmoothStep<double>{}.ease(entry / 255.));
+            }
+        }
+    }
+}
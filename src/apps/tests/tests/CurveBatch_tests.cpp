@@ -0,0 +1,124 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/CurveBatch.h>
+
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    Position<3> makeRandomPosition(std::mt19937 & aEngine)
+    {
+        std::uniform_real_distribution<double> distribution{-100., 100.};
+        return {distribution(aEngine), distribution(aEngine), distribution(aEngine)};
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Bernstein coefficients.")
+{
+    GIVEN("Bezier curves of several degrees")
+    {
+        THEN("Their blending evaluation matches De Casteljau evaluation.")
+        {
+            Bezier<2, 1> line{Position<1>{2.}, Position<1>{6.}};
+            Bezier<5, 2> quartic{
+                Position<2>{0., 0.}, Position<2>{1., 3.}, Position<2>{4., -2.}, Position<2>{6., 5.}, Position<2>{8., 1.}};
+
+            for (double t : {0., 0.3, 0.5, 1.})
+            {
+                REQUIRE_THAT(evaluateBlending(line, t), Approximates(evaluate(line, t), 1e-12));
+                REQUIRE_THAT(evaluateBlending(quartic, t), Approximates(evaluate(quartic, t), 1e-12));
+            }
+            REQUIRE(getBernsteinCoefficients<4>(0.5) == Vec<4>{0.125, 0.375, 0.375, 0.125});
+        }
+    }
+}
+
+
+SCENARIO("Batch curve evaluation.")
+{
+    std::mt19937 engine{17};
+    const std::vector<double> parameters{0., 0.1, 0.25, 0.5, 0.8, 1.};
+
+    GIVEN("Many cubic Bezier curves")
+    {
+        std::vector<Bezier<4, 3>> curves;
+        CurveBatch<4, 3> batch;
+        for (int curveId = 0; curveId != 101; ++curveId)
+        {
+            curves.push_back({makeRandomPosition(engine), makeRandomPosition(engine),
+                              makeRandomPosition(engine), makeRandomPosition(engine)});
+            batch.push_back(curves.back());
+        }
+
+        THEN("The batch stores the coordinates contiguously.")
+        {
+            REQUIRE(batch.size() == curves.size());
+            REQUIRE(batch.coordinates(2, 1)[7] == curves[7][2].y());
+        }
+
+        THEN("Batch evaluation matches the individual evaluations.")
+        {
+            std::vector<Position<3>> positions(parameters.size() * batch.size(), Position<3>::Zero());
+            evaluateBezier<4, 3, double>(batch, parameters, positions);
+
+            for (std::size_t parameterId = 0; parameterId != parameters.size(); ++parameterId)
+            {
+                for (std::size_t curveId = 0; curveId != curves.size(); ++curveId)
+                {
+                    REQUIRE_THAT(positions[parameterId * batch.size() + curveId],
+                                 Approximates(evaluate(curves[curveId], parameters[parameterId]), 1e-10));
+                }
+            }
+        }
+
+        THEN("Structure of arrays output matches the individual evaluations.")
+        {
+            std::vector<double> x(batch.size()), y(batch.size()), z(batch.size());
+            batch.evaluate(getBernsteinCoefficients<4>(0.3), {x, y, z});
+            for (std::size_t curveId = 0; curveId != curves.size(); ++curveId)
+            {
+                REQUIRE_THAT((Position<3>{x[curveId], y[curveId], z[curveId]}),
+                             Approximates(evaluate(curves[curveId], 0.3), 1e-10));
+            }
+        }
+    }
+
+    GIVEN("Many cardinal cubics with the same tension")
+    {
+        const double tension = 0.2;
+        std::vector<CardinalCubic<3>> curves;
+        CurveBatch<4, 3> batch;
+        for (int curveId = 0; curveId != 37; ++curveId)
+        {
+            curves.push_back({tension, makeRandomPosition(engine), makeRandomPosition(engine),
+                              makeRandomPosition(engine), makeRandomPosition(engine)});
+            batch.push_back(curves.back());
+        }
+
+        THEN("Batch evaluation matches the individual evaluations.")
+        {
+            std::vector<Position<3>> positions(parameters.size() * batch.size(), Position<3>::Zero());
+            evaluateCardinal<3, double>(batch, tension, parameters, positions);
+
+            for (std::size_t parameterId = 0; parameterId != parameters.size(); ++parameterId)
+            {
+                for (std::size_t curveId = 0; curveId != curves.size(); ++curveId)
+                {
+                    REQUIRE_THAT(positions[parameterId * batch.size() + curveId],
+                                 Approximates(curves[curveId].evaluate(parameters[parameterId]), 1e-10));
+                }
+            }
+        }
+    }
+}
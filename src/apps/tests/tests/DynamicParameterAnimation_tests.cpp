@@ -0,0 +1,159 @@
+#include "catch.hpp"
+
+#include <math/Interpolation/DynamicParameterAnimation.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+using Dynamic = DynamicParameterAnimation<double>;
+
+
+SCENARIO("Dynamic ParameterAnimation matches the static combinations.")
+{
+    const double period = 2.;
+    const double speed = 3.;
+    const std::vector<double> inputs{-1., 0., 0.3, 1., 1.5, 2., 2.7, 5.};
+
+    GIVEN("A clamped smoothstep animation")
+    {
+        auto reference = makeParameterAnimation<Clamp, None, ease::SmoothStep>(period);
+        Dynamic animation{Clamp, None<double>{}, ease::SmoothStep<double>{}, period};
+
+        THEN("It produces the same values.")
+        {
+            for (double input : inputs)
+            {
+                REQUIRE(animation.at(input) == (double)reference.at(input));
+            }
+            CHECK(animation.isFinite() == reference.IsFinite());
+            CHECK(animation.isCompleted(period));
+            CHECK(animation.getOvershoot(2.5) == reference.getOvershoot(2.5));
+        }
+    }
+
+    GIVEN("A clamped periodic animation")
+    {
+        auto reference = makeParameterAnimation<Clamp, periodic::Repeat>(period);
+        Dynamic animation{Clamp, periodic::Repeat<double>{}, None<double>{}, period};
+
+        THEN("It produces the same values, and never completes.")
+        {
+            for (double input : inputs)
+            {
+                REQUIRE(animation.at(input) == (double)reference.at(input));
+            }
+            CHECK_FALSE(animation.isFinite());
+            CHECK_FALSE(animation.isCompleted(10 * period));
+            CHECK(animation.getOvershoot(10 * period) == 0.);
+        }
+    }
+
+    GIVEN("A full range ping-pong animation with a Bezier easing and a speed")
+    {
+        ease::Bezier<double> bezier;
+        bezier.addPoint(0.3);
+        bezier.changePoint(2, Position<2, double>{0.1, 0.6});
+
+        auto reference = ParameterAnimation<double, FullRange, periodic::PingPong, ease::Bezier>{
+            bezier, period, speed};
+        Dynamic animation{FullRange, periodic::PingPong<double>{}, &bezier, period, speed};
+
+        THEN("It produces the same values.")
+        {
+            for (double input : inputs)
+            {
+                REQUIRE(animation.at(input) == reference.at(input));
+            }
+            CHECK_FALSE(animation.isFinite());
+        }
+    }
+
+    GIVEN("A trivial full range animation")
+    {
+        auto reference = makeParameterAnimation<FullRange>(speed);
+        Dynamic animation{FullRange, None<double>{}, None<double>{}, period, speed};
+
+        THEN("It only applies the speed.")
+        {
+            for (double input : inputs)
+            {
+                REQUIRE(animation.at(input) == reference.at(input));
+            }
+            CHECK_FALSE(animation.isFinite());
+            CHECK_FALSE(animation.isCompleted(10 * period));
+        }
+    }
+}
+
+
+SCENARIO("Batch evaluation of dynamic ParameterAnimations.")
+{
+    ease::CubicSpline<double> spline{{0., 0.5, 1.}, {0., 0.8, 1.}};
+    ease::MassSpringDamper<double> spring{1., 10., 1.};
+
+    GIVEN("Heterogeneous animations, stored contiguously")
+    {
+        std::vector<Dynamic> animations{
+            {Clamp, None<double>{}, ease::SmoothStep<double>{}, 2.},
+            {FullRange, periodic::Repeat<double>{}, None<double>{}, 1.5, 2.},
+            {Clamp, None<double>{}, &spline, 4.},
+            {Clamp, None<double>{}, ease::SmoothStep<double>{}, 3.},
+            {FullRange, periodic::PingPong<double>{}, &spring, 1., 0.5},
+            {FullRange, periodic::Repeat<double>{}, None<double>{}, 0.5},
+            {Clamp, None<double>{}, ease::SmoothStep<double>{}, 1.},
+        };
+        std::vector<double> inputs;
+        for (std::size_t id = 0; id != animations.size(); ++id)
+        {
+            inputs.push_back(0.35 * id);
+        }
+
+        auto requireIndividualResults = [&]()
+        {
+            std::vector<double> results(animations.size());
+            at(std::span<const Dynamic>{animations}, std::span<const double>{inputs}, std::span<double>{results});
+            for (std::size_t id = 0; id != animations.size(); ++id)
+            {
+                REQUIRE(results[id] == animations[id].at(inputs[id]));
+            }
+        };
+
+        THEN("Batch evaluation gives the individual results.")
+        {
+            requireIndividualResults();
+        }
+
+        WHEN("They are sorted by kind")
+        {
+            std::vector<Dynamic> sorted = animations;
+            sortByKind(std::span<Dynamic>{sorted});
+
+            THEN("Animations of the same kind are consecutive, in their original order.")
+            {
+                for (std::size_t id = 1; id != sorted.size(); ++id)
+                {
+                    REQUIRE_FALSE(sorted[id].getKind() < sorted[id - 1].getKind());
+                }
+                // Full range repeating animations.
+                CHECK(sorted[0].getKind() == sorted[1].getKind());
+                CHECK(sorted[0].getPeriod() == 1.5);
+                CHECK(sorted[1].getPeriod() == 0.5);
+                // Clamped smoothstep animations.
+                CHECK(sorted[3].getKind() == sorted[4].getKind());
+                CHECK(sorted[4].getKind() == sorted[5].getKind());
+                CHECK(sorted[3].getPeriod() == 2.);
+                CHECK(sorted[4].getPeriod() == 3.);
+                CHECK(sorted[5].getPeriod() == 1.);
+            }
+
+            THEN("Batch evaluation still gives the individual results.")
+            {
+                animations = sorted;
+                requireIndividualResults();
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "catch.hpp"
+
+#include <math/Interpolation/FixedPointAnimation.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    // The fixed-point inputs, and their exact double values.
+    std::vector<Q16_16> makeInputs()
+    {
+        std::vector<Q16_16> inputs;
+        for (int sample = -200; sample <= 1000; ++sample)
+        {
+            inputs.push_back(Q16_16{sample * 0.0137});
+        }
+        return inputs;
+    }
+
+
+    // Compare the fixed-point animation to the double animation, at the same (representable) inputs.
+    template <class T_fixedAnimation, class T_doubleAnimation>
+    void requireSameOutputs(const T_fixedAnimation & aFixed,
+                            const T_doubleAnimation & aReference,
+                            int aToleranceSteps)
+    {
+        const double tolerance = aToleranceSteps * static_cast<double>(Q16_16::Epsilon());
+        for (Q16_16 input : makeInputs())
+        {
+            const double fixedOutput = static_cast<double>(static_cast<Q16_16>(aFixed.at(input)));
+            const double referenceOutput = aReference.at(static_cast<double>(input));
+            REQUIRE(fixedOutput == Approx(referenceOutput).margin(tolerance));
+        }
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Fixed-point ParameterAnimation matches the floating point one.")
+{
+    const Q16_16 period{2.5};
+    const double periodDouble = static_cast<double>(period);
+
+    GIVEN("A clamped animation")
+    {
+        auto animation = makeParameterAnimation<Clamp>(period);
+        auto reference = makeParameterAnimation<Clamp>(periodDouble);
+
+        THEN("Outputs are identical within the quantization.")
+        {
+            requireSameOutputs(animation, reference, 1);
+            CHECK(static_cast<Q16_16>(animation.at(Q16_16{-1})) == Q16_16{0});
+            CHECK(static_cast<Q16_16>(animation.at(Q16_16{10})) == Q16_16{1});
+            CHECK(animation.isCompleted(period));
+            CHECK_FALSE(animation.isCompleted(period - Q16_16::Epsilon()));
+        }
+    }
+
+    GIVEN("Full range repeating and ping-pong animations, with a speed")
+    {
+        const Q16_16 speed{1.5};
+        auto repeat = makeParameterAnimation<FullRange, periodic::Repeat>(period, speed);
+        auto repeatReference = makeParameterAnimation<FullRange, periodic::Repeat>(periodDouble, 1.5);
+        auto pingPong = makeParameterAnimation<FullRange, periodic::PingPong>(period, speed);
+        auto pingPongReference = makeParameterAnimation<FullRange, periodic::PingPong>(periodDouble, 1.5);
+
+        THEN("Outputs are identical within the quantization.")
+        {
+            requireSameOutputs(repeat, repeatReference, 1);
+            requireSameOutputs(pingPong, pingPongReference, 1);
+        }
+
+        THEN("Wrapping is exact.")
+        {
+            // The speed applies first.
+            CHECK(repeat.at(Q16_16{3}) == Q16_16{2});
+            CHECK(repeat.at(Q16_16{5}) == Q16_16{0});
+            CHECK(repeat.at(Q16_16{-1}) == Q16_16{1});
+            CHECK(pingPong.at(Q16_16{2}) == Q16_16{2});
+            CHECK(pingPong.at(Q16_16{4}) == Q16_16{1});
+        }
+    }
+
+    GIVEN("A clamped repeating animation with a fixed-point smoothstep")
+    {
+        auto animation = makeParameterAnimation<Clamp, periodic::Repeat, ease::SmoothStep>(period);
+        auto reference = makeParameterAnimation<Clamp, periodic::Repeat, ease::SmoothStep>(periodDouble);
+
+        THEN("Outputs are identical within the quantization.")
+        {
+            // Each rounded product of the polynomial evaluation adds to the error.
+            requireSameOutputs(animation, reference, 8);
+        }
+    }
+
+    GIVEN("A clamped animation with a baked easing")
+    {
+        ParameterAnimation<Q16_16, Clamp, None, ease::Baked<ease::SmoothStep, 65>::type> animation{period};
+        ParameterAnimation<double, Clamp, None, ease::Baked<ease::SmoothStep, 65>::type> reference{periodDouble};
+
+        THEN("Outputs are identical to the floating point table within the quantization.")
+        {
+            requireSameOutputs(animation, reference, 3);
+        }
+
+        THEN("The ends are exact.")
+        {
+            CHECK(static_cast<Q16_16>(animation.at(Q16_16{0})) == Q16_16{0});
+            CHECK(static_cast<Q16_16>(animation.at(period)) == Q16_16{1});
+        }
+    }
+
+    GIVEN("A baked Bezier easing")
+    {
+        ease::Bezier<double> bezier;
+        bezier.mXValues[1] = 0.6;
+        const ease::BakedEase<Q16_16, ease::Bezier> baked{bezier};
+
+        THEN("It can be rebuilt from its table.")
+        {
+            const ease::BakedEase<Q16_16, ease::Bezier> copy{bezier, baked.getTable()};
+            for (Q16_16 input : makeInputs())
+            {
+                REQUIRE(copy.ease(input) == baked.ease(input));
+            }
+        }
+
+        THEN("It approximates the source.")
+        {
+            for (int sample = 0; sample <= 100; ++sample)
+            {
+                const Q16_16 input{sample / 100.};
+                CHECK(static_cast<double>(baked.ease(input))
+                      == Approx(bezier.ease(static_cast<double>(input))).margin(1e-4));
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "catch.hpp"
+
+#include <math/FixedPoint.h>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Fixed-point numbers.")
+{
+    GIVEN("Q16.16 values constructed from integers and floating point values")
+    {
+        const Q16_16 two{2};
+        const Q16_16 half{0.5};
+        const Q16_16 negative{-1.25};
+
+        THEN("Their representation is scaled by 2^16.")
+        {
+            CHECK(two.raw() == 2 << 16);
+            CHECK(half.raw() == 1 << 15);
+            CHECK(negative.raw() == -(5 << 14));
+            CHECK(Q16_16::Epsilon().raw() == 1);
+            CHECK(Q16_16{} == Q16_16{0});
+        }
+
+        THEN("Floating point values are rounded to the nearest representable value.")
+        {
+            CHECK(Q16_16{0.3}.raw() == 19661);
+            CHECK(Q16_16{-0.3}.raw() == -19661);
+            CHECK(static_cast<double>(Q16_16{0.3}) == Approx(0.3).margin(0.5 / 65536));
+        }
+
+        THEN("Conversion to double is exact.")
+        {
+            CHECK(static_cast<double>(negative) == -1.25);
+            CHECK(static_cast<double>(Q16_16::Epsilon()) == 1. / 65536);
+        }
+
+        THEN("Arithmetic operates on the representation.")
+        {
+            CHECK(two + half == Q16_16{2.5});
+            CHECK(half - two == Q16_16{-1.5});
+            CHECK(two * negative == Q16_16{-2.5});
+            CHECK(negative / two == Q16_16{-0.625});
+            CHECK(-half == Q16_16{-0.5});
+            CHECK(3 * half == Q16_16{1.5});
+            CHECK(half * 3 == Q16_16{1.5});
+        }
+
+        THEN("Results are rounded as documented.")
+        {
+            // epsilon * 0.5: the exact result is half an epsilon, rounded toward negative infinity.
+            CHECK(Q16_16::Epsilon() * half == Q16_16{0});
+            CHECK(-Q16_16::Epsilon() * half == -Q16_16::Epsilon());
+            // 1 / 3 truncated toward zero.
+            CHECK((Q16_16{1} / 3).raw() == 21845);
+            CHECK((Q16_16{-1} / 3).raw() == -21845);
+        }
+
+        THEN("They are ordered.")
+        {
+            CHECK(negative < half);
+            CHECK(two > half);
+            CHECK(half <= Q16_16{0.5});
+        }
+    }
+
+    GIVEN("Constant expressions")
+    {
+        constexpr Q16_16 value = Q16_16{1.5} * 2 - Q16_16{0.25};
+        STATIC_REQUIRE(value == Q16_16{2.75});
+    }
+}
@@ -0,0 +1,162 @@
+#include "catch.hpp"
+
+#include <math/Interpolation/InterpolationPool.h>
+#include <math/Vector.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Interpolation pool.")
+{
+    GIVEN("A pool of smoothstep interpolations between vectors, with different periods")
+    {
+        const std::vector<double> periods{1., 2., 0.5};
+        const Vec<2> first{0., 10.};
+        const Vec<2> last{4., -2.};
+
+        InterpolationPool<Vec<2>, double, None, ease::SmoothStep> pool;
+        std::vector<Interpolation<Vec<2>, double, None, ease::SmoothStep>> references;
+        for (double period : periods)
+        {
+            pool.add(first, last, period);
+            references.push_back(makeInterpolation<None, ease::SmoothStep>(first, last, period));
+        }
+
+        THEN("Interpolations start at their first value.")
+        {
+            REQUIRE(pool.size() == 3);
+            for (std::size_t id = 0; id != pool.size(); ++id)
+            {
+                REQUIRE(pool.getValues()[id] == first);
+                REQUIRE_FALSE(pool.isCompleted(id));
+            }
+        }
+
+        WHEN("The pool is advanced")
+        {
+            const double delta = 0.125;
+            double time = 0.;
+            std::vector<std::size_t> completionTicks(pool.size(), 0);
+            for (std::size_t tick = 1; tick != 24; ++tick)
+            {
+                pool.advance(delta);
+                time += delta;
+
+                for (std::size_t id = 0; id != pool.size(); ++id)
+                {
+                    REQUIRE(pool.getValues()[id] == references[id].at(time));
+                    REQUIRE(pool.isCompleted(id) == references[id].isCompleted(time));
+                }
+                for (std::size_t completed : pool.getCompleted())
+                {
+                    REQUIRE(completionTicks[completed] == 0);
+                    completionTicks[completed] = tick;
+                }
+            }
+
+            THEN("Each interpolation completion is reported once, when its period is reached.")
+            {
+                CHECK(completionTicks[0] == 8);
+                CHECK(completionTicks[1] == 16);
+                CHECK(completionTicks[2] == 4);
+            }
+
+            THEN("Completed interpolations stay at their last value.")
+            {
+                for (std::size_t id = 0; id != pool.size(); ++id)
+                {
+                    REQUIRE(pool.getValues()[id] == last);
+                }
+            }
+        }
+
+        WHEN("An interpolation is removed")
+        {
+            pool.advance(0.25);
+            pool.remove(0);
+
+            THEN("It is replaced by the last one.")
+            {
+                REQUIRE(pool.size() == 2);
+                CHECK(pool.getValues()[0] == references[2].at(0.25));
+                CHECK(pool.getValues()[1] == references[1].at(0.25));
+                CHECK(pool.getTime(0) == 0.25);
+            }
+        }
+    }
+
+    GIVEN("A pool of periodic interpolations with speeds")
+    {
+        InterpolationPool<double, double, periodic::PingPong> pool;
+        const std::vector<double> speeds{1., 2., 0.5};
+        for (double speed : speeds)
+        {
+            pool.add(-1., 1., 0.8, speed);
+        }
+
+        THEN("They are not finite.")
+        {
+            STATIC_REQUIRE_FALSE(pool.IsFinite());
+        }
+
+        THEN("They follow a ping-pong clamped animation, with speed applied to the time.")
+        {
+            auto reference = makeParameterAnimation<Clamp, periodic::PingPong>(0.8);
+            double time = 0.;
+            for (int tick = 0; tick != 20; ++tick)
+            {
+                pool.advance(0.1);
+                time += 0.1;
+                REQUIRE(pool.getCompleted().empty());
+                for (std::size_t id = 0; id != pool.size(); ++id)
+                {
+                    REQUIRE(pool.getParameters()[id] == Approx((double)reference.at(time * speeds[id])));
+                    REQUIRE(pool.getValues()[id] == Approx(lerp(-1., 1., pool.getParameters()[id])));
+                }
+            }
+        }
+    }
+
+    GIVEN("A pool with a stateful easing")
+    {
+        ease::Bezier<double> slowStart;
+        slowStart.mXValues[1] = 0.6;
+        ease::Bezier<double> fastStart;
+        fastStart.mYValues[1] = 0.6;
+
+        InterpolationPool<double, double, None, ease::Bezier> pool;
+        pool.add(0., 1., 1., 1., slowStart);
+        pool.add(0., 1., 1., 1., fastStart);
+
+        THEN("Each interpolation uses its own easing.")
+        {
+            pool.advance(0.3);
+            CHECK(pool.getValues()[0] == Approx(slowStart.ease(0.3)));
+            CHECK(pool.getValues()[1] == Approx(fastStart.ease(0.3)));
+            CHECK(pool.getValues()[0] < pool.getValues()[1]);
+        }
+    }
+
+    GIVEN("A long running pool of float repeating interpolations")
+    {
+        InterpolationPool<float, float, periodic::Repeat> pool;
+        pool.add(0.f, 1.f, 0.01f);
+        pool.add(0.f, 1.f, 0.5f, 3.f);
+
+        THEN("Its parameters stay within [0, 1] when the times exceed the 32 bits integer range of periods.")
+        {
+            for (float delta : {1e6f, 1e8f, 1e12f})
+            {
+                pool.advance(delta);
+                for (float parameter : pool.getParameters())
+                {
+                    REQUIRE(parameter >= 0.f);
+                    REQUIRE(parameter <= 1.f);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,289 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/Intersection.h>
+
+#include <algorithm>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    // Reference implementation: recursive halving of both curves while their control bounds overlap.
+    template <int N_first, int N_second>
+    void intersectBySubdivision(const Bezier<N_first, 2> & aFirst, double aFirstLow, double aFirstHigh,
+                                const Bezier<N_second, 2> & aSecond, double aSecondLow, double aSecondHigh,
+                                double aTolerance,
+                                std::vector<IntersectionParameters<double>> & aResult)
+    {
+        if (!detail::overlapControlBounds(aFirst, aSecond))
+        {
+            return;
+        }
+        if (aFirstHigh - aFirstLow <= aTolerance && aSecondHigh - aSecondLow <= aTolerance)
+        {
+            aResult.push_back({(aFirstLow + aFirstHigh) / 2, (aSecondLow + aSecondHigh) / 2});
+            return;
+        }
+
+        auto [firstLeft, firstRight] = subdivide(aFirst, 0.5);
+        auto [secondLeft, secondRight] = subdivide(aSecond, 0.5);
+        const double firstMiddle = (aFirstLow + aFirstHigh) / 2;
+        const double secondMiddle = (aSecondLow + aSecondHigh) / 2;
+        intersectBySubdivision(firstLeft, aFirstLow, firstMiddle, secondLeft, aSecondLow, secondMiddle, aTolerance, aResult);
+        intersectBySubdivision(firstLeft, aFirstLow, firstMiddle, secondRight, secondMiddle, aSecondHigh, aTolerance, aResult);
+        intersectBySubdivision(firstRight, firstMiddle, aFirstHigh, secondLeft, aSecondLow, secondMiddle, aTolerance, aResult);
+        intersectBySubdivision(firstRight, firstMiddle, aFirstHigh, secondRight, secondMiddle, aSecondHigh, aTolerance, aResult);
+    }
+
+
+    template <int N_first, int N_second>
+    std::vector<IntersectionParameters<double>> intersectBySubdivision(const Bezier<N_first, 2> & aFirst,
+                                                                       const Bezier<N_second, 2> & aSecond,
+                                                                       double aTolerance)
+    {
+        std::vector<IntersectionParameters<double>> result;
+        intersectBySubdivision(aFirst, 0., 1., aSecond, 0., 1., aTolerance, result);
+        // The subdivision reports clusters of neighbouring pieces around each intersection.
+        detail::sortAndMerge(result, 4 * aTolerance);
+        return result;
+    }
+
+
+    const Bezier<4, 2> gWave{
+        Position<2>{0., 0.}, Position<2>{1., 3.}, Position<2>{2., -3.}, Position<2>{3., 1.}};
+    const Bezier<4, 2> gOtherWave{
+        Position<2>{0., 1.}, Position<2>{1., -2.}, Position<2>{2., 3.}, Position<2>{3., -1.}};
+
+
+} // anonymous namespace
+
+
+SCENARIO("Bezier curves intersection.")
+{
+    const double tolerance = 1e-9;
+
+    GIVEN("Two crossing segments")
+    {
+        Bezier<2, 2> first{Position<2>{0., 0.}, Position<2>{2., 2.}};
+        Bezier<2, 2> second{Position<2>{0., 2.}, Position<2>{2., 0.}};
+
+        THEN("They intersect at their middle.")
+        {
+            auto intersections = intersect(first, second, tolerance);
+            REQUIRE(intersections.size() == 1);
+            CHECK(intersections[0].mOnFirst == Approx(0.5).margin(tolerance));
+            CHECK(intersections[0].mOnSecond == Approx(0.5).margin(tolerance));
+        }
+    }
+
+    GIVEN("An S shaped cubic, and a segment through its endpoints")
+    {
+        Bezier<4, 2> wave{Position<2>{0., 0.}, Position<2>{1., 2.}, Position<2>{2., -2.}, Position<2>{3., 0.}};
+        Bezier<2, 2> segment{Position<2>{-1., 0.}, Position<2>{4., 0.}};
+
+        THEN("They intersect three times, including at the curve endpoints.")
+        {
+            auto intersections = intersect(wave, segment, tolerance);
+            REQUIRE(intersections.size() == 3);
+            const std::vector<double> expectedOnWave{0., 0.5, 1.};
+            const std::vector<double> expectedOnSegment{0.2, 0.5, 0.8};
+            for (std::size_t id = 0; id != 3; ++id)
+            {
+                CHECK(intersections[id].mOnFirst == Approx(expectedOnWave[id]).margin(1e-8));
+                CHECK(intersections[id].mOnSecond == Approx(expectedOnSegment[id]).margin(1e-8));
+            }
+        }
+    }
+
+    GIVEN("Two cubics crossing several times")
+    {
+        THEN("Each intersection is at the same position on both curves.")
+        {
+            auto intersections = intersect(gWave, gOtherWave, tolerance);
+            REQUIRE(intersections.size() == 3);
+            for (const auto & intersection : intersections)
+            {
+                REQUIRE_THAT(evaluate(gWave, intersection.mOnFirst),
+                             Approximates(evaluate(gOtherWave, intersection.mOnSecond), 1e-7));
+            }
+        }
+
+        THEN("The intersections are the ones found by recursive subdivision.")
+        {
+            auto intersections = intersect(gWave, gOtherWave, tolerance);
+            auto reference = intersectBySubdivision(gWave, gOtherWave, 1e-7);
+            REQUIRE(intersections.size() == reference.size());
+            for (std::size_t id = 0; id != intersections.size(); ++id)
+            {
+                CHECK(intersections[id].mOnFirst == Approx(reference[id].mOnFirst).margin(1e-6));
+                CHECK(intersections[id].mOnSecond == Approx(reference[id].mOnSecond).margin(1e-6));
+            }
+        }
+
+        THEN("The intersections are found down to the precision of the numbers.")
+        {
+            for (double tightTolerance : {1e-12, 1e-15, 0.})
+            {
+                REQUIRE(intersect(gWave, gOtherWave, tightTolerance).size() == 3);
+                REQUIRE(intersect(gOtherWave, gWave, tightTolerance).size() == 3);
+            }
+        }
+    }
+
+    GIVEN("A cubic and a quadratic which do not intersect")
+    {
+        Bezier<3, 2> arch{Position<2>{0., 5.}, Position<2>{1.5, 8.}, Position<2>{3., 5.}};
+
+        THEN("There is no intersection.")
+        {
+            REQUIRE(intersect(gWave, arch, tolerance).empty());
+            REQUIRE(intersect(arch, gWave, tolerance).empty());
+        }
+    }
+
+    GIVEN("Overlapping segments")
+    {
+        Bezier<2, 2> first{Position<2>{0., 0.}, Position<2>{2., 2.}};
+        Bezier<2, 2> second{Position<2>{1., 1.}, Position<2>{3., 3.}};
+
+        THEN("The ends of the overlap are returned.")
+        {
+            auto intersections = intersect(first, second, tolerance);
+            REQUIRE(intersections.size() == 2);
+            CHECK(intersections[0].mOnFirst == Approx(0.5).margin(tolerance));
+            CHECK(intersections[0].mOnSecond == Approx(0.).margin(tolerance));
+            CHECK(intersections[1].mOnFirst == Approx(1.).margin(tolerance));
+            CHECK(intersections[1].mOnSecond == Approx(0.5).margin(tolerance));
+        }
+    }
+
+    GIVEN("A cubic")
+    {
+        THEN("Its intersection with itself is reported by its endpoints.")
+        {
+            for (double curveTolerance : {1e-6, tolerance, 1e-12})
+            {
+                auto intersections = intersect(gWave, gWave, curveTolerance);
+                REQUIRE(intersections.size() == 2);
+                CHECK(intersections[0].mOnFirst == Approx(0.).margin(curveTolerance));
+                CHECK(intersections[0].mOnSecond == Approx(0.).margin(curveTolerance));
+                CHECK(intersections[1].mOnFirst == Approx(1.).margin(curveTolerance));
+                CHECK(intersections[1].mOnSecond == Approx(1.).margin(curveTolerance));
+            }
+        }
+
+        THEN("Its intersection with its reverse is reported by its endpoints.")
+        {
+            Bezier<4, 2> reversed{gWave[3], gWave[2], gWave[1], gWave[0]};
+            auto intersections = intersect(gWave, reversed, tolerance);
+            REQUIRE(intersections.size() == 2);
+            CHECK(intersections[0].mOnFirst == Approx(0.).margin(tolerance));
+            CHECK(intersections[0].mOnSecond == Approx(1.).margin(tolerance));
+            CHECK(intersections[1].mOnFirst == Approx(1.).margin(tolerance));
+            CHECK(intersections[1].mOnSecond == Approx(0.).margin(tolerance));
+        }
+
+        THEN("Its intersection with an overlapping part of it is reported by the ends of the overlap.")
+        {
+            // Parameters [0.4, 0.6] of the cubic are on both parts.
+            auto head = subdivide(gWave, 0.6).first;
+            auto tail = subdivide(gWave, 0.4).second;
+            auto intersections = intersect(head, tail, tolerance);
+            REQUIRE(intersections.size() == 2);
+            CHECK(intersections[0].mOnFirst == Approx(0.4 / 0.6).margin(1e-8));
+            CHECK(intersections[0].mOnSecond == Approx(0.).margin(1e-8));
+            CHECK(intersections[1].mOnFirst == Approx(1.).margin(1e-8));
+            CHECK(intersections[1].mOnSecond == Approx(0.2 / 0.6).margin(1e-8));
+        }
+    }
+}
+
+
+TEST_CASE("Bezier intersection benchmarks.", "[.][benchmark]")
+{
+    BENCHMARK("Bezier clipping")
+    {
+        return intersect(gWave, gOtherWave, 1e-7);
+    };
+
+    BENCHMARK("Recursive subdivision")
+    {
+        return intersectBySubdivision(gWave, gOtherWave, 1e-7);
+    };
+}
+
+
+SCENARIO("Bezier curve and ray intersection.")
+{
+    const double tolerance = 1e-10;
+
+    GIVEN("A quadratic Bezier describing the parabola y = x^2")
+    {
+        Bezier<3, 2> parabola{Position<2>{-1., 1.}, Position<2>{0., -1.}, Position<2>{1., 1.}};
+
+        THEN("A horizontal ray starting left of it crosses it twice.")
+        {
+            auto intersections = intersectRay(parabola, Position<2>{-2., 0.25}, Vec<2>{2., 0.}, tolerance);
+            REQUIRE(intersections.size() == 2);
+            CHECK(intersections[0].mOnFirst == Approx(0.25));
+            CHECK(intersections[0].mOnSecond == Approx(0.75));
+            CHECK(intersections[1].mOnFirst == Approx(0.75));
+            CHECK(intersections[1].mOnSecond == Approx(1.25));
+        }
+
+        THEN("A ray starting inside of it crosses it once.")
+        {
+            auto intersections = intersectRay(parabola, Position<2>{0., 0.25}, Vec<2>{1., 0.}, tolerance);
+            REQUIRE(intersections.size() == 1);
+            CHECK(intersections[0].mOnFirst == Approx(0.75));
+            CHECK(intersections[0].mOnSecond == Approx(0.5));
+        }
+
+        THEN("A ray pointing away does not intersect it.")
+        {
+            REQUIRE(intersectRay(parabola, Position<2>{2., 0.25}, Vec<2>{1., 0.}, tolerance).empty());
+            REQUIRE(intersectRay(parabola, Position<2>{0., -0.5}, Vec<2>{0., -1.}, tolerance).empty());
+        }
+    }
+
+    GIVEN("A cubic")
+    {
+        THEN("Intersections with a ray are on the ray.")
+        {
+            const Position<2> origin{-1., 1.};
+            const Vec<2> direction{1., -0.3};
+            auto intersections = intersectRay(gWave, origin, direction, tolerance);
+            REQUIRE_FALSE(intersections.empty());
+            for (const auto & intersection : intersections)
+            {
+                REQUIRE_THAT(evaluate(gWave, intersection.mOnFirst),
+                             Approximates(origin + intersection.mOnSecond * direction, 1e-8));
+            }
+        }
+    }
+
+    GIVEN("A cubic lying on a line")
+    {
+        const Bezier<4, 2> segment{
+            Position<2>{0., 1.}, Position<2>{1., 2.}, Position<2>{3., 4.}, Position<2>{2., 3.}};
+
+        THEN("A ray along this line does not intersect it.")
+        {
+            REQUIRE(intersectRay(segment, Position<2>{-1., 0.}, Vec<2>{1., 1.}, tolerance).empty());
+            REQUIRE(intersectRay(segment, Position<2>{1., 2.}, Vec<2>{-2., -2.}, tolerance).empty());
+        }
+
+        THEN("A ray across this line intersects it once.")
+        {
+            auto intersections = intersectRay(segment, Position<2>{2., 0.}, Vec<2>{-1., 1.}, tolerance);
+            REQUIRE(intersections.size() == 1);
+            CHECK_THAT(evaluate(segment, intersections[0].mOnFirst), Approximates(Position<2>{0.5, 1.5}, 1e-8));
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include "catch.hpp"
+
+#include <math/Color.h>
+#include <math/Interpolation/Keyframes.h>
+#include <math/Vector.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Keyframe tracks.")
+{
+    GIVEN("A track of vectors without easing")
+    {
+        KeyframeTrack<Vec<2>, double> track;
+        track.addKey(1., Vec<2>{0., 0.});
+        track.addKey(2., Vec<2>{10., 0.});
+        track.addKey(4., Vec<2>{10., 20.});
+
+        THEN("It interpolates linearly between the keys.")
+        {
+            CHECK(track.at(1.) == Vec<2>{0., 0.});
+            CHECK(track.at(1.5) == Vec<2>{5., 0.});
+            CHECK(track.at(2.) == Vec<2>{10., 0.});
+            CHECK(track.at(3.) == Vec<2>{10., 10.});
+            CHECK(track.at(4.) == Vec<2>{10., 20.});
+        }
+
+        THEN("It holds its end values outside of the keys.")
+        {
+            CHECK(track.at(-5.) == Vec<2>{0., 0.});
+            CHECK(track.at(10.) == Vec<2>{10., 20.});
+        }
+
+        THEN("The keys are stored contiguously.")
+        {
+            REQUIRE(track.size() == 3);
+            CHECK(track.getTimes()[2] == 4.);
+            CHECK(track.getValues()[1] == Vec<2>{10., 0.});
+        }
+
+        THEN("The cursor gives the same values, and follows the keys.")
+        {
+            std::size_t cursor = 0;
+            for (double time : {0., 1.2, 1.9, 2., 2.5, 3.9, 5., 1.5, 0.5})
+            {
+                REQUIRE(track.at(time, cursor) == track.at(time));
+            }
+            track.at(3., cursor);
+            CHECK(cursor == 1);
+            track.at(1.5, cursor);
+            CHECK(cursor == 0);
+        }
+    }
+
+    GIVEN("A track with an easing per key")
+    {
+        ease::CubicSpline<double> spline{{0., 0.5, 1.}, {0., 0.8, 1.}};
+        KeyframeTrack<double, double> track;
+        track.addKey(0., 0., ease::SmoothStep<double>{});
+        track.addKey(1., 10., &spline);
+        track.addKey(3., 20.);
+
+        THEN("Each interval is eased by the easing of its first key.")
+        {
+            CHECK(track.at(0.25) == Approx(10. * ease::SmoothStep<double>{}.ease(0.25)));
+            CHECK(track.at(2.) == Approx(10. + 10. * spline.ease(0.5)));
+            CHECK(track.at(3.) == 20.);
+        }
+    }
+
+    GIVEN("Tracks of colors and quaternions")
+    {
+        KeyframeTrack<hdr::Rgb_d, double> colors;
+        colors.addKey(0., hdr::Rgb_d{0., 0., 1.});
+        colors.addKey(1., hdr::Rgb_d{1., 0., 0.});
+
+        const UnitVec<3> axis{Vec<3>{0., 0., 1.}};
+        KeyframeTrack<Quaternion<double>, double> rotations;
+        rotations.addKey(0., Quaternion<double>::Identity());
+        rotations.addKey(1., Quaternion<double>{axis, Degree<double>{90.}});
+
+        THEN("Colors are interpolated linearly.")
+        {
+            CHECK(colors.at(0.5) == hdr::Rgb_d{0.5, 0., 0.5});
+        }
+
+        THEN("Quaternions are interpolated spherically.")
+        {
+            CHECK(rotations.at(0.5).equalsWithinTolerance(Quaternion<double>{axis, Degree<double>{45.}},
+                                                          1e-9));
+            CHECK(rotations.at(0.25).equalsWithinTolerance(Quaternion<double>{axis, Degree<double>{22.5}},
+                                                           1e-9));
+        }
+    }
+}
+
+
+SCENARIO("Keyframe clips.")
+{
+    KeyframeTrack<Vec<3>, double> translation;
+    translation.addKey(0., Vec<3>{0., 0., 0.});
+    translation.addKey(2., Vec<3>{2., 4., 6.});
+
+    KeyframeTrack<Vec<3>, double> scale;
+    scale.addKey(0.5, Vec<3>{1., 1., 1.});
+    scale.addKey(1., Vec<3>{2., 2., 2.}, ease::SmoothStep<double>{});
+    scale.addKey(1.5, Vec<3>{1., 1., 1.});
+
+    KeyframeTrack<Quaternion<double>, double> rotation;
+    rotation.addKey(0., Quaternion<double>::Identity());
+    rotation.addKey(2., Quaternion<double>{UnitVec<3>{Vec<3>{0., 1., 0.}}, Degree<double>{90.}});
+
+    GIVEN("A clip grouping tracks of different types")
+    {
+        KeyframeClip<double, None, Vec<3>, Quaternion<double>> clip{2.};
+        REQUIRE(clip.addTrack(translation) == 0);
+        REQUIRE(clip.addTrack(scale) == 1);
+        REQUIRE(clip.addTrack(rotation) == 0);
+
+        THEN("A frame samples all tracks at once.")
+        {
+            KeyframeClip<double, None, Vec<3>, Quaternion<double>>::Frame frame;
+            for (double time : {0., 0.3, 0.75, 1.2, 1.6, 2., 3.})
+            {
+                clip.sample(time, frame);
+                const auto & vectors = std::get<std::vector<Vec<3>>>(frame);
+                const auto & quaternions = std::get<std::vector<Quaternion<double>>>(frame);
+                REQUIRE(vectors.size() == 2);
+                REQUIRE(quaternions.size() == 1);
+                REQUIRE(vectors[0] == translation.at(time));
+                REQUIRE(vectors[1] == scale.at(time));
+                REQUIRE(quaternions[0] == rotation.at(time));
+            }
+        }
+
+        THEN("It completes at the end of its duration.")
+        {
+            CHECK_FALSE(clip.isCompleted(1.9));
+            CHECK(clip.isCompleted(2.));
+        }
+    }
+
+    GIVEN("A fast repeating clip")
+    {
+        KeyframeClip<double, periodic::Repeat, Vec<3>> clip{2., 4.};
+        clip.addTrack(translation);
+
+        THEN("The tracks time follows its timing.")
+        {
+            for (double time : {0.1, 0.3, 0.6, 0.8})
+            {
+                const double localTime = std::fmod(time * 4., 2.);
+                CHECK(clip.getLocalTime(time) == Approx(localTime));
+                CHECK(std::get<0>(clip.sample(time))[0] == translation.at(clip.getLocalTime(time)));
+            }
+            CHECK_FALSE(clip.isCompleted(100.));
+        }
+    }
+}
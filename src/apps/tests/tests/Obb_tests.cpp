@@ -0,0 +1,87 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Obb.h>
+#include <math/Transformations.h>
+
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+SCENARIO("Oriented bounding box fitting.")
+{
+    GIVEN("Points uniformly distributed in a rotated and translated box")
+    {
+        const Quaternion<double> rotation{
+            UnitVec<3>{Vec<3>{1., 2., 3.}},
+            Degree<double>{35.}
+        };
+        const Vec<3> halfExtents{8., 3., 1.};
+        const Vec<3> translation{10., -5., 2.};
+
+        std::mt19937 engine{11};
+        std::uniform_real_distribution<double> unit{-1., 1.};
+        std::vector<Position<3>> points;
+        for (int pointId = 0; pointId != 2000; ++pointId)
+        {
+            Position<3> local{
+                unit(engine) * halfExtents.x(),
+                unit(engine) * halfExtents.y(),
+                unit(engine) * halfExtents.z(),
+            };
+            points.push_back(rotation.rotate(local) + translation);
+        }
+
+        WHEN("An OBB is fitted by principal component analysis")
+        {
+            Obb<double> obb = Obb<double>::FromPointsPca(points);
+
+            THEN("It contains all the points")
+            {
+                // Extremal points are on the boundary, allow for numerical errors.
+                Obb<double> tolerant = obb;
+                tolerant.mHalfExtents *= 1. + 1e-9;
+                for (auto point : points)
+                {
+                    REQUIRE(tolerant.contains(point));
+                }
+            }
+
+            THEN("Its axes match the generating box axes, up to a sign")
+            {
+                REQUIRE(std::abs(obb.mAxes.u().dot(rotation.rotate(Vec<3>{1., 0., 0.}))) == Approx(1.).epsilon(1e-2));
+                REQUIRE(std::abs(obb.mAxes.v().dot(rotation.rotate(Vec<3>{0., 1., 0.}))) == Approx(1.).epsilon(1e-2));
+                REQUIRE(std::abs(obb.mAxes.w().dot(rotation.rotate(Vec<3>{0., 0., 1.}))) == Approx(1.).epsilon(1e-2));
+            }
+
+            THEN("Its extents and center are close to the generating box")
+            {
+                REQUIRE_THAT(obb.mHalfExtents, Approximates(halfExtents, 0.25));
+                REQUIRE_THAT(obb.mCenter, Approximates(Position<3>{10., -5., 2.}, 0.1));
+                REQUIRE(obb.volume() < 8. * halfExtents.x() * halfExtents.y() * halfExtents.z() * 1.1);
+            }
+
+            THEN("Its orientation maps the canonical axes on the box axes")
+            {
+                Quaternion<double> orientation = obb.orientation();
+                REQUIRE_THAT(orientation.rotate(Vec<3>{1., 0., 0.}), Approximates(Vec<3>{obb.mAxes.u()}, 1e-9));
+                REQUIRE_THAT(orientation.rotate(Vec<3>{0., 1., 0.}), Approximates(Vec<3>{obb.mAxes.v()}, 1e-9));
+                REQUIRE_THAT(orientation.rotate(Vec<3>{0., 0., 1.}), Approximates(Vec<3>{obb.mAxes.w()}, 1e-9));
+            }
+
+            THEN("Its corners are on the box boundary")
+            {
+                for (std::size_t cornerId = 0; cornerId != Obb<double>::gCornerCount; ++cornerId)
+                {
+                    Vec<3> local = obb.cornerAt(cornerId) - obb.mCenter;
+                    REQUIRE(std::abs(local.dot(obb.mAxes.u())) == Approx(obb.mHalfExtents.x()));
+                    REQUIRE(std::abs(local.dot(obb.mAxes.w())) == Approx(obb.mHalfExtents.z()));
+                }
+            }
+        }
+    }
+}
@@ -3,6 +3,11 @@
 #include <math/Interpolation/ParameterAnimation.h>
 #include <math/Vector.h>
 
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 
 using namespace ad::math;
 
@@ -512,3 +517,613 @@ SCENARIO("Full-Range ParameterAnimation combinations.")
         }
     }
 }
+
+
+SCENARIO("Easing segment lookup.")
+{
+    GIVEN("A Bezier easing with several segments")
+    {
+        ease::Bezier<double> bezier;
+        for (double x : {0.5, 0.2, 0.8, 0.35})
+        {
+            bezier.addPoint(x);
+        }
+        REQUIRE(bezier.mOnCurveCount == 6);
+
+        // Reference: linear walk along the on-curve points.
+        auto linearIndex = [&](double aInput)
+        {
+            std::size_t index = 0;
+            while (index + 2 < bezier.mOnCurveCount && bezier.mXValues[(index + 1) * 3] < aInput)
+            {
+                ++index;
+            }
+            return index;
+        };
+
+        THEN("The segment found by binary search is the one found by a linear walk.")
+        {
+            for (double x : {-1., 0., 0.1, 0.2, 0.21, 0.35, 0.5, 0.6, 0.8, 0.9, 1., 2.})
+            {
+                REQUIRE(bezier.getValueIndex(x) == linearIndex(x));
+            }
+        }
+
+        THEN("Easing with a hint gives the same results, for monotonic or arbitrary inputs.")
+        {
+            std::size_t hint = 0;
+            for (double x = 0.; x <= 1.; x += 0.01)
+            {
+                REQUIRE(bezier.ease(x, hint) == bezier.ease(x));
+                REQUIRE(hint == linearIndex(x));
+            }
+            for (double x : {0.9, 0.1, 0.6, 0.3})
+            {
+                REQUIRE(bezier.ease(x, hint) == bezier.ease(x));
+                REQUIRE(hint == linearIndex(x));
+            }
+        }
+    }
+
+    GIVEN("A cubic spline easing")
+    {
+        ease::CubicSpline<double> spline{{0., 0.25, 0.5, 0.75, 1.}, {0., 0.1, 0.6, 0.9, 1.}};
+
+        THEN("It interpolates its knots.")
+        {
+            for (std::size_t knot = 0; knot != spline.xValues.size(); ++knot)
+            {
+                REQUIRE(spline.ease(spline.xValues[knot]) == Approx(spline.yValues[knot]).margin(1e-12));
+            }
+        }
+
+        THEN("It is continuous across knots.")
+        {
+            for (double x : {0.25, 0.5, 0.75})
+            {
+                REQUIRE(spline.ease(x - 1e-9) == Approx(spline.ease(x + 1e-9)).margin(1e-6));
+            }
+        }
+
+        THEN("Segments are found by binary search, inputs past the end being in the last segment.")
+        {
+            CHECK(spline.getValueIndex(-1.) == 0);
+            CHECK(spline.getValueIndex(0.25) == 0);
+            CHECK(spline.getValueIndex(0.3) == 1);
+            CHECK(spline.getValueIndex(1.) == 3);
+            CHECK(spline.getValueIndex(5.) == 3);
+
+            std::size_t hint = 0;
+            for (double x = 0.; x <= 1.; x += 0.01)
+            {
+                REQUIRE(spline.ease(x, hint) == spline.ease(x));
+                REQUIRE(hint == spline.getValueIndex(x));
+            }
+        }
+    }
+}
+
+
+namespace {
+
+
+    ease::Bezier<double> makeBezierEasing(std::vector<double> aX, std::vector<double> aY)
+    {
+        ease::Bezier<double> bezier;
+        std::copy(aX.begin(), aX.end(), bezier.mXValues.begin());
+        std::copy(aY.begin(), aY.end(), bezier.mYValues.begin());
+        bezier.mOnCurveCount = aX.size() / 3 + 1;
+        return bezier;
+    }
+
+
+    // Witness assigning a value to the member with the given name, as an editor would.
+    template <class T_value>
+    struct MemberAssigner
+    {
+        template <class T_member>
+        void witness(std::pair<const char *, T_member *> aMember)
+        {
+            if constexpr (std::is_same_v<T_member, T_value>)
+            {
+                if (std::string{aMember.first} == mName)
+                {
+                    *aMember.second = mValue;
+                }
+            }
+        }
+
+        std::string mName;
+        T_value mValue;
+    };
+
+
+} // anonymous namespace
+
+
+SCENARIO("Bezier easing solvers.")
+{
+    GIVEN("Bezier easings, including flat slopes at their ends")
+    {
+        std::vector<ease::Bezier<double>> easings{
+            // CSS ease, ease-in, ease-out
+            makeBezierEasing({0., 0.25, 0.25, 1.}, {0., 0.1, 1., 1.}),
+            makeBezierEasing({0., 0.42, 1., 1.}, {0., 0., 1., 1.}),
+            makeBezierEasing({0., 0., 0.58, 1.}, {0., 0., 1., 1.}),
+            // Two segments
+            makeBezierEasing({0., 0.25, 0.35, 0.5, 0.65, 0.75, 1.}, {0., 0., 0.4, 0.5, 0.6, 1., 1.}),
+        };
+
+        THEN("The Newton solver matches the analytic solver.")
+        {
+            for (ease::Bezier<double> analytic : easings)
+            {
+                ease::Bezier<double> newton = analytic;
+                newton.setSolver(ease::BezierSolver::Newton);
+                for (int sample = 0; sample <= 1000; ++sample)
+                {
+                    const double x = sample / 1000.;
+                    REQUIRE(newton.ease(x) == Approx(analytic.ease(x)).margin(1e-6));
+                }
+            }
+        }
+
+        THEN("The Newton solver finds parameters where x(t) is the input.")
+        {
+            for (ease::Bezier<double> bezier : easings)
+            {
+                bezier.setSolver(ease::BezierSolver::Newton);
+                for (double x : {0., 0.001, 0.1, 0.5, 0.73, 0.999, 1.})
+                {
+                    const std::size_t valueIndex = bezier.getValueIndex(x) * 3;
+                    const double t = bezier.solveNewton(x, valueIndex);
+                    REQUIRE(bezier.evaluateX(t, valueIndex) == Approx(x).margin(1e-12));
+                }
+            }
+        }
+    }
+
+    GIVEN("A Bezier easing using the Newton solver")
+    {
+        ease::Bezier<double> newton;
+        newton.setSolver(ease::BezierSolver::Newton);
+        ease::Bezier<double> analytic;
+
+        WHEN("Its points are edited.")
+        {
+            for (ease::Bezier<double> * bezier : {&newton, &analytic})
+            {
+                bezier->addPoint(0.4);
+                bezier->changePoint(4, Position<2, double>{0.6, 0.9});
+                bezier->changePoint(2, Position<2, double>{0.1, 0.3});
+            }
+
+            THEN("Its sample table is kept up to date.")
+            {
+                ease::Bezier<double> rebuilt = newton;
+                rebuilt.mXSamples = {};
+                rebuilt.updateXSamples();
+                REQUIRE(newton.mXSamples == rebuilt.mXSamples);
+                for (int sample = 0; sample <= 100; ++sample)
+                {
+                    const double x = sample / 100.;
+                    REQUIRE(newton.ease(x) == rebuilt.ease(x));
+                    // The analytic solver can miss the double root of x(t) at the very end.
+                    if (x < 1.)
+                    {
+                        REQUIRE(newton.ease(x) == Approx(analytic.ease(x)).margin(1e-6));
+                    }
+                }
+            }
+        }
+
+        WHEN("Its points are modified by a witness")
+        {
+            auto modified = makeBezierEasing({0., 0.42, 1., 1.}, {0., 0., 1., 1.});
+            newton.describeTo(MemberAssigner<decltype(newton.mXValues)>{"mXValues", modified.mXValues});
+
+            THEN("Its sample table is updated.")
+            {
+                for (int sample = 0; sample <= 100; ++sample)
+                {
+                    const double x = sample / 100.;
+                    REQUIRE(newton.ease(x) == Approx(modified.ease(x)).margin(1e-6));
+                }
+            }
+        }
+
+        WHEN("It switches to the analytic solver")
+        {
+            newton.setSolver(ease::BezierSolver::Analytic);
+
+            THEN("Its sample table is released.")
+            {
+                CHECK(newton.mXSamples.empty());
+                CHECK(analytic.mXSamples.empty());
+            }
+        }
+    }
+}
+
+
+TEST_CASE("Bezier easing solver benchmarks.", "[.][benchmark]")
+{
+    ease::Bezier<double> analytic =
+        makeBezierEasing({0., 0.25, 0.35, 0.5, 0.65, 0.75, 1.}, {0., 0., 0.4, 0.5, 0.6, 1., 1.});
+    ease::Bezier<double> newton = analytic;
+    newton.setSolver(ease::BezierSolver::Newton);
+
+    auto sweep = [](const ease::Bezier<double> & aEasing)
+    {
+        double sum = 0.;
+        for (int sample = 0; sample != 1000; ++sample)
+        {
+            sum += aEasing.ease(sample / 1000.);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Analytic")
+    {
+        return sweep(analytic);
+    };
+
+    BENCHMARK("Newton")
+    {
+        return sweep(newton);
+    };
+}
+
+
+namespace {
+
+
+    template <class T_parameter>
+    using SmallSpline = ease::FixedCubicSpline<T_parameter, 8>;
+
+
+} // anonymous namespace
+
+
+SCENARIO("Fixed capacity cubic spline easing.")
+{
+    const std::vector<double> x{0., 0.2, 0.45, 0.7, 1.};
+    const std::vector<double> y{0., 0.3, 0.35, 0.9, 1.};
+
+    GIVEN("Natural and clamped cubic splines, with both storages")
+    {
+        ease::CubicSpline<double> natural{std::vector<double>{x}, std::vector<double>{y}};
+        ease::CubicSpline<double> clamped{std::vector<double>{x}, std::vector<double>{y}, 0.5, 2.};
+
+        ease::FixedCubicSpline<double> fixedNatural{x, y};
+        ease::FixedCubicSpline<double> fixedClamped{x, y, 0.5, 2.};
+
+        THEN("The second derivatives are the same.")
+        {
+            auto knots = fixedNatural.getKnotData();
+            REQUIRE(knots.size() == x.size());
+            for (std::size_t knot = 0; knot != knots.size(); ++knot)
+            {
+                CHECK(knots[knot].mX == x[knot]);
+                CHECK(knots[knot].mY == y[knot]);
+                CHECK(knots[knot].mSecondDerivative == natural.fppValues[knot]);
+                CHECK(fixedClamped.getKnotData()[knot].mSecondDerivative == clamped.fppValues[knot]);
+            }
+        }
+
+        THEN("They ease identically, including with segment hints.")
+        {
+            std::size_t hint = 0;
+            for (double input = 0.; input <= 1.; input += 0.01)
+            {
+                REQUIRE(fixedNatural.ease(input) == natural.ease(input));
+                REQUIRE(fixedClamped.ease(input) == clamped.ease(input));
+                REQUIRE(fixedNatural.getValueIndex(input) == natural.getValueIndex(input));
+                REQUIRE(fixedNatural.ease(input, hint) == natural.ease(input));
+            }
+        }
+    }
+
+    GIVEN("A fixed capacity spline constructed from positions")
+    {
+        const std::array<Position<2, double>, 3> knots{
+            Position<2, double>{0., 0.}, Position<2, double>{0.5, 0.8}, Position<2, double>{1., 1.}};
+        SmallSpline<double> spline{knots};
+
+        THEN("It can be used by a ParameterAnimation.")
+        {
+            ParameterAnimation<double, Clamp, None, SmallSpline> animation{spline, 2.};
+            CHECK(animation.at(0.) == 0.);
+            CHECK(animation.at(1.) == Approx(0.8));
+            CHECK(animation.at(2.) == Approx(1.));
+            CHECK(animation.getKnots().size() == 3);
+        }
+    }
+
+    GIVEN("More knots than the capacity")
+    {
+        using Spline_t = ease::FixedCubicSpline<double, 4>;
+
+        THEN("Construction throws before copying the knots.")
+        {
+            CHECK_THROWS_AS(Spline_t(x, y), std::length_error);
+            CHECK_THROWS_AS(Spline_t(std::span<const double>{x}.first(2), std::span<const double>{y}.first(2)),
+                            std::length_error);
+            CHECK_NOTHROW(Spline_t(std::span<const double>{x}.first(4), std::span<const double>{y}.first(4)));
+        }
+
+        THEN("Construction throws if x and y values sizes differ.")
+        {
+            CHECK_THROWS_AS(Spline_t(std::span<const double>{x}.first(4), std::span<const double>{y}.first(3)),
+                            std::invalid_argument);
+        }
+    }
+}
+
+
+namespace {
+
+
+    // The closed form of an underdamped spring, as it was evaluated before the coefficients were cached.
+    double referenceSpringEase(const ease::MassSpringDamper<double> & aSpring, double aInput)
+    {
+        const double decayRate = aSpring.mDampening / (2 * aSpring.mMass);
+        const double angularFrequency =
+            std::sqrt(4 * aSpring.mSpringStrength * aSpring.mMass - aSpring.mDampening * aSpring.mDampening)
+            / (2 * aSpring.mMass);
+        const double t = aInput * 10 * (0.69314718056 / decayRate);
+        return 1. - std::exp(-decayRate * t) * std::cos(angularFrequency * t)
+               + ((aSpring.mInitialVelocity - decayRate) / angularFrequency)
+                 * std::exp(-decayRate * t) * std::sin(angularFrequency * t);
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Mass spring damper easing.")
+{
+    GIVEN("An underdamped spring")
+    {
+        ease::MassSpringDamper<double> spring{1., 10., 1.};
+        REQUIRE(spring.getRegime() == ease::DampingRegime::Underdamped);
+
+        THEN("It gives the closed form response.")
+        {
+            for (int sample = 0; sample <= 100; ++sample)
+            {
+                const double x = sample / 100.;
+                REQUIRE(spring.ease(x) == Approx(referenceSpringEase(spring, x)).margin(1e-12));
+            }
+            CHECK(spring.ease(0.) == Approx(0.).margin(1e-12));
+        }
+
+        THEN("It overshoots its target, and settles on it.")
+        {
+            double maximum = 0.;
+            for (int sample = 0; sample <= 100; ++sample)
+            {
+                maximum = std::max(maximum, spring.ease(sample / 100.));
+            }
+            CHECK(maximum > 1.);
+            // The lifetime divides the decay envelope by 1024, the initial amplitude is about 3.
+            CHECK(spring.ease(1.) == Approx(1.).margin(3.5 / 1024));
+        }
+
+        WHEN("Its members are modified")
+        {
+            spring.mDampening = 2.;
+            spring.updateCoefficients();
+
+            THEN("The coefficients are updated.")
+            {
+                CHECK(spring.ease(0.3) == Approx(referenceSpringEase(spring, 0.3)).margin(1e-12));
+            }
+        }
+
+        WHEN("Its members are modified by a witness")
+        {
+            spring.describeTo(MemberAssigner<double>{"mDampening", 2.});
+
+            THEN("The coefficients are updated.")
+            {
+                REQUIRE(spring.mDampening == 2.);
+                CHECK(spring.ease(0.3) == Approx(referenceSpringEase(spring, 0.3)).margin(1e-12));
+            }
+        }
+    }
+
+    GIVEN("A critically damped and an overdamped springs")
+    {
+        // Critical dampening is 2 * sqrt(mass * strength)
+        ease::MassSpringDamper<double> critical{1., 4., 4., 0.};
+        ease::MassSpringDamper<double> overdamped{1., 4., 10., 0.};
+
+        THEN("Their regimes are detected.")
+        {
+            CHECK(critical.getRegime() == ease::DampingRegime::Critical);
+            CHECK(overdamped.getRegime() == ease::DampingRegime::Overdamped);
+        }
+
+        THEN("They start from zero, and reach their target without overshooting.")
+        {
+            for (const auto & spring : {critical, overdamped})
+            {
+                CHECK(spring.ease(0.) == Approx(0.).margin(1e-12));
+                double previous = spring.ease(0.);
+                for (int sample = 1; sample <= 100; ++sample)
+                {
+                    const double value = spring.ease(sample / 100.);
+                    REQUIRE(value >= previous);
+                    REQUIRE(value <= 1.);
+                    previous = value;
+                }
+                CHECK(spring.ease(1.) == Approx(1.).margin(1. / 100));
+            }
+        }
+
+        THEN("The dampening slows down the overdamped spring.")
+        {
+            CHECK(overdamped.getLifetime() > critical.getLifetime());
+            // Compared at the same simulated time, the inputs being normalized by the lifetimes.
+            const double time = 0.5;
+            CHECK(overdamped.ease(time / overdamped.getLifetime()) < critical.ease(time / critical.getLifetime()));
+        }
+
+        THEN("Their initial velocity is respected.")
+        {
+            ease::MassSpringDamper<double> launched{1., 4., 10., 3.};
+            const double h = 1e-7;
+            const double slope = (launched.ease(h) - launched.ease(0.)) / (h * launched.getLifetime());
+            CHECK(slope == Approx(3.).epsilon(1e-4));
+        }
+    }
+
+    GIVEN("Steppers for springs in each regime")
+    {
+        const double inputStep = 1. / 240;
+        std::vector<ease::MassSpringDamper<double>> springs{
+            {1., 10., 1.},
+            {1., 4., 4.},
+            {2., 3., 9., -2.},
+        };
+
+        THEN("Stepping follows the closed form.")
+        {
+            for (const auto & spring : springs)
+            {
+                ease::MassSpringDamper<double>::Stepper stepper{spring, inputStep};
+                REQUIRE(stepper.value() == Approx(spring.ease(0.)).margin(1e-12));
+                REQUIRE(stepper.velocity() == spring.mInitialVelocity);
+                for (int step = 1; step <= 240; ++step)
+                {
+                    REQUIRE(stepper.step() == Approx(spring.ease(step * inputStep)).margin(1e-9));
+                }
+            }
+        }
+    }
+}
+
+
+SCENARIO("Periodic behaviours with the reciprocal of the period.")
+{
+    const std::vector<double> periods{0.1, 0.7, 1., 3.};
+    std::vector<double> values;
+    for (int sample = -500; sample != 500; ++sample)
+    {
+        values.push_back(sample * 0.0731);
+        // Exact multiples of the periods, where the rounding of the reciprocal matters.
+        values.push_back(sample * 0.1);
+    }
+
+    GIVEN("Repeat and PingPong")
+    {
+        periodic::Repeat<double> repeat;
+        periodic::PingPong<double> pingPong;
+
+        THEN("Multiplying by the reciprocal gives the same results as dividing, within [0, period[.")
+        {
+            for (double period : periods)
+            {
+                const double inverse = 1. / period;
+                for (double value : values)
+                {
+                    const double wrapped = repeat(period, inverse, value);
+                    REQUIRE(wrapped >= 0.);
+                    REQUIRE(wrapped < period);
+                    // Near a multiple of the period, a result close to period is equivalent to 0.
+                    const double divided = repeat(period, value);
+                    REQUIRE(std::min(std::abs(wrapped - divided), period - std::abs(wrapped - divided))
+                            == Approx(0.).margin(1e-12));
+
+                    const double bounced = pingPong(period, inverse, value);
+                    REQUIRE(bounced >= 0.);
+                    REQUIRE(bounced <= period);
+                    REQUIRE(bounced == Approx(pingPong(period, value)).margin(1e-12));
+                }
+            }
+        }
+    }
+
+    GIVEN("Arrays of values")
+    {
+        std::vector<double> results(values.size());
+
+        THEN("The array versions apply the behaviour to each value.")
+        {
+            for (double period : periods)
+            {
+                periodic::repeat(period, std::span<const double>{values}, std::span<double>{results});
+                for (std::size_t id = 0; id != values.size(); ++id)
+                {
+                    REQUIRE(results[id] == periodic::Repeat<double>{}(period, 1. / period, values[id]));
+                }
+
+                periodic::pingPong(period, std::span<const double>{values}, std::span<double>{results});
+                for (std::size_t id = 0; id != values.size(); ++id)
+                {
+                    REQUIRE(results[id] == periodic::PingPong<double>{}(period, 1. / period, values[id]));
+                }
+            }
+        }
+
+        THEN("The float versions also wrap within [0, period[.")
+        {
+            const std::vector<float> floatValues(values.begin(), values.end());
+            std::vector<float> floatResults(values.size());
+            for (double period : periods)
+            {
+                const float floatPeriod = static_cast<float>(period);
+                periodic::repeat(floatPeriod,
+                                 std::span<const float>{floatValues},
+                                 std::span<float>{floatResults});
+                for (std::size_t id = 0; id != values.size(); ++id)
+                {
+                    REQUIRE(floatResults[id] >= 0.f);
+                    REQUIRE(floatResults[id] < floatPeriod);
+                    REQUIRE(floatResults[id]
+                            == periodic::Repeat<float>{}(floatPeriod, 1.f / floatPeriod, floatValues[id]));
+                }
+            }
+        }
+    }
+
+    GIVEN("A clamped repeating animation")
+    {
+        auto animation = makeParameterAnimation<Clamp, periodic::Repeat>(0.1);
+
+        THEN("Exact multiples of the period restart the animation.")
+        {
+            CHECK(animation.at(0.) == 0.);
+            CHECK(animation.at(0.05) == Approx(0.5));
+            for (int cycle = 1; cycle != 50; ++cycle)
+            {
+                const double parameter = animation.at(cycle * 0.1);
+                REQUIRE(parameter >= 0.);
+                REQUIRE(parameter < 1.);
+            }
+        }
+    }
+
+    GIVEN("Float periodic animations at large times")
+    {
+        ParameterAnimation<float, FullRange, periodic::Repeat> repeating{0.01f};
+        ParameterAnimation<float, FullRange, periodic::PingPong> bouncing{0.01f};
+
+        THEN("Times beyond the 32 bits integer range still wrap within the period.")
+        {
+            for (float time : {1e5f, 3e7f, -3e7f, 1e12f, -1e30f})
+            {
+                REQUIRE(repeating.at(time) >= 0.f);
+                REQUIRE(repeating.at(time) < 0.01f);
+                REQUIRE(bouncing.at(time) >= 0.f);
+                REQUIRE(bouncing.at(time) <= 0.01f);
+            }
+        }
+
+        THEN("Smaller times keep their phase.")
+        {
+            CHECK(repeating.at(1000.004f) == Approx(periodic::Repeat<float>{}(0.01f, 1000.004f)).margin(1e-4));
+        }
+    }
+}
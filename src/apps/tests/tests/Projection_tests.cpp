@@ -0,0 +1,108 @@
+#include "catch.hpp"
+
+#include "CustomCatchMatchers.h"
+
+#include <math/Curves/Projection.h>
+
+#include <array>
+#include <limits>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    // Reference: the closest of dense samples.
+    template <int N_controlPoints>
+    double bruteForceDistanceSquared(const Bezier<N_controlPoints, 2> & aBezier, Position<2> aPosition)
+    {
+        double result = std::numeric_limits<double>::max();
+        for (int sampleId = 0; sampleId <= 100000; ++sampleId)
+        {
+            result = std::min(result, (evaluate(aBezier, sampleId / 100000.) - aPosition).getNormSquared());
+        }
+        return result;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Projection on curves.")
+{
+    GIVEN("A straight Bezier, evenly parameterized")
+    {
+        Bezier<3, 2> straight{Position<2>{0., 0.}, Position<2>{1., 0.}, Position<2>{2., 0.}};
+
+        THEN("Positions are projected orthogonally, or on the closest endpoint.")
+        {
+            auto projection = project(straight, Position<2>{0.5, 3.});
+            CHECK(projection.mParameter == Approx(0.25));
+            CHECK_THAT(projection.mPosition, Approximates(Position<2>{0.5, 0.}, 1e-12));
+            CHECK(projection.mDistanceSquared == Approx(9.));
+
+            CHECK(project(straight, Position<2>{-1., -1.}).mParameter == 0.);
+            CHECK(project(straight, Position<2>{5., 1.}).mParameter == 1.);
+        }
+    }
+
+    GIVEN("A cubic Bezier")
+    {
+        Bezier<4, 2> bezier{
+            Position<2>{-200.,   0.},
+            Position<2>{-100., 500.},
+            Position<2>{ 100., 450.},
+            Position<2>{ 300., -20.},
+        };
+        BezierProjector<4, 2> projector{bezier};
+
+        THEN("Positions on the curve project onto themselves.")
+        {
+            for (double t : {0., 0.13, 0.5, 0.77, 1.})
+            {
+                auto projection = projector.project(evaluate(bezier, t));
+                CHECK(projection.mParameter == Approx(t).margin(1e-9));
+                CHECK(projection.mDistanceSquared == Approx(0.).margin(1e-12));
+            }
+        }
+
+        THEN("Projections are the closest points on the curve.")
+        {
+            const std::array<Position<2>, 6> positions{
+                Position<2>{0., 0.},
+                Position<2>{0., 500.},
+                Position<2>{-300., 100.},
+                Position<2>{250., 250.},
+                Position<2>{50., 340.},
+                Position<2>{400., -100.},
+            };
+            auto projections = makeFilledArray<6>(CurveProjection<2>{0., Position<2>::Zero(), 0.});
+            projector.project(positions, projections);
+
+            for (std::size_t positionId = 0; positionId != positions.size(); ++positionId)
+            {
+                const auto & projection = projections[positionId];
+                REQUIRE(projection.mDistanceSquared <= bruteForceDistanceSquared(bezier, positions[positionId]) + 1e-9);
+                REQUIRE_THAT(projection.mPosition, Approximates(evaluate(bezier, projection.mParameter), 1e-9));
+                REQUIRE(projection.mDistanceSquared == Approx((projection.mPosition - positions[positionId]).getNormSquared()));
+            }
+        }
+    }
+
+    GIVEN("A Catmull-Rom cubic")
+    {
+        CardinalCubic<2> catmullRom{
+            0., Position<2>{-100., -60.}, Position<2>{-20., 20.}, Position<2>{20., 20.}, Position<2>{100., -60.}};
+
+        THEN("Projection is done on its equivalent Bezier.")
+        {
+            const Position<2> position{5., 40.};
+            auto projection = project(catmullRom, position);
+            CHECK(projection.mParameter == BezierProjector<4, 2>{catmullRom}.project(position).mParameter);
+            CHECK(projection.mDistanceSquared
+                  <= bruteForceDistanceSquared(catmullRom.toBezier(), position) + 1e-9);
+        }
+    }
+}
@@ -0,0 +1,267 @@
+#include "catch.hpp"
+
+#include <math/Proximity.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    Position<3, double> makeRandomPosition(std::mt19937 & aEngine, double aLow, double aHigh)
+    {
+        std::uniform_real_distribution<double> distribution{aLow, aHigh};
+        return {distribution(aEngine), distribution(aEngine), distribution(aEngine)};
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Closest point on a triangle.")
+{
+    GIVEN("A triangle in the XY plane")
+    {
+        const Position<3, double> a{0., 0., 0.};
+        const Position<3, double> b{4., 0., 0.};
+        const Position<3, double> c{0., 4., 0.};
+
+        THEN("Positions are projected on the face, edges, or vertices.")
+        {
+            CHECK(closestPoint({1., 1., 5.}, a, b, c) == Position<3, double>{1., 1., 0.});
+            CHECK(closestPoint({-1., -2., 1.}, a, b, c) == a);
+            CHECK(closestPoint({6., -1., 0.}, a, b, c) == b);
+            CHECK(closestPoint({2., -3., 0.}, a, b, c) == Position<3, double>{2., 0., 0.});
+            CHECK(closestPoint({-3., 2., 0.}, a, b, c) == Position<3, double>{0., 2., 0.});
+            CHECK(closestPoint({3., 3., -1.}, a, b, c) == Position<3, double>{2., 2., 0.});
+        }
+
+        THEN("The result is at least as close as any sampled position of the triangle.")
+        {
+            std::mt19937 engine{5};
+            std::vector<Position<3, double>> positions;
+            for (int positionId = 0; positionId != 100; ++positionId)
+            {
+                positions.push_back(makeRandomPosition(engine, -6., 6.));
+            }
+
+            std::vector<Position<3, double>> results(positions.size(), Position<3, double>::Zero());
+            closestPoint<3, double>(positions, a, b, c, results);
+
+            for (std::size_t positionId = 0; positionId != positions.size(); ++positionId)
+            {
+                const Position<3, double> position = positions[positionId];
+                REQUIRE(results[positionId] == closestPoint(position, a, b, c));
+
+                const double distance = (results[positionId] - position).getNormSquared();
+                for (double u = 0.; u <= 1.; u += 0.05)
+                {
+                    for (double v = 0.; u + v <= 1.; v += 0.05)
+                    {
+                        Position<3, double> sample = a + u * (b - a) + v * (c - a);
+                        REQUIRE(distance <= (sample - position).getNormSquared() + 1e-9);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+SCENARIO("Closest points between segments.")
+{
+    GIVEN("Two skew segments")
+    {
+        Segment<3, double> first{{-1., 0., 0.}, {1., 0., 0.}};
+        Segment<3, double> second{{0.5, -1., 2.}, {0.5, 1., 2.}};
+
+        THEN("The closest points are on the common perpendicular.")
+        {
+            ClosestPoints<3, double> result = closestPoints(first, second);
+            CHECK(result.mOnFirst == Position<3, double>{0.5, 0., 0.});
+            CHECK(result.mOnSecond == Position<3, double>{0.5, 0., 2.});
+            CHECK(result.mDistanceSquared == 4.);
+        }
+    }
+
+    GIVEN("Segments whose closest points are at their ends")
+    {
+        Segment<3, double> first{{0., 0., 0.}, {1., 0., 0.}};
+        Segment<3, double> second{{3., 1., 0.}, {5., 4., 0.}};
+
+        THEN("The end points are returned.")
+        {
+            ClosestPoints<3, double> result = closestPoints(first, second);
+            CHECK(result.mOnFirst == first.mB);
+            CHECK(result.mOnSecond == second.mA);
+            CHECK(result.mDistanceSquared == 5.);
+        }
+    }
+
+    GIVEN("Parallel and degenerate segments")
+    {
+        Segment<3, double> first{{0., 0., 0.}, {2., 0., 0.}};
+        Segment<3, double> parallel{{1., 3., 0.}, {5., 3., 0.}};
+        Segment<3, double> point{{1., 1., 1.}, {1., 1., 1.}};
+
+        THEN("The distance is well defined.")
+        {
+            CHECK(closestPoints(first, parallel).mDistanceSquared == Approx(9.));
+            CHECK(closestPoints(first, point).mDistanceSquared == Approx(2.));
+            CHECK(closestPoints(point, first).mDistanceSquared == Approx(2.));
+            CHECK(closestPoints(point, point).mDistanceSquared == 0.);
+        }
+    }
+
+    GIVEN("Random segments")
+    {
+        std::mt19937 engine{11};
+        Segment<3, double> first{makeRandomPosition(engine, -2., 2.), makeRandomPosition(engine, -2., 2.)};
+        std::vector<Segment<3, double>> seconds;
+        for (int segmentId = 0; segmentId != 50; ++segmentId)
+        {
+            seconds.push_back({makeRandomPosition(engine, -3., 3.), makeRandomPosition(engine, -3., 3.)});
+        }
+
+        THEN("The batch results are at least as close as any sampled pair.")
+        {
+            std::vector<ClosestPoints<3, double>> results(
+                seconds.size(),
+                ClosestPoints<3, double>{Position<3, double>::Zero(), Position<3, double>::Zero(), 0.});
+            closestPoints<3, double>(first, seconds, results);
+
+            for (std::size_t segmentId = 0; segmentId != seconds.size(); ++segmentId)
+            {
+                const ClosestPoints<3, double> & result = results[segmentId];
+                REQUIRE(result.mDistanceSquared
+                        == Approx((result.mOnFirst - result.mOnSecond).getNormSquared()));
+                for (double s = 0.; s <= 1.; s += 0.02)
+                {
+                    for (double t = 0.; t <= 1.; t += 0.02)
+                    {
+                        REQUIRE(result.mDistanceSquared
+                                <= (first.at(s) - seconds[segmentId].at(t)).getNormSquared() + 1e-9);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+SCENARIO("Distances to boxes.")
+{
+    const Box<double> box{{0., 0., 0.}, {2., 4., 6.}};
+
+    GIVEN("Positions around a box")
+    {
+        std::vector<Position<3, double>> positions{
+            {1., 1., 1.},
+            {-1., 2., 3.},
+            {3., 5., 7.},
+            {1., -2., 8.},
+        };
+
+        THEN("The batch squared distances are the distances to the closest points.")
+        {
+            std::vector<double> results(positions.size());
+            distanceSquared<double>(box, positions, results);
+            REQUIRE(results == std::vector<double>{0., 1., 3., 8.});
+            for (std::size_t positionId = 0; positionId != positions.size(); ++positionId)
+            {
+                REQUIRE(results[positionId]
+                        == (box.closestPoint(positions[positionId]) - positions[positionId]).getNormSquared());
+            }
+        }
+    }
+
+    GIVEN("Other boxes")
+    {
+        std::vector<Box<double>> boxes{
+            {{1., 1., 1.}, {5., 5., 5.}},
+            {{2., 0., 0.}, {1., 1., 1.}},
+            {{3., 6., 0.}, {1., 1., 1.}},
+            {{-4., -4., -4.}, {1., 1., 1.}},
+        };
+
+        THEN("The squared distance is null for overlapping or touching boxes.")
+        {
+            std::vector<double> results(boxes.size());
+            distanceSquared<double>(box, boxes, results);
+            REQUIRE(results == std::vector<double>{0., 0., 1. + 4., 27.});
+            REQUIRE(distanceSquared(boxes[2], box) == results[2]);
+        }
+    }
+
+    GIVEN("Spheres")
+    {
+        std::vector<Sphere<3, double>> spheres{
+            {{1., 1., 1.}, 0.5},
+            {{-1., 2., 3.}, 1.},
+            {{3., 5., 7.}, 1.7},
+            {{3., 5., 7.}, 1.8},
+        };
+
+        THEN("Overlaps are detected.")
+        {
+            bool results[4];
+            overlaps<double>(box, spheres, results);
+            CHECK(results[0]);
+            CHECK(results[1]);
+            CHECK_FALSE(results[2]);
+            CHECK(results[3]);
+        }
+    }
+
+    GIVEN("Segments")
+    {
+        THEN("A segment crossing the box is at a null distance.")
+        {
+            ClosestPoints<3, double> result = closestPoints(Segment<3, double>{{-5., 1., 1.}, {5., 3., 5.}}, box);
+            REQUIRE(result.mDistanceSquared == 0.);
+            REQUIRE(box.contains(result.mOnFirst));
+        }
+
+        THEN("A segment parallel to a face is at the distance of the face.")
+        {
+            ClosestPoints<3, double> result = closestPoints(Segment<3, double>{{-3., 1., -2.}, {5., 1., -2.}}, box);
+            REQUIRE(result.mDistanceSquared == 4.);
+            REQUIRE(result.mOnSecond.z() == 0.);
+        }
+
+        THEN("Random segments are at least as close as any sampled position.")
+        {
+            std::mt19937 engine{3};
+            std::vector<Segment<3, double>> segments;
+            for (int segmentId = 0; segmentId != 100; ++segmentId)
+            {
+                segments.push_back({makeRandomPosition(engine, -5., 10.), makeRandomPosition(engine, -5., 10.)});
+            }
+            std::vector<ClosestPoints<3, double>> results(
+                segments.size(),
+                ClosestPoints<3, double>{Position<3, double>::Zero(), Position<3, double>::Zero(), 0.});
+            closestPoints<double>(box, segments, results);
+
+            for (std::size_t segmentId = 0; segmentId != segments.size(); ++segmentId)
+            {
+                const ClosestPoints<3, double> & result = results[segmentId];
+                REQUIRE(result.mDistanceSquared
+                        == Approx((result.mOnFirst - result.mOnSecond).getNormSquared()).margin(1e-12));
+                double sampledMinimum = std::numeric_limits<double>::max();
+                for (double t = 0.; t <= 1.; t += 0.001)
+                {
+                    const double sampled = distanceSquared(segments[segmentId].at(t), box);
+                    REQUIRE(result.mDistanceSquared <= sampled + 1e-9);
+                    sampledMinimum = std::min(sampledMinimum, sampled);
+                }
+                REQUIRE(result.mDistanceSquared == Approx(sampledMinimum).margin(0.05));
+            }
+        }
+    }
+}
@@ -197,3 +197,21 @@ SCENARIO("Rectangle growing.")
         }
     }
 }
+
+
+SCENARIO("Rectangle from points.")
+{
+    GIVEN("A set of points")
+    {
+        std::vector<Position<2>> points{
+            {1., 2.},
+            {-5., 10.},
+            {4., -1.},
+        };
+
+        THEN("The bulk construction gives the bounding rectangle.")
+        {
+            REQUIRE(Rectangle<double>::FromPoints(points) == Rectangle<double>{{-5., -1.}, {9., 11.}});
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include <math/RectanglePacking.h>
+
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    bool overlap(const Rectangle<int> & aLhs, const Rectangle<int> & aRhs)
+    {
+        return aLhs.xMin() < aRhs.xMax() && aRhs.xMin() < aLhs.xMax()
+            && aLhs.yMin() < aRhs.yMax() && aRhs.yMin() < aLhs.yMax();
+    }
+
+
+    std::vector<Size<2, int>> makeRandomSizes(std::size_t aCount)
+    {
+        std::mt19937 engine{7};
+        std::uniform_int_distribution<int> distribution{1, 24};
+        std::vector<Size<2, int>> sizes;
+        for (std::size_t sizeId = 0; sizeId != aCount; ++sizeId)
+        {
+            sizes.push_back({distribution(engine), distribution(engine)});
+        }
+        return sizes;
+    }
+
+
+    template <class T_packer>
+    void checkPacking(T_packer & aPacker, const std::vector<Size<2, int>> & aSizes)
+    {
+        const Rectangle<int> bin = Rectangle<int>::AtOrigin(aPacker.binSize());
+        std::vector<Rectangle<int>> placed;
+        int area = 0;
+        for (auto placement : insertBatch(aPacker, aSizes))
+        {
+            if (placement)
+            {
+                REQUIRE(bin.contains(placement->bottomLeft()));
+                REQUIRE(bin.contains(placement->topRight()));
+                placed.push_back(*placement);
+                area += placement->area();
+            }
+        }
+
+        REQUIRE(aPacker.usedArea() == area);
+        // The test sizes are chosen so most of them fit
+        REQUIRE(placed.size() > aSizes.size() / 2);
+
+        for (std::size_t i = 0; i != placed.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j != placed.size(); ++j)
+            {
+                REQUIRE_FALSE(overlap(placed[i], placed[j]));
+            }
+        }
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Skyline rectangle packing.")
+{
+    GIVEN("An empty skyline packer")
+    {
+        SkylinePacker<> packer{{100, 50}};
+
+        THEN("Rectangles are placed bottom-left.")
+        {
+            REQUIRE(packer.insert({40, 10}) == Rectangle<int>{{0, 0}, {40, 10}});
+            REQUIRE(packer.insert({40, 20}) == Rectangle<int>{{40, 0}, {40, 20}});
+            // Does not fit in the remaining 20 on the bottom row, goes on top of the lowest.
+            REQUIRE(packer.insert({30, 5}) == Rectangle<int>{{0, 10}, {30, 5}});
+            // Fits in the remaining bottom space.
+            REQUIRE(packer.insert({20, 30}) == Rectangle<int>{{80, 0}, {20, 30}});
+            REQUIRE(packer.usedArea() == 400 + 800 + 150 + 600);
+        }
+
+        THEN("Rectangles that do not fit are rejected.")
+        {
+            REQUIRE_FALSE(packer.insert({101, 1}));
+            REQUIRE_FALSE(packer.insert({1, 51}));
+            REQUIRE(packer.insert({100, 50}));
+            REQUIRE_FALSE(packer.insert({1, 1}));
+
+            WHEN("It is reset")
+            {
+                packer.reset();
+                THEN("The space is available again")
+                {
+                    REQUIRE(packer.usedArea() == 0);
+                    REQUIRE(packer.insert({100, 50}));
+                }
+            }
+        }
+    }
+
+    GIVEN("Many random sizes")
+    {
+        SkylinePacker<> packer{{256, 256}};
+
+        THEN("They are packed without overlaps.")
+        {
+            checkPacking(packer, makeRandomSizes(300));
+        }
+    }
+}
+
+
+SCENARIO("MaxRects rectangle packing.")
+{
+    GIVEN("An empty MaxRects packer")
+    {
+        MaxRectsPacker<> packer{{100, 50}};
+
+        THEN("The free space is tracked as maximal rectangles.")
+        {
+            REQUIRE(packer.insert({40, 10}) == Rectangle<int>{{0, 0}, {40, 10}});
+            REQUIRE(packer.freeRectangles().size() == 2);
+
+            // Best short side fit: exact height fit in the free space above.
+            REQUIRE(packer.insert({100, 40}) == Rectangle<int>{{0, 10}, {100, 40}});
+            REQUIRE(packer.freeRectangles().size() == 1);
+            REQUIRE(packer.freeRectangles().front() == Rectangle<int>{{40, 0}, {60, 10}});
+
+            REQUIRE_FALSE(packer.insert({61, 10}));
+            REQUIRE(packer.insert({60, 10}));
+            REQUIRE(packer.freeRectangles().empty());
+        }
+    }
+
+    GIVEN("Many random sizes")
+    {
+        MaxRectsPacker<> packer{{256, 256}};
+
+        THEN("They are packed without overlaps.")
+        {
+            checkPacking(packer, makeRandomSizes(300));
+        }
+    }
+}
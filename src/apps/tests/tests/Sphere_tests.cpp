@@ -0,0 +1,152 @@
+#include "catch.hpp"
+
+#include <math/Sphere.h>
+
+#include <random>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    template <int N_dimension>
+    std::vector<Position<N_dimension>> makeRandomPoints(std::size_t aCount, unsigned int aSeed)
+    {
+        std::mt19937 engine{aSeed};
+        std::normal_distribution<double> distribution{0., 10.};
+        std::vector<Position<N_dimension>> points;
+        for (std::size_t pointId = 0; pointId != aCount; ++pointId)
+        {
+            Position<N_dimension> point = Position<N_dimension>::Zero();
+            for (double & coordinate : point)
+            {
+                coordinate = distribution(engine);
+            }
+            points.push_back(point);
+        }
+        return points;
+    }
+
+
+    template <int N_dimension>
+    bool containsAll(const Sphere<N_dimension> & aSphere, const std::vector<Position<N_dimension>> & aPoints)
+    {
+        for (auto point : aPoints)
+        {
+            if ((point - aSphere.mCenter).getNorm() > aSphere.mRadius * (1. + 1e-9))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Sphere usage.")
+{
+    GIVEN("A sphere")
+    {
+        Sphere<3> sphere{{1., 2., 3.}, 2.};
+
+        THEN("Position inclusion can be tested")
+        {
+            REQUIRE(sphere.contains(Position<3>{1., 2., 3.}));
+            REQUIRE(sphere.contains(Position<3>{1., 4., 3.}));
+            REQUIRE_FALSE(sphere.contains(Position<3>{1., 4.1, 3.}));
+        }
+
+        THEN("It can be extended to contain an outside position")
+        {
+            sphere.extendTo({7., 2., 3.});
+            REQUIRE(sphere == Sphere<3>{{3., 2., 3.}, 4.});
+
+            // Inside positions do not change it.
+            sphere.extendTo({3., 2., 3.});
+            REQUIRE(sphere == Sphere<3>{{3., 2., 3.}, 4.});
+        }
+    }
+}
+
+
+SCENARIO("Bounding sphere fitting.")
+{
+    GIVEN("The corners of a square and its center")
+    {
+        std::vector<Position<2>> points{
+            {0., 0.},
+            {1., 1.},
+            {-1., 1.},
+            {1., -1.},
+            {-1., -1.},
+        };
+
+        THEN("Welzl algorithm finds the circumscribed circle")
+        {
+            Sphere<2> sphere = Sphere<2>::FromPointsWelzl(points);
+            REQUIRE(sphere.mCenter.equalsWithinTolerance(Position<2>{0., 0.}, 1e-12));
+            REQUIRE(sphere.mRadius == Approx(std::sqrt(2.)));
+        }
+    }
+
+    GIVEN("Collinear and duplicated points")
+    {
+        std::vector<Position<3>> points{
+            {0., 0., 0.},
+            {1., 1., 1.},
+            {1., 1., 1.},
+            {2., 2., 2.},
+            {-2., -2., -2.},
+        };
+
+        THEN("Welzl algorithm finds the sphere spanned by the extreme points")
+        {
+            Sphere<3> sphere = Sphere<3>::FromPointsWelzl(points);
+            REQUIRE(sphere.mCenter.equalsWithinTolerance(Position<3>{0., 0., 0.}, 1e-12));
+            REQUIRE(sphere.mRadius == Approx(std::sqrt(12.)));
+        }
+    }
+
+    GIVEN("Random point clouds")
+    {
+        for (unsigned int seed : {1u, 2u, 3u})
+        {
+            auto points2 = makeRandomPoints<2>(500, seed);
+            auto points3 = makeRandomPoints<3>(500, seed);
+
+            THEN("Both fitting methods enclose all points, Ritter being larger than the exact sphere")
+            {
+                Sphere<2> ritter2 = Sphere<2>::FromPointsRitter(points2);
+                Sphere<2> welzl2 = Sphere<2>::FromPointsWelzl(points2);
+                REQUIRE(containsAll(ritter2, points2));
+                REQUIRE(containsAll(welzl2, points2));
+                REQUIRE(welzl2.mRadius <= ritter2.mRadius * (1. + 1e-9));
+
+                Sphere<3> ritter3 = Sphere<3>::FromPointsRitter(points3);
+                Sphere<3> welzl3 = Sphere<3>::FromPointsWelzl(points3);
+                REQUIRE(containsAll(ritter3, points3));
+                REQUIRE(containsAll(welzl3, points3));
+                REQUIRE(welzl3.mRadius <= ritter3.mRadius * (1. + 1e-9));
+            }
+
+            THEN("The exact sphere cannot be shrunk: it touches at least two points")
+            {
+                Sphere<3> welzl3 = Sphere<3>::FromPointsWelzl(points3);
+                int touching = 0;
+                for (auto point : points3)
+                {
+                    if ((point - welzl3.mCenter).getNorm() == Approx(welzl3.mRadius))
+                    {
+                        ++touching;
+                    }
+                }
+                REQUIRE(touching >= 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,193 @@
+#include "catch.hpp"
+
+#include <math/TriangleRasterizer.h>
+
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    struct Fragment
+    {
+        int x;
+        int y;
+        Barycentric<double>::Coordinates coordinates;
+    };
+
+
+    std::vector<Fragment> rasterizeAll(const TriangleRasterizer<double> & aRasterizer, Rectangle<int> aRegion)
+    {
+        std::vector<Fragment> fragments;
+        aRasterizer.rasterize(aRegion, [&](int aX, int aY, Barycentric<double>::Coordinates aCoordinates)
+        {
+            fragments.push_back({aX, aY, aCoordinates});
+        });
+        return fragments;
+    }
+
+
+    template <int N_lanes>
+    std::vector<Fragment> rasterizeAllBlocks(const TriangleRasterizer<double> & aRasterizer, Rectangle<int> aRegion)
+    {
+        std::vector<Fragment> fragments;
+        aRasterizer.rasterizeBlocks<N_lanes>(aRegion, [&](const TriangleRasterizer<double>::Block<N_lanes> & aBlock)
+        {
+            REQUIRE(aBlock.mX % N_lanes == 0);
+            for (int lane = 0; lane != N_lanes; ++lane)
+            {
+                if (aBlock.isCovered(lane))
+                {
+                    fragments.push_back({aBlock.mX + lane, aBlock.mY,
+                                         {aBlock.mAlpha[lane], aBlock.mBeta[lane], aBlock.mGamma[lane]}});
+                }
+            }
+        });
+        return fragments;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Triangle rasterization.")
+{
+    const Rectangle<int> viewport{{0, 0}, {16, 16}};
+
+    GIVEN("A right triangle")
+    {
+        const Position<2, double> a{1., 1.};
+        const Position<2, double> b{9., 1.};
+        const Position<2, double> c{1., 9.};
+        TriangleRasterizer<double> rasterizer{a, b, c};
+
+        THEN("Its pixel bounds contain the pixel centers in its bounding box.")
+        {
+            REQUIRE(rasterizer.getPixelBounds() == Rectangle<int>{{1, 1}, {8, 8}});
+        }
+
+        THEN("The covered pixels are the pixels with their center inside, with the barycentric coordinates.")
+        {
+            std::vector<Fragment> fragments = rasterizeAll(rasterizer, viewport);
+            // Centers strictly inside for x + y < 9, on the hypotenuse (a right edge) for x + y == 9.
+            REQUIRE(fragments.size() == 28);
+
+            Barycentric<double> barycentric{a, b, c};
+            for (const Fragment & fragment : fragments)
+            {
+                REQUIRE(fragment.x + fragment.y < 9);
+                auto expected = barycentric.getCoordinates({fragment.x + 0.5, fragment.y + 0.5});
+                REQUIRE(fragment.coordinates.alpha == Approx(expected.alpha));
+                REQUIRE(fragment.coordinates.beta == Approx(expected.beta));
+                REQUIRE(fragment.coordinates.gamma == Approx(expected.gamma));
+            }
+        }
+
+        THEN("The winding order does not matter.")
+        {
+            std::vector<Fragment> ccw = rasterizeAll(rasterizer, viewport);
+            std::vector<Fragment> cw = rasterizeAll(TriangleRasterizer<double>{a, c, b}, viewport);
+            REQUIRE(ccw.size() == cw.size());
+            for (std::size_t fragmentId = 0; fragmentId != ccw.size(); ++fragmentId)
+            {
+                REQUIRE(cw[fragmentId].x == ccw[fragmentId].x);
+                REQUIRE(cw[fragmentId].y == ccw[fragmentId].y);
+                REQUIRE(cw[fragmentId].coordinates.beta == Approx(ccw[fragmentId].coordinates.gamma));
+            }
+        }
+
+        THEN("Rasterization is restricted to the region.")
+        {
+            const Rectangle<int> region{{2, 2}, {3, 2}};
+            std::vector<Fragment> fragments = rasterizeAll(rasterizer, region);
+            REQUIRE(fragments.size() == 6);
+            for (const Fragment & fragment : fragments)
+            {
+                REQUIRE(region.contains(Position<2, int>{fragment.x, fragment.y}));
+            }
+        }
+
+        THEN("Block rasterization produces the same fragments.")
+        {
+            std::vector<Fragment> expected = rasterizeAll(rasterizer, viewport);
+            for (const Rectangle<int> & region : {viewport, Rectangle<int>{{3, 2}, {6, 3}}})
+            {
+                std::vector<Fragment> expectedInRegion;
+                for (const Fragment & fragment : expected)
+                {
+                    if (fragment.x >= region.xMin() && fragment.x < region.xMax()
+                        && fragment.y >= region.yMin() && fragment.y < region.yMax())
+                    {
+                        expectedInRegion.push_back(fragment);
+                    }
+                }
+
+                std::vector<Fragment> blocks4 = rasterizeAllBlocks<4>(rasterizer, region);
+                std::vector<Fragment> blocks8 = rasterizeAllBlocks<8>(rasterizer, region);
+                REQUIRE(blocks4.size() == expectedInRegion.size());
+                REQUIRE(blocks8.size() == expectedInRegion.size());
+                for (std::size_t fragmentId = 0; fragmentId != expectedInRegion.size(); ++fragmentId)
+                {
+                    REQUIRE(blocks4[fragmentId].x == expectedInRegion[fragmentId].x);
+                    REQUIRE(blocks4[fragmentId].y == expectedInRegion[fragmentId].y);
+                    REQUIRE(blocks4[fragmentId].coordinates.alpha
+                            == Approx(expectedInRegion[fragmentId].coordinates.alpha));
+                    REQUIRE(blocks8[fragmentId].x == expectedInRegion[fragmentId].x);
+                    REQUIRE(blocks8[fragmentId].y == expectedInRegion[fragmentId].y);
+                    REQUIRE(blocks8[fragmentId].coordinates.gamma
+                            == Approx(expectedInRegion[fragmentId].coordinates.gamma));
+                }
+            }
+        }
+    }
+
+    GIVEN("A degenerate triangle")
+    {
+        TriangleRasterizer<double> rasterizer{{1., 1.}, {5., 5.}, {9., 9.}};
+
+        THEN("It does not cover any pixel.")
+        {
+            REQUIRE(rasterizer.isDegenerate());
+            REQUIRE(rasterizeAll(rasterizer, viewport).empty());
+            REQUIRE(rasterizeAllBlocks<4>(rasterizer, viewport).empty());
+        }
+    }
+}
+
+
+SCENARIO("Triangle rasterization fill rule.")
+{
+    GIVEN("A square fanned in four triangles around a pixel center, with edges through pixel centers")
+    {
+        // Two triangles are clockwise, two are counter-clockwise.
+        const Position<2, double> center{4.5, 4.5};
+        const std::vector<TriangleRasterizer<double>> triangles{
+            {center, {0., 0.}, {8., 0.}},
+            {center, {8., 8.}, {8., 0.}},
+            {center, {8., 8.}, {0., 8.}},
+            {center, {0., 0.}, {0., 8.}},
+        };
+
+        THEN("Each pixel of the square is rasterized exactly once.")
+        {
+            std::vector<int> counts(64, 0);
+            std::vector<int> blockCounts(64, 0);
+            for (const TriangleRasterizer<double> & triangle : triangles)
+            {
+                for (const Fragment & fragment : rasterizeAll(triangle, {{-4, -4}, {20, 20}}))
+                {
+                    ++counts.at(fragment.y * 8 + fragment.x);
+                }
+                for (const Fragment & fragment : rasterizeAllBlocks<4>(triangle, {{-4, -4}, {20, 20}}))
+                {
+                    ++blockCounts.at(fragment.y * 8 + fragment.x);
+                }
+            }
+            REQUIRE(counts == std::vector<int>(64, 1));
+            REQUIRE(blockCounts == std::vector<int>(64, 1));
+        }
+    }
+}
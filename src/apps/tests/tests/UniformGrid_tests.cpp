@@ -0,0 +1,201 @@
+#include "catch.hpp"
+
+#include <math/UniformGrid.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+using namespace ad::math;
+
+
+namespace {
+
+
+    template <int N_dimension>
+    std::vector<Position<N_dimension>> makeRandomPoints(std::size_t aCount, double aLow, double aHigh)
+    {
+        std::mt19937 engine{42};
+        std::uniform_real_distribution<double> distribution{aLow, aHigh};
+        std::vector<Position<N_dimension>> points;
+        points.reserve(aCount);
+        for (std::size_t pointId = 0; pointId != aCount; ++pointId)
+        {
+            Position<N_dimension> point = Position<N_dimension>::Zero();
+            for (double & coordinate : point)
+            {
+                coordinate = distribution(engine);
+            }
+            points.push_back(point);
+        }
+        return points;
+    }
+
+
+    template <int N_dimension>
+    std::set<std::pair<std::uint32_t, std::uint32_t>>
+    bruteForcePairs(const std::vector<Position<N_dimension>> & aPoints, double aRadius)
+    {
+        std::set<std::pair<std::uint32_t, std::uint32_t>> result;
+        for (std::uint32_t a = 0; a != aPoints.size(); ++a)
+        {
+            for (std::uint32_t b = a + 1; b != aPoints.size(); ++b)
+            {
+                if ((aPoints[b] - aPoints[a]).getNormSquared() <= aRadius * aRadius)
+                {
+                    result.emplace(a, b);
+                }
+            }
+        }
+        return result;
+    }
+
+
+} // anonymous namespace
+
+
+SCENARIO("Uniform grid layout.")
+{
+    GIVEN("A 2D grid")
+    {
+        UniformGrid<2> grid{Rectangle<double>{{-10., 0.}, {20., 9.}}, 2.};
+
+        THEN("The bounds are covered by a whole number of cells.")
+        {
+            REQUIRE(grid.cellCounts() == Size<2, int>{10, 5});
+            REQUIRE(grid.cellCount() == 50);
+        }
+
+        THEN("Positions map to cells, outside positions map to the closest border cell.")
+        {
+            using Cell = UniformGrid<2>::Cell_t;
+            CHECK(grid.cellOf({-10., 0.}) == Cell{0, 0});
+            CHECK(grid.cellOf({-7.5, 4.5}) == Cell{1, 2});
+            CHECK(grid.cellOf({-100., 100.}) == Cell{0, 4});
+            CHECK(grid.cellOf({100., -100.}) == Cell{9, 0});
+        }
+
+        THEN("Cells expose their bounds.")
+        {
+            REQUIRE(grid.cellBounds({1, 2}) == Rectangle<double>{{-8., 4.}, {2., 2.}});
+        }
+    }
+
+    GIVEN("A 3D grid")
+    {
+        UniformGrid<3> grid{Box<double>{{0., 0., 0.}, {4., 4., 4.}}, 1.};
+
+        THEN("Cells expose their bounds as boxes.")
+        {
+            REQUIRE(grid.cellCount() == 64);
+            REQUIRE(grid.cellBounds({1, 2, 3}) == Box<double>{{1., 2., 3.}, {1., 1., 1.}});
+        }
+    }
+}
+
+
+SCENARIO("Uniform grid queries.")
+{
+    GIVEN("Random 2D points, some outside of the grid bounds")
+    {
+        auto points = makeRandomPoints<2>(2000, -5., 105.);
+        UniformGrid<2> grid{Rectangle<double>{{0., 0.}, {100., 100.}}, 5.};
+        grid.build(points);
+
+        THEN("Each point is bucketed in exactly one cell.")
+        {
+            REQUIRE(grid.pointCount() == points.size());
+            std::size_t total = 0;
+            for (int y = 0; y != grid.cellCounts().height(); ++y)
+            {
+                for (int x = 0; x != grid.cellCounts().width(); ++x)
+                {
+                    for (std::uint32_t index : grid.pointsInCell({x, y}))
+                    {
+                        REQUIRE(grid.cellOf(points[index]) == UniformGrid<2>::Cell_t{x, y});
+                        ++total;
+                    }
+                }
+            }
+            REQUIRE(total == points.size());
+        }
+
+        THEN("Radius queries match a brute force search.")
+        {
+            for (Position<2> center : {Position<2>{50., 50.}, Position<2>{0., 0.}, Position<2>{103., 20.}})
+            {
+                for (double radius : {1., 5., 12.5})
+                {
+                    std::vector<std::uint32_t> found;
+                    grid.queryRadius(center, radius, [&](std::uint32_t aIndex)
+                    {
+                        found.push_back(aIndex);
+                    });
+                    std::sort(found.begin(), found.end());
+
+                    std::vector<std::uint32_t> expected;
+                    for (std::uint32_t index = 0; index != points.size(); ++index)
+                    {
+                        if ((points[index] - center).getNorm() <= radius)
+                        {
+                            expected.push_back(index);
+                        }
+                    }
+                    REQUIRE(found == expected);
+                }
+            }
+        }
+
+        THEN("Pair enumeration matches a brute force search, for radii smaller or larger than cells.")
+        {
+            for (double radius : {2., 5., 8.})
+            {
+                std::set<std::pair<std::uint32_t, std::uint32_t>> found;
+                std::size_t visits = 0;
+                grid.forEachPair(radius, [&](std::uint32_t aA, std::uint32_t aB)
+                {
+                    ++visits;
+                    found.emplace(std::min(aA, aB), std::max(aA, aB));
+                });
+                REQUIRE(visits == found.size());
+                REQUIRE(found == bruteForcePairs(points, radius));
+            }
+        }
+    }
+
+    GIVEN("Random 3D points")
+    {
+        auto points = makeRandomPoints<3>(1500, 0., 20.);
+        UniformGrid<3> grid{Box<double>{{0., 0., 0.}, {20., 20., 20.}}, 2.};
+        grid.build(points);
+
+        THEN("Pair enumeration matches a brute force search.")
+        {
+            std::set<std::pair<std::uint32_t, std::uint32_t>> found;
+            grid.forEachPair(1.5, [&](std::uint32_t aA, std::uint32_t aB)
+            {
+                found.emplace(std::min(aA, aB), std::max(aA, aB));
+            });
+            REQUIRE(found == bruteForcePairs(points, 1.5));
+        }
+
+        THEN("The parallel build produces the same buckets as the sequential build.")
+        {
+            for (std::size_t jobCount : {1, 3, 4})
+            {
+                UniformGrid<3> parallel{Box<double>{{0., 0., 0.}, {20., 20., 20.}}, 2.};
+                parallel.buildParallel(points, jobCount);
+
+                for (MultiRange<int, 3> range{grid.cellCounts()}; range != range; ++range)
+                {
+                    auto expected = grid.pointsInCell(*range);
+                    auto actual = parallel.pointsInCell(*range);
+                    REQUIRE(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end()));
+                }
+            }
+        }
+    }
+}
@@ -4,6 +4,10 @@
 #include "Rectangle.h"
 #include "Vector.h"
 
+#include <algorithm>
+#include <cassert>
+#include <span>
+
 namespace ad {
 namespace math {
 
@@ -128,6 +132,9 @@ struct Box
     /// \brief Construct a Box of provided dimension, centered on origin (0, 0, 0).
     static Box CenterOnOrigin(Size<3, T_number> aDimension);
 
+    /// \brief Construct the smallest Box containing all of `aPoints`, which must not be empty.
+    static Box FromPoints(std::span<const Position<3, T_number>> aPoints);
+
     Box & operator*=(T_number aScalarFactor);
 
     Box & operator*=(const LinearMatrix<3, 3, T_number> & aTransform);
@@ -205,6 +212,30 @@ Box<T_number> Box<T_number>::CenterOnOrigin(Size<3, T_number> aDimension)
 }
 
 
+template <class T_number>
+Box<T_number> Box<T_number>::FromPoints(std::span<const Position<3, T_number>> aPoints)
+{
+    assert(!aPoints.empty());
+
+    // Branchless min/max on each component, over a single pass.
+    // Contrary to repeated extendTo() calls, the loop body has no data dependent branch.
+    // Implementer's note: GCC compiles it to scalar min/max instructions. It only vectorizes
+    // these floating point reductions when allowed to ignore NaNs and signed zeros
+    // (-ffinite-math-only -fno-signed-zeros), since reordering them could change the result.
+    Position<3, T_number> low = aPoints.front();
+    Position<3, T_number> high = low;
+    for (const Position<3, T_number> & point : aPoints)
+    {
+        for (std::size_t axis = 0; axis != 3; ++axis)
+        {
+            low[axis] = std::min(low[axis], point[axis]);
+            high[axis] = std::max(high[axis], point[axis]);
+        }
+    }
+    return {low, (high - low).template as<Size>()};
+}
+
+
 template <class T_number>
 Box<T_number> & Box<T_number>::operator*=(T_number aScalarFactor)
 {
@@ -22,10 +22,10 @@ public:
 
     /*implicit*/ constexpr Clamped(const T_value & aValue);
 
-    const T_value & value() const
+    constexpr const T_value & value() const
     { return mValue; }
 
-    /*implicit*/ operator const T_value & () const
+    /*implicit*/ constexpr operator const T_value & () const
     { return value(); }
 
 private:
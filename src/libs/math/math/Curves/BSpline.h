@@ -0,0 +1,399 @@
+#pragma once
+
+
+#include "Bezier.h"
+
+#include "../Utilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+#define TMP int N_degree, int N_pointDimension, class T_number
+#define TMP_D int N_degree, int N_pointDimension, class T_number = double
+#define TMA N_degree, N_pointDimension, T_number
+
+
+/// \brief Model a B-spline curve of compile-time degree, with an arbitrary number of control points.
+///
+/// The knot vector has (control point count + N_degree + 1) non-decreasing values.
+/// The curve is defined over the domain [knot(N_degree), knot(control point count)].
+/// It interpolates its end control points when the knot vector is clamped (end knots of multiplicity N_degree + 1).
+///
+/// \see The NURBS Book, Piegl & Tiller, for the algorithms.
+template <TMP_D>
+class BSpline
+{
+    static_assert(N_degree >= 0, "B-splines are supported from degree 0 onward.");
+
+public:
+    static constexpr int degree_v = N_degree;
+
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Bezier_t = Bezier<N_degree + 1, N_pointDimension, T_number>;
+
+    /// \attention Requires at least N_degree + 1 control points, and a matching knot vector.
+    BSpline(std::vector<Position_t> aControlPoints, std::vector<T_number> aKnots);
+
+    /// \brief Construct a B-spline with a clamped uniform knot vector over [0, 1].
+    static BSpline ClampedUniform(std::vector<Position_t> aControlPoints);
+
+    const std::vector<Position_t> & controlPoints() const
+    { return mControlPoints; }
+
+    const std::vector<T_number> & knots() const
+    { return mKnots; }
+
+    /// \brief The parameter range over which the curve is defined.
+    std::pair<T_number, T_number> domain() const
+    { return {mKnots[N_degree], mKnots[mControlPoints.size()]}; }
+
+    /// \brief Index `k` of the knot span containing `aParameter`, i.e. knot(k) <= aParameter < knot(k + 1).
+    ///
+    /// Found by binary search, in O(log n).
+    /// `aParameter` is clamped to the domain, the end of the domain belonging to the last non-empty span.
+    std::size_t findSpan(T_number aParameter) const;
+
+    /// \brief Evaluate the position at `aParameter` (clamped to the domain), with de Boor's algorithm.
+    Position_t evaluate(T_number aParameter) const;
+
+    /// \brief Evaluate the first derivative at `aParameter` (clamped to the domain).
+    ///
+    /// It does not allocate, contrary to `derivative().evaluate()`.
+    Vec<N_pointDimension, T_number> evaluateDerivative(T_number aParameter) const;
+
+    /// \brief The derivative curve, a B-spline of degree N_degree - 1.
+    BSpline<N_degree - 1, N_pointDimension, T_number> derivative() const
+        requires (N_degree >= 1);
+
+    /// \brief Insert the knot `aParameter` once (Boehm's algorithm), without changing the curve shape.
+    void insertKnot(T_number aParameter);
+
+    /// \brief Split the curve into Bezier segments, one for each non-empty knot span of the domain.
+    ///
+    /// This allows to use the Bezier algorithms (tessellation, flattening, ...) on B-splines.
+    std::vector<Bezier_t> toBezierSegments() const
+        requires (N_degree >= 1);
+
+private:
+    template <class T_value>
+    static T_value deBoor(std::array<T_value, N_degree + 1> & aLocal,
+                          int aDegree,
+                          const T_number * aKnots,
+                          std::size_t aSpan,
+                          T_number aParameter);
+
+    T_number clampToDomain(T_number aParameter) const
+    { return std::clamp(aParameter, domain().first, domain().second); }
+
+    std::vector<Position_t> mControlPoints;
+    std::vector<T_number> mKnots;
+};
+
+
+/// \brief Model a non-uniform rational B-spline curve.
+///
+/// It is stored as a B-spline in homogeneous coordinates, each control point being weighted.
+template <TMP_D>
+class Nurbs
+{
+public:
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Homogeneous_t = BSpline<N_degree, N_pointDimension + 1, T_number>;
+
+    /// \attention Weights must be strictly positive.
+    Nurbs(const std::vector<Position_t> & aControlPoints,
+          const std::vector<T_number> & aWeights,
+          std::vector<T_number> aKnots);
+
+    const Homogeneous_t & homogeneous() const
+    { return mHomogeneous; }
+
+    std::pair<T_number, T_number> domain() const
+    { return mHomogeneous.domain(); }
+
+    Position_t evaluate(T_number aParameter) const;
+
+    Vec<N_pointDimension, T_number> evaluateDerivative(T_number aParameter) const;
+
+    /// \brief Split the curve into Bezier segments in homogeneous coordinates.
+    ///
+    /// Each segment is a rational Bezier: the last coordinate of its evaluations is the weight,
+    /// by which the other coordinates must be divided.
+    std::vector<typename Homogeneous_t::Bezier_t> toHomogeneousBezierSegments() const
+    { return mHomogeneous.toBezierSegments(); }
+
+private:
+    Homogeneous_t mHomogeneous;
+};
+
+
+//
+// Implementations
+//
+template <TMP>
+BSpline<TMA>::BSpline(std::vector<Position_t> aControlPoints, std::vector<T_number> aKnots) :
+    mControlPoints{std::move(aControlPoints)},
+    mKnots{std::move(aKnots)}
+{
+    assert(mControlPoints.size() >= N_degree + 1);
+    assert(mKnots.size() == mControlPoints.size() + N_degree + 1);
+    assert(std::is_sorted(mKnots.begin(), mKnots.end()));
+    assert(domain().first < domain().second);
+}
+
+
+template <TMP>
+BSpline<TMA> BSpline<TMA>::ClampedUniform(std::vector<Position_t> aControlPoints)
+{
+    const std::size_t spanCount = aControlPoints.size() - N_degree;
+    std::vector<T_number> knots;
+    knots.reserve(aControlPoints.size() + N_degree + 1);
+    knots.insert(knots.end(), N_degree, T_number{0});
+    for (std::size_t knotId = 0; knotId <= spanCount; ++knotId)
+    {
+        knots.push_back(static_cast<T_number>(knotId) / static_cast<T_number>(spanCount));
+    }
+    knots.insert(knots.end(), N_degree, T_number{1});
+    return BSpline{std::move(aControlPoints), std::move(knots)};
+}
+
+
+template <TMP>
+std::size_t BSpline<TMA>::findSpan(T_number aParameter) const
+{
+    const std::size_t last = mControlPoints.size() - 1;
+    aParameter = clampToDomain(aParameter);
+    if (aParameter >= mKnots[last + 1])
+    {
+        // The end of the domain: the last span with a non zero length.
+        std::size_t span = last;
+        while (mKnots[span] == mKnots[span + 1])
+        {
+            --span;
+        }
+        return span;
+    }
+    // First knot strictly greater than the parameter, searched in [N_degree, last + 1].
+    auto found = std::upper_bound(mKnots.begin() + N_degree, mKnots.begin() + last + 1, aParameter);
+    return static_cast<std::size_t>(found - mKnots.begin()) - 1;
+}
+
+
+template <TMP>
+template <class T_value>
+T_value BSpline<TMA>::deBoor(std::array<T_value, N_degree + 1> & aLocal,
+                             int aDegree,
+                             const T_number * aKnots,
+                             std::size_t aSpan,
+                             T_number aParameter)
+{
+    // aLocal[j] initially holds the control point (aSpan - aDegree + j).
+    for (int r = 1; r <= aDegree; ++r)
+    {
+        for (int j = aDegree; j >= r; --j)
+        {
+            const T_number low = aKnots[aSpan - aDegree + j];
+            const T_number high = aKnots[aSpan + 1 + j - r];
+            const T_number alpha = (aParameter - low) / (high - low);
+            aLocal[j] = aLocal[j - 1] + alpha * (aLocal[j] - aLocal[j - 1]);
+        }
+    }
+    return aLocal[aDegree];
+}
+
+
+template <TMP>
+typename BSpline<TMA>::Position_t BSpline<TMA>::evaluate(T_number aParameter) const
+{
+    aParameter = clampToDomain(aParameter);
+    const std::size_t span = findSpan(aParameter);
+
+    auto local = makeFilledArray<N_degree + 1>(mControlPoints[span - N_degree]);
+    for (int j = 1; j <= N_degree; ++j)
+    {
+        local[j] = mControlPoints[span - N_degree + j];
+    }
+    return deBoor(local, N_degree, mKnots.data(), span, aParameter);
+}
+
+
+template <TMP>
+Vec<N_pointDimension, T_number> BSpline<TMA>::evaluateDerivative(T_number aParameter) const
+{
+    if constexpr (N_degree == 0)
+    {
+        return Vec<N_pointDimension, T_number>::Zero();
+    }
+    else
+    {
+        aParameter = clampToDomain(aParameter);
+        const std::size_t span = findSpan(aParameter);
+
+        // The derivative control points Q(i) = p * (P(i+1) - P(i)) / (t(i+p+1) - t(i+1)),
+        // over the knot vector without its first and last knots.
+        // In this knot vector, the span is (span - 1), and the local control points are Q(span - p) to Q(span - 1).
+        auto local = makeFilledArray<N_degree + 1>(Vec<N_pointDimension, T_number>::Zero());
+        for (int j = 0; j != N_degree; ++j)
+        {
+            const std::size_t i = span - N_degree + j;
+            const T_number knotRange = mKnots[i + N_degree + 1] - mKnots[i + 1];
+            if (knotRange > T_number{0})
+            {
+                local[j] = (N_degree / knotRange) * (mControlPoints[i + 1] - mControlPoints[i]);
+            }
+        }
+        return deBoor(local, N_degree - 1, mKnots.data() + 1, span - 1, aParameter);
+    }
+}
+
+
+template <TMP>
+BSpline<N_degree - 1, N_pointDimension, T_number> BSpline<TMA>::derivative() const
+    requires (N_degree >= 1)
+{
+    using Derivative_t = BSpline<N_degree - 1, N_pointDimension, T_number>;
+
+    std::vector<typename Derivative_t::Position_t> controlPoints;
+    controlPoints.reserve(mControlPoints.size() - 1);
+    for (std::size_t i = 0; i + 1 != mControlPoints.size(); ++i)
+    {
+        const T_number knotRange = mKnots[i + N_degree + 1] - mKnots[i + 1];
+        controlPoints.push_back(knotRange > T_number{0} ?
+            ((N_degree / knotRange) * (mControlPoints[i + 1] - mControlPoints[i])).template as<Position>()
+            : Position_t::Zero());
+    }
+    return Derivative_t{std::move(controlPoints), std::vector<T_number>(mKnots.begin() + 1, mKnots.end() - 1)};
+}
+
+
+template <TMP>
+void BSpline<TMA>::insertKnot(T_number aParameter)
+{
+    const std::size_t span = findSpan(aParameter);
+
+    // Control points (span - p + 1) to (span) are replaced by p new points, shifting the following ones.
+    std::vector<Position_t> inserted;
+    inserted.reserve(N_degree);
+    for (std::size_t i = span - N_degree + 1; i <= span; ++i)
+    {
+        const T_number alpha = (aParameter - mKnots[i]) / (mKnots[i + N_degree] - mKnots[i]);
+        inserted.push_back(mControlPoints[i - 1] + alpha * (mControlPoints[i] - mControlPoints[i - 1]));
+    }
+
+    mControlPoints.insert(mControlPoints.begin() + span, mControlPoints[span]);
+    std::copy(inserted.begin(), inserted.end(), mControlPoints.begin() + (span - N_degree + 1));
+    mKnots.insert(mKnots.begin() + span + 1, aParameter);
+}
+
+
+template <TMP>
+std::vector<typename BSpline<TMA>::Bezier_t> BSpline<TMA>::toBezierSegments() const
+    requires (N_degree >= 1)
+{
+    // Once each knot of the domain has a multiplicity of at least N_degree,
+    // the control points of each non-empty span are the control points of a Bezier segment.
+    BSpline refined = *this;
+    const auto [low, high] = domain();
+    for (std::size_t knotId = N_degree; knotId < refined.mKnots.size() && refined.mKnots[knotId] <= high;)
+    {
+        const T_number knot = refined.mKnots[knotId];
+        const auto multiplicity = std::count(refined.mKnots.begin(), refined.mKnots.end(), knot);
+        for (auto insertion = multiplicity; insertion < N_degree; ++insertion)
+        {
+            refined.insertKnot(knot);
+        }
+        knotId = std::upper_bound(refined.mKnots.begin(), refined.mKnots.end(), knot) - refined.mKnots.begin();
+    }
+
+    std::vector<Bezier_t> segments;
+    for (std::size_t span = N_degree; span != refined.mControlPoints.size(); ++span)
+    {
+        if (refined.mKnots[span] < refined.mKnots[span + 1])
+        {
+            std::array<Position_t, N_degree + 1> points = makeFilledArray<N_degree + 1>(Position_t::Zero());
+            std::copy(refined.mControlPoints.begin() + (span - N_degree),
+                      refined.mControlPoints.begin() + span + 1,
+                      points.begin());
+            segments.push_back(std::make_from_tuple<Bezier_t>(points));
+        }
+    }
+    return segments;
+}
+
+
+template <TMP>
+Nurbs<TMA>::Nurbs(const std::vector<Position_t> & aControlPoints,
+                  const std::vector<T_number> & aWeights,
+                  std::vector<T_number> aKnots) :
+    mHomogeneous{
+        [&]()
+        {
+            assert(aControlPoints.size() == aWeights.size());
+            std::vector<typename Homogeneous_t::Position_t> weighted;
+            weighted.reserve(aControlPoints.size());
+            for (std::size_t pointId = 0; pointId != aControlPoints.size(); ++pointId)
+            {
+                assert(aWeights[pointId] > T_number{0});
+                auto homogeneous = Homogeneous_t::Position_t::Zero();
+                for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+                {
+                    homogeneous[dimension] = aWeights[pointId] * aControlPoints[pointId][dimension];
+                }
+                homogeneous[N_pointDimension] = aWeights[pointId];
+                weighted.push_back(homogeneous);
+            }
+            return weighted;
+        }(),
+        std::move(aKnots)
+    }
+{}
+
+
+template <TMP>
+typename Nurbs<TMA>::Position_t Nurbs<TMA>::evaluate(T_number aParameter) const
+{
+    const auto homogeneous = mHomogeneous.evaluate(aParameter);
+    Position_t result = Position_t::Zero();
+    for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+    {
+        result[dimension] = homogeneous[dimension] / homogeneous[N_pointDimension];
+    }
+    return result;
+}
+
+
+template <TMP>
+Vec<N_pointDimension, T_number> Nurbs<TMA>::evaluateDerivative(T_number aParameter) const
+{
+    // With A the weighted position and w the weight: C' = (A' - w' * C) / w
+    const auto homogeneous = mHomogeneous.evaluate(aParameter);
+    const auto homogeneousDerivative = mHomogeneous.evaluateDerivative(aParameter);
+    const T_number weight = homogeneous[N_pointDimension];
+    const T_number weightDerivative = homogeneousDerivative[N_pointDimension];
+
+    Vec<N_pointDimension, T_number> result = Vec<N_pointDimension, T_number>::Zero();
+    for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+    {
+        const T_number position = homogeneous[dimension] / weight;
+        result[dimension] = (homogeneousDerivative[dimension] - weightDerivative * position) / weight;
+    }
+    return result;
+}
+
+
+#undef TMA
+#undef TMP_D
+#undef TMP
+
+
+} // namespace math
+} // namespace ad
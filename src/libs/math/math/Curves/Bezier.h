@@ -3,7 +3,19 @@
 
 #include "CurveBase.h"
 
+#include "../Box.h"
+#include "../Rectangle.h"
+#include "../Utilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <tuple>
 #include <utility> // for std::pair
+#include <vector>
+
+#include "../Polynomial.h"
 
 
 namespace ad {
@@ -15,30 +27,148 @@ namespace math {
 #define TMA N_controlPoints, N_pointDimension, T_number
 
 
+/// \brief The Bernstein polynomials of degree (N_controlPoints - 1), evaluated at `aParameter`.
+///
+/// They are the blending coefficients of Bezier curves, and do not depend on the control points:
+/// they can be computed once to evaluate many curves at the same parameter.
+template <int N_controlPoints, class T_number>
+constexpr Vec<N_controlPoints, T_number> getBernsteinCoefficients(T_number aParameter);
+
+
 /// \brief Model a Bézier curve of arbitrary degree, in a space of arbitrary dimension.
 template <TMP_D>
 class Bezier : public CurveBase<Bezier<TMA>, TMA>
 {
 public:
     using CurveBase<Bezier, TMA>::CurveBase;
+
+    constexpr Vec<N_controlPoints, T_number> getBlendingCoefficients(T_number aParameter) const
+    { return getBernsteinCoefficients<N_controlPoints>(aParameter); }
 };
 
 
 /// \brief Evaluate the curve position at given parameter value.
 template <TMP>
-typename Bezier<TMA>::Position_t evaluate(Bezier<TMA> aBezier, T_number aParameter);
+constexpr typename Bezier<TMA>::Position_t evaluate(Bezier<TMA> aBezier, T_number aParameter);
 
 
 /// \brief Subdivide the curve in two subcurves, using De Casteljau algorithm.
 template <TMP>
-std::pair<Bezier<TMA>, Bezier<TMA>> subdivide(Bezier<TMA> aBezier, T_number aParameter);
+constexpr std::pair<Bezier<TMA>, Bezier<TMA>> subdivide(Bezier<TMA> aBezier, T_number aParameter);
+
+
+/// \brief Evaluate the derivative of the curve with respect to its parameter, at `aParameter`.
+template <TMP>
+constexpr Vec<N_pointDimension, T_number> evaluateDerivative(const Bezier<TMA> & aBezier, T_number aParameter);
+
+
+/// \brief Evaluate the second derivative of the curve with respect to its parameter, at `aParameter`.
+template <TMP>
+constexpr Vec<N_pointDimension, T_number> evaluateSecondDerivative(const Bezier<TMA> & aBezier, T_number aParameter);
+
+
+/// \brief The hodograph, i.e. the Bezier curve of the derivative, which is one degree lower.
+///
+/// Its control "positions" are derivative vectors.
+template <TMP>
+Bezier<N_controlPoints - 1, N_pointDimension, T_number> derivative(const Bezier<TMA> & aBezier)
+    requires (N_controlPoints >= 3);
+
+
+/// \brief Unit tangent vector at `aParameter`.
+///
+/// Where the derivative vanishes (e.g. an endpoint coinciding with its handle),
+/// the direction of the second derivative is used.
+/// \attention Undefined when both derivatives vanish (e.g. all control points coincide).
+template <TMP>
+UnitVec<N_pointDimension, T_number> tangent(const Bezier<TMA> & aBezier, T_number aParameter);
+
+
+/// \brief Unsigned curvature at `aParameter`, i.e. the inverse of the osculating circle radius.
+///
+/// It is computed as |v x a| / |v|^3, generalized to any dimension, with v and a
+/// the first and second derivatives.
+template <TMP>
+T_number curvature(const Bezier<TMA> & aBezier, T_number aParameter);
+
+
+/// \brief Tight axis aligned bounds of the curve.
+///
+/// Up to cubic curves, the extrema are found analytically, as the roots of each coordinate
+/// of the derivative (solving a polynomial of degree 2 at most).
+/// For higher degrees, the bounds of the control points are returned: they contain the curve,
+/// but are not tight in general.
+template <int N_controlPoints, class T_number>
+Rectangle<T_number> boundingBox(const Bezier<N_controlPoints, 2, T_number> & aBezier);
+
+template <int N_controlPoints, class T_number>
+Box<T_number> boundingBox(const Bezier<N_controlPoints, 3, T_number> & aBezier);
+
+
+/// \brief Coefficients of the curve in the power (monomial) basis.
+///
+/// The curve is then B(t) = c[0] + c[1] * t + ... + c[degree] * t^degree.
+template <TMP>
+constexpr std::array<Vec<N_pointDimension, T_number>, N_controlPoints> toPowerBasis(const Bezier<TMA> & aBezier);
+
+
+/// \brief Evaluate the curve at `aSamples.size()` parameter values, evenly spaced over [0, 1].
+///
+/// After a setup evaluating the first `degree + 1` samples, each sample is obtained by forward
+/// differencing, i.e. `degree` vector additions. There is no allocation.
+/// The first and last samples are exactly the curve endpoints.
+/// \note Forward differencing accumulates rounding errors along the samples,
+/// which is negligible for the usual degrees and sample counts with double precision.
+template <TMP>
+void tessellate(const Bezier<TMA> & aBezier, std::span<typename Bezier<TMA>::Position_t> aSamples);
+
+
+/// \brief Approximate the curve with a polyline, within `aTolerance` of the curve.
+///
+/// The curve is recursively subdivided in halves, until the inner control points are within
+/// `aTolerance` of the chord. Since the curve lies in the convex hull of its control points,
+/// the chord is then within `aTolerance` of the curve.
+/// The subdivision uses an explicit fixed-size stack, there is no recursion and no allocation.
+///
+/// \return The output iterator past the last written vertex.
+/// The first vertex is the curve start, the last vertex is the curve end.
+template <TMP, class T_outputIterator>
+T_outputIterator flatten(const Bezier<TMA> & aBezier, T_number aTolerance, T_outputIterator aOutput);
 
 
 //
 // Implementations
 //
+template <int N_controlPoints, class T_number>
+constexpr Vec<N_controlPoints, T_number> getBernsteinCoefficients(T_number aParameter)
+{
+    constexpr int degree = N_controlPoints - 1;
+    const T_number complement = T_number{1} - aParameter;
+
+    // Build the increasing powers of t in the result, then multiply by the decreasing powers of (1 - t)
+    // and the binomial coefficients.
+    Vec<N_controlPoints, T_number> result = Vec<N_controlPoints, T_number>::Zero();
+    result[0] = T_number{1};
+    for (int k = 1; k != N_controlPoints; ++k)
+    {
+        result[k] = result[k - 1] * aParameter;
+    }
+
+    T_number complementPower{1};
+    T_number binomial{1};
+    for (int k = degree; k >= 0; --k)
+    {
+        result[k] *= binomial * complementPower;
+        complementPower *= complement;
+        // binomial(degree, k - 1) from binomial(degree, k)
+        binomial = binomial * k / (degree - k + 1);
+    }
+    return result;
+}
+
+
 template <TMP>
-typename Bezier<TMA>::Position_t evaluate(Bezier<TMA> aBezier, T_number aParameter)
+constexpr typename Bezier<TMA>::Position_t evaluate(Bezier<TMA> aBezier, T_number aParameter)
 {
     // Uses the Bezier object as storage, hence the copy
     for (std::size_t step = 1; step != N_controlPoints; ++step)
@@ -55,7 +185,7 @@ typename Bezier<TMA>::Position_t evaluate(Bezier<TMA> aBezier, T_number aParamet
 
 
 template <TMP>
-std::pair<Bezier<TMA>, Bezier<TMA>> subdivide(Bezier<TMA> aBezier, T_number aParameter)
+constexpr std::pair<Bezier<TMA>, Bezier<TMA>> subdivide(Bezier<TMA> aBezier, T_number aParameter)
 {
     // Would be enough to only copy first element, but we cannot make unitialized Bezier.
     Bezier<TMA> left = aBezier;
@@ -74,6 +204,347 @@ std::pair<Bezier<TMA>, Bezier<TMA>> subdivide(Bezier<TMA> aBezier, T_number aPar
 }
 
 
+template <TMP>
+constexpr std::array<Vec<N_pointDimension, T_number>, N_controlPoints> toPowerBasis(const Bezier<TMA> & aBezier)
+{
+    constexpr int degree = N_controlPoints - 1;
+
+    // c[k] = binomial(degree, k) * sum_i((-1)^(k-i) * binomial(k, i) * P[i])
+    auto coefficients = makeFilledArray<N_controlPoints>(Vec<N_pointDimension, T_number>::Zero());
+    T_number degreeBinomial{1};
+    for (int k = 0; k != N_controlPoints; ++k)
+    {
+        T_number binomial{1};
+        for (int i = k; i >= 0; --i)
+        {
+            const T_number factor = ((k - i) % 2 == 0) ? binomial : -binomial;
+            coefficients[k] += factor * aBezier[i].template as<Vec>();
+            // binomial(k, i - 1) from binomial(k, i)
+            binomial = binomial * i / (k - i + 1);
+        }
+        coefficients[k] *= degreeBinomial;
+        // binomial(degree, k + 1) from binomial(degree, k)
+        degreeBinomial = degreeBinomial * (degree - k) / (k + 1);
+    }
+    return coefficients;
+}
+
+
+namespace detail {
+
+
+    /// \brief The forward differences table of the curve, at parameter 0 for a parameter increment of `aStep`.
+    ///
+    /// Element k holds the k-th forward difference. The position at the current parameter is element 0,
+    /// and advanceForwardDifferences() moves the table to the next parameter.
+    template <TMP>
+    std::array<Vec<N_pointDimension, T_number>, N_controlPoints>
+    makeForwardDifferences(const Bezier<TMA> & aBezier, T_number aStep)
+    {
+        constexpr int degree = N_controlPoints - 1;
+        const auto coefficients = toPowerBasis(aBezier);
+
+        // Evaluate the first degree + 1 samples (Horner), then turn them into the forward differences table.
+        auto differences = makeFilledArray<N_controlPoints>(Vec<N_pointDimension, T_number>::Zero());
+        for (int sampleId = 0; sampleId != N_controlPoints; ++sampleId)
+        {
+            const T_number t = aStep * sampleId;
+            Vec<N_pointDimension, T_number> value = coefficients[degree];
+            for (int k = degree - 1; k >= 0; --k)
+            {
+                value = value * t + coefficients[k];
+            }
+            differences[sampleId] = value;
+        }
+        for (int order = 1; order != N_controlPoints; ++order)
+        {
+            for (int k = degree; k >= order; --k)
+            {
+                differences[k] -= differences[k - 1];
+            }
+        }
+        return differences;
+    }
+
+
+    /// \brief Advance the forward differences table by one parameter increment, i.e. `degree` vector additions.
+    template <std::size_t N_size, class T_vector>
+    void advanceForwardDifferences(std::array<T_vector, N_size> & aDifferences)
+    {
+        for (std::size_t k = 0; k + 1 < N_size; ++k)
+        {
+            aDifferences[k] += aDifferences[k + 1];
+        }
+    }
+
+
+} // namespace detail
+
+
+template <TMP>
+void tessellate(const Bezier<TMA> & aBezier, std::span<typename Bezier<TMA>::Position_t> aSamples)
+{
+    if (aSamples.size() < 2)
+    {
+        if (!aSamples.empty())
+        {
+            aSamples.front() = aBezier.start();
+        }
+        return;
+    }
+
+    const T_number step = T_number{1} / static_cast<T_number>(aSamples.size() - 1);
+    auto differences = detail::makeForwardDifferences(aBezier, step);
+    for (std::size_t sampleId = 0; sampleId != aSamples.size(); ++sampleId)
+    {
+        aSamples[sampleId] = differences[0].template as<Position>();
+        detail::advanceForwardDifferences(differences);
+    }
+
+    aSamples.front() = aBezier.start();
+    aSamples.back() = aBezier.end();
+}
+
+
+namespace detail {
+
+
+    /// \brief Whether all the inner control points are within `aToleranceSquared` of the chord.
+    template <TMP>
+    bool isFlat(const Bezier<TMA> & aBezier, T_number aToleranceSquared)
+    {
+        const Vec<N_pointDimension, T_number> chord = aBezier.end() - aBezier.start();
+        const T_number chordSquared = chord.getNormSquared();
+        for (int controlId = 1; controlId != N_controlPoints - 1; ++controlId)
+        {
+            const Vec<N_pointDimension, T_number> offset = aBezier[controlId] - aBezier.start();
+            // Distance to the chord segment (the endpoints might coincide).
+            T_number ratio{0};
+            if (chordSquared > T_number{0})
+            {
+                ratio = std::clamp(offset.dot(chord) / chordSquared, T_number{0}, T_number{1});
+            }
+            if ((offset - ratio * chord).getNormSquared() > aToleranceSquared)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+} // namespace detail
+
+
+template <TMP, class T_outputIterator>
+T_outputIterator flatten(const Bezier<TMA> & aBezier, T_number aTolerance, T_outputIterator aOutput)
+{
+    // Each subdivision halves the flatness, so this depth is only reached for zero tolerance.
+    constexpr int gMaxDepth = 24;
+
+    struct Pending
+    {
+        Bezier<TMA> curve;
+        int depth;
+    };
+
+    // Depth first: each level pops a curve and pushes its two halves, so it grows the stack by one.
+    auto stack = makeFilledArray<gMaxDepth + 1>(Pending{aBezier, 0});
+    std::size_t stackSize = 1;
+    const T_number toleranceSquared = aTolerance * aTolerance;
+
+    *aOutput++ = aBezier.start();
+    while (stackSize != 0)
+    {
+        const Pending pending = stack[--stackSize];
+        if (pending.depth == gMaxDepth || detail::isFlat(pending.curve, toleranceSquared))
+        {
+            *aOutput++ = pending.curve.end();
+        }
+        else
+        {
+            auto [left, right] = subdivide(pending.curve, T_number{0.5});
+            stack[stackSize++] = Pending{right, pending.depth + 1};
+            stack[stackSize++] = Pending{left, pending.depth + 1};
+        }
+    }
+    return aOutput;
+}
+
+
+namespace detail {
+
+
+    /// \brief De Casteljau evaluation of a Bezier curve whose control values are in `aValues`.
+    template <class T_value, std::size_t N_size, class T_number>
+    constexpr T_value deCasteljau(std::array<T_value, N_size> aValues, T_number aParameter)
+    {
+        for (std::size_t step = 1; step < N_size; ++step)
+        {
+            for (std::size_t valueId = 0; valueId != N_size - step; ++valueId)
+            {
+                aValues[valueId] = aValues[valueId] + aParameter * (aValues[valueId + 1] - aValues[valueId]);
+            }
+        }
+        return aValues[0];
+    }
+
+
+    /// \brief Low and high corners of the axis aligned bounds of the curve.
+    template <TMP>
+    std::pair<Position<N_pointDimension, T_number>, Position<N_pointDimension, T_number>>
+    computeBounds(const Bezier<TMA> & aBezier)
+    {
+        Position<N_pointDimension, T_number> low = min(aBezier.start(), aBezier.end());
+        Position<N_pointDimension, T_number> high = max(aBezier.start(), aBezier.end());
+
+        if constexpr (N_controlPoints <= 4)
+        {
+            const auto coefficients = toPowerBasis(aBezier);
+            auto include = [&](T_number aParameter)
+            {
+                if (aParameter > T_number{0} && aParameter < T_number{1})
+                {
+                    const Position<N_pointDimension, T_number> position = evaluate(aBezier, aParameter);
+                    low = min(low, position);
+                    high = max(high, position);
+                }
+            };
+
+            for (int axis = 0; axis != N_pointDimension; ++axis)
+            {
+                // Coefficients of the derivative of this coordinate, in increasing degree.
+                std::array<T_number, 3> derivative{0, 0, 0};
+                for (int k = 1; k != N_controlPoints; ++k)
+                {
+                    derivative[k - 1] = k * coefficients[k][axis];
+                }
+
+                if (derivative[2] != T_number{0})
+                {
+                    for (T_number root : solve(Polynomial<2, T_number>{derivative[0], derivative[1], derivative[2]}))
+                    {
+                        include(root);
+                    }
+                }
+                else if (derivative[1] != T_number{0})
+                {
+                    include(-derivative[0] / derivative[1]);
+                }
+            }
+        }
+        else
+        {
+            for (int controlId = 1; controlId != N_controlPoints - 1; ++controlId)
+            {
+                low = min(low, aBezier[controlId]);
+                high = max(high, aBezier[controlId]);
+            }
+        }
+
+        return {low, high};
+    }
+
+
+} // namespace detail
+
+
+template <TMP>
+constexpr Vec<N_pointDimension, T_number> evaluateDerivative(const Bezier<TMA> & aBezier, T_number aParameter)
+{
+    constexpr int degree = N_controlPoints - 1;
+    auto differences = makeFilledArray<degree>(Vec<N_pointDimension, T_number>::Zero());
+    for (int controlId = 0; controlId != degree; ++controlId)
+    {
+        differences[controlId] = T_number{degree} * (aBezier[controlId + 1] - aBezier[controlId]);
+    }
+    return detail::deCasteljau(differences, aParameter);
+}
+
+
+template <TMP>
+constexpr Vec<N_pointDimension, T_number> evaluateSecondDerivative(const Bezier<TMA> & aBezier, T_number aParameter)
+{
+    constexpr int degree = N_controlPoints - 1;
+    if constexpr (degree < 2)
+    {
+        return Vec<N_pointDimension, T_number>::Zero();
+    }
+    else
+    {
+        auto differences = makeFilledArray<degree - 1>(Vec<N_pointDimension, T_number>::Zero());
+        for (int controlId = 0; controlId != degree - 1; ++controlId)
+        {
+            differences[controlId] = T_number{degree * (degree - 1)}
+                * ((aBezier[controlId + 2] - aBezier[controlId + 1]) - (aBezier[controlId + 1] - aBezier[controlId]));
+        }
+        return detail::deCasteljau(differences, aParameter);
+    }
+}
+
+
+template <TMP>
+Bezier<N_controlPoints - 1, N_pointDimension, T_number> derivative(const Bezier<TMA> & aBezier)
+    requires (N_controlPoints >= 3)
+{
+    using Position_t = typename Bezier<TMA>::Position_t;
+    constexpr int degree = N_controlPoints - 1;
+
+    auto points = makeFilledArray<degree>(Position_t::Zero());
+    for (int controlId = 0; controlId != degree; ++controlId)
+    {
+        points[controlId] = (T_number{degree} * (aBezier[controlId + 1] - aBezier[controlId])).template as<Position>();
+    }
+    return std::make_from_tuple<Bezier<N_controlPoints - 1, N_pointDimension, T_number>>(points);
+}
+
+
+template <TMP>
+UnitVec<N_pointDimension, T_number> tangent(const Bezier<TMA> & aBezier, T_number aParameter)
+{
+    const Vec<N_pointDimension, T_number> velocity = evaluateDerivative(aBezier, aParameter);
+    if (velocity != Vec<N_pointDimension, T_number>::Zero())
+    {
+        return UnitVec<N_pointDimension, T_number>{velocity};
+    }
+    return UnitVec<N_pointDimension, T_number>{evaluateSecondDerivative(aBezier, aParameter)};
+}
+
+
+template <TMP>
+T_number curvature(const Bezier<TMA> & aBezier, T_number aParameter)
+{
+    const Vec<N_pointDimension, T_number> velocity = evaluateDerivative(aBezier, aParameter);
+    const Vec<N_pointDimension, T_number> acceleration = evaluateSecondDerivative(aBezier, aParameter);
+    const T_number speedSquared = velocity.getNormSquared();
+    if (speedSquared == T_number{0})
+    {
+        return T_number{0};
+    }
+
+    // |v x a|^2 == |v|^2 |a|^2 - (v.a)^2 (Lagrange's identity)
+    const T_number dot = velocity.dot(acceleration);
+    const T_number crossSquared = std::max(T_number{0}, speedSquared * acceleration.getNormSquared() - dot * dot);
+    return std::sqrt(crossSquared) / (speedSquared * std::sqrt(speedSquared));
+}
+
+
+template <int N_controlPoints, class T_number>
+Rectangle<T_number> boundingBox(const Bezier<N_controlPoints, 2, T_number> & aBezier)
+{
+    const auto [low, high] = detail::computeBounds(aBezier);
+    return {low, (high - low).template as<Size>()};
+}
+
+
+template <int N_controlPoints, class T_number>
+Box<T_number> boundingBox(const Bezier<N_controlPoints, 3, T_number> & aBezier)
+{
+    const auto [low, high] = detail::computeBounds(aBezier);
+    return {low, (high - low).template as<Size>()};
+}
+
+
 #undef TMA
 #undef TMP_D
 #undef TMP
@@ -0,0 +1,258 @@
+#pragma once
+
+
+#include "Bezier.h"
+
+#include "../Utilities.h"
+#include "../Vector.h"
+
+#include <array>
+#include <cassert>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+
+namespace ad {
+namespace math {
+
+
+#define TMP int N_uControlPoints, int N_vControlPoints, int N_pointDimension, class T_number
+#define TMP_D int N_uControlPoints, int N_vControlPoints, int N_pointDimension, class T_number = double
+#define TMA N_uControlPoints, N_vControlPoints, N_pointDimension, T_number
+
+
+/// \brief Tensor product Bézier surface, with a grid of N_uControlPoints x N_vControlPoints control points.
+///
+/// Control points are stored row by row, each row being the control points along u at a given v index.
+/// Each row is thus a Bezier curve along u, and each column a Bezier curve along v.
+template <TMP_D>
+class BezierPatch
+{
+    static_assert(N_uControlPoints >= 2 && N_vControlPoints >= 2,
+                  "Patches are supported from degree 1 onward, in both directions.");
+
+public:
+    static constexpr int size_v = N_uControlPoints * N_vControlPoints;
+
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Row_t = Bezier<N_uControlPoints, N_pointDimension, T_number>;
+    using Column_t = Bezier<N_vControlPoints, N_pointDimension, T_number>;
+
+    /// \brief Construct from the control points, row by row.
+    template <class... T_position,
+              std::enable_if_t<sizeof...(T_position) == size_v, int> = 0>
+    constexpr BezierPatch(T_position... vaControlPoints) :
+        mControlPoints{ {vaControlPoints...} }
+    {}
+
+    /// \brief Control point at index `aU` along u, and `aV` along v.
+    Position_t & at(std::size_t aU, std::size_t aV)
+    { return mControlPoints[aV * N_uControlPoints + aU]; }
+    Position_t at(std::size_t aU, std::size_t aV) const
+    { return mControlPoints[aV * N_uControlPoints + aU]; }
+
+    /// \brief The Bezier curve along u, defined by the control points at v index `aV`.
+    Row_t getRow(std::size_t aV) const;
+
+    /// \brief The Bezier curve along v, defined by the control points at u index `aU`.
+    Column_t getColumn(std::size_t aU) const;
+
+    constexpr const Position_t * data() const noexcept
+    { return mControlPoints.data(); }
+
+    constexpr bool operator==(const BezierPatch & aRhs) const
+    { return mControlPoints == aRhs.mControlPoints; }
+    constexpr bool operator!=(const BezierPatch & aRhs) const
+    { return ! (*this == aRhs); }
+
+private:
+    std::array<Position_t, size_v> mControlPoints;
+};
+
+
+/// \brief Evaluate the surface position at parameters (`aU`, `aV`).
+///
+/// This is the tensor product of the Bernstein polynomials in u and in v.
+template <TMP>
+Position<N_pointDimension, T_number> evaluate(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV);
+
+
+/// \brief Partial derivative of the surface with respect to u, at parameters (`aU`, `aV`).
+template <TMP>
+Vec<N_pointDimension, T_number> evaluatePartialU(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV);
+
+
+/// \brief Partial derivative of the surface with respect to v, at parameters (`aU`, `aV`).
+template <TMP>
+Vec<N_pointDimension, T_number> evaluatePartialV(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV);
+
+
+/// \brief Unit normal of the surface at parameters (`aU`, `aV`), i.e. the normalized cross product
+/// of the partial derivatives along u then along v.
+/// \attention Undefined where a partial derivative vanishes, e.g. at the corners of a degenerate
+/// (collapsed edge) patch.
+template <int N_uControlPoints, int N_vControlPoints, class T_number>
+UnitVec<3, T_number> normal(const BezierPatch<N_uControlPoints, N_vControlPoints, 3, T_number> & aPatch,
+                            T_number aU,
+                            T_number aV);
+
+
+/// \brief Evaluate the surface on a grid of `aUCount` x `aVCount` parameters, evenly spaced over [0, 1]^2.
+///
+/// Vertices are written row by row in `aVertices`: the vertex at u index `i` and v index `j` is at `j * aUCount + i`.
+/// The columns of control points are forward differenced along v, giving the row curve at each v sample,
+/// which is then tessellated along u by forward differencing as well. There is no allocation.
+/// \see tessellate() for Bezier.
+template <TMP>
+void tessellate(const BezierPatch<TMA> & aPatch,
+                std::size_t aUCount,
+                std::size_t aVCount,
+                std::span<Position<N_pointDimension, T_number>> aVertices);
+
+
+//
+// Implementations
+//
+template <TMP>
+typename BezierPatch<TMA>::Row_t BezierPatch<TMA>::getRow(std::size_t aV) const
+{
+    assert(aV < N_vControlPoints);
+    auto points = makeFilledArray<N_uControlPoints>(Position_t::Zero());
+    for (std::size_t u = 0; u != N_uControlPoints; ++u)
+    {
+        points[u] = at(u, aV);
+    }
+    return std::make_from_tuple<Row_t>(points);
+}
+
+
+template <TMP>
+typename BezierPatch<TMA>::Column_t BezierPatch<TMA>::getColumn(std::size_t aU) const
+{
+    assert(aU < N_uControlPoints);
+    auto points = makeFilledArray<N_vControlPoints>(Position_t::Zero());
+    for (std::size_t v = 0; v != N_vControlPoints; ++v)
+    {
+        points[v] = at(aU, v);
+    }
+    return std::make_from_tuple<Column_t>(points);
+}
+
+
+template <TMP>
+Position<N_pointDimension, T_number> evaluate(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV)
+{
+    const Vec<N_uControlPoints, T_number> uCoefficients = getBernsteinCoefficients<N_uControlPoints>(aU);
+    const Vec<N_vControlPoints, T_number> vCoefficients = getBernsteinCoefficients<N_vControlPoints>(aV);
+
+    auto result = Position<N_pointDimension, T_number>::Zero();
+    for (int v = 0; v != N_vControlPoints; ++v)
+    {
+        auto row = Vec<N_pointDimension, T_number>::Zero();
+        for (int u = 0; u != N_uControlPoints; ++u)
+        {
+            row += uCoefficients[u] * aPatch.at(u, v).template as<Vec>();
+        }
+        result += vCoefficients[v] * row;
+    }
+    return result;
+}
+
+
+template <TMP>
+Vec<N_pointDimension, T_number> evaluatePartialU(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV)
+{
+    const Vec<N_vControlPoints, T_number> vCoefficients = getBernsteinCoefficients<N_vControlPoints>(aV);
+    auto result = Vec<N_pointDimension, T_number>::Zero();
+    for (int v = 0; v != N_vControlPoints; ++v)
+    {
+        result += vCoefficients[v] * evaluateDerivative(aPatch.getRow(v), aU);
+    }
+    return result;
+}
+
+
+template <TMP>
+Vec<N_pointDimension, T_number> evaluatePartialV(const BezierPatch<TMA> & aPatch, T_number aU, T_number aV)
+{
+    const Vec<N_uControlPoints, T_number> uCoefficients = getBernsteinCoefficients<N_uControlPoints>(aU);
+    auto result = Vec<N_pointDimension, T_number>::Zero();
+    for (int u = 0; u != N_uControlPoints; ++u)
+    {
+        result += uCoefficients[u] * evaluateDerivative(aPatch.getColumn(u), aV);
+    }
+    return result;
+}
+
+
+template <int N_uControlPoints, int N_vControlPoints, class T_number>
+UnitVec<3, T_number> normal(const BezierPatch<N_uControlPoints, N_vControlPoints, 3, T_number> & aPatch,
+                            T_number aU,
+                            T_number aV)
+{
+    Vec<3, T_number> partialU = evaluatePartialU(aPatch, aU, aV);
+    return UnitVec<3, T_number>{partialU.cross(evaluatePartialV(aPatch, aU, aV))};
+}
+
+
+template <TMP>
+void tessellate(const BezierPatch<TMA> & aPatch,
+                std::size_t aUCount,
+                std::size_t aVCount,
+                std::span<Position<N_pointDimension, T_number>> aVertices)
+{
+    using Position_t = Position<N_pointDimension, T_number>;
+    assert(aVertices.size() == aUCount * aVCount);
+
+    if (aVCount < 2)
+    {
+        if (aVCount == 1)
+        {
+            tessellate(aPatch.getRow(0), aVertices);
+        }
+        return;
+    }
+
+    const T_number step = T_number{1} / static_cast<T_number>(aVCount - 1);
+    auto columnDifferences = makeFilledArray<N_uControlPoints>(
+        detail::makeForwardDifferences(aPatch.getColumn(0), step));
+    for (int u = 1; u != N_uControlPoints; ++u)
+    {
+        columnDifferences[u] = detail::makeForwardDifferences(aPatch.getColumn(u), step);
+    }
+
+    auto rowPoints = makeFilledArray<N_uControlPoints>(Position_t::Zero());
+    for (std::size_t vSample = 0; vSample != aVCount; ++vSample)
+    {
+        for (int u = 0; u != N_uControlPoints; ++u)
+        {
+            rowPoints[u] = columnDifferences[u][0].template as<Position>();
+            detail::advanceForwardDifferences(columnDifferences[u]);
+        }
+
+        std::span<Position_t> rowVertices = aVertices.subspan(vSample * aUCount, aUCount);
+        // The first and last rows are exactly the patch boundary curves.
+        if (vSample == 0)
+        {
+            tessellate(aPatch.getRow(0), rowVertices);
+        }
+        else if (vSample == aVCount - 1)
+        {
+            tessellate(aPatch.getRow(N_vControlPoints - 1), rowVertices);
+        }
+        else
+        {
+            tessellate(std::make_from_tuple<typename BezierPatch<TMA>::Row_t>(rowPoints), rowVertices);
+        }
+    }
+}
+
+
+#undef TMA
+#undef TMP_D
+#undef TMP
+
+
+} // namespace math
+} // namespace ad
@@ -13,6 +13,29 @@ namespace math {
 #define TMP_D int N_pointDimension, class T_number = double
 #define TMA N_pointDimension, T_number
 
+namespace detail {
+
+
+    template <class T_number>
+    constexpr math::Vec<4, T_number> getCardinalBlendingCoefficients(T_number aSFactor, T_number aParameter)
+    {
+        const T_number t = aParameter;
+        const T_number s = aSFactor;
+        const T_number t2 = t * t;
+        const T_number t3 = t2 * t;
+
+        return {
+                -s * t  + (2 * s) * t2      - s * t3,
+            1.f         + (s - 3) * t2      + (2 - s) * t3,
+                s * t   + (3 - 2 * s) * t2  + (s - 2) * t3,
+                        - s * t2            + s * t3
+        };
+    }
+
+
+} // namespace detail
+
+
 template <TMP_D>
 class CardinalCubic : public CurveBase<CardinalCubic<TMA>, 4, N_pointDimension, T_number>
 {
@@ -37,23 +60,84 @@ public:
 
     constexpr math::Vec<4, T_number> getBlendingCoefficients(T_number aParameter) const;
 
+    /// \brief The derivatives of the blending coefficients with respect to the parameter.
+    constexpr math::Vec<4, T_number> getBlendingDerivativeCoefficients(T_number aParameter) const;
+
     constexpr Bezier<4, N_pointDimension, T_number> toBezier() const;
     
     constexpr Position_t evaluate(T_number aParameter) const
     { return evaluateBlending(*this, aParameter); }
 
+    /// \brief The tangent vector (derivative of the position with respect to the parameter).
+    constexpr Vec<N_pointDimension, T_number> evaluateDerivative(T_number aParameter) const;
+
 private:
-    static T_number computeSFactor(T_number aTension);
+    static constexpr T_number computeSFactor(T_number aTension);
 
     T_number mSFactor;
 };
 
 
+/// \brief The blending coefficients at `aParameter`, shared by all cardinal cubics with `aTension`.
+///
+/// They do not depend on the control points, so they can be computed once to evaluate many curves.
+template <class T_number>
+constexpr math::Vec<4, T_number> getCardinalBlendingCoefficients(T_number aTension, T_number aParameter)
+{
+    return detail::getCardinalBlendingCoefficients((T_number{1} - aTension) / T_number{2}, aParameter);
+}
+
+
+/// \brief Evaluate the curve at `aSamples.size()` parameter values, evenly spaced over [0, 1].
+/// \see tessellate() for Bezier, which is used on the equivalent Bezier curve.
+template <TMP>
+void tessellate(const CardinalCubic<TMA> & aCurve, std::span<typename CardinalCubic<TMA>::Position_t> aSamples)
+{
+    tessellate(aCurve.toBezier(), aSamples);
+}
+
+
+/// \brief Approximate the curve with a polyline, within `aTolerance` of the curve.
+/// \see flatten() for Bezier, which is used on the equivalent Bezier curve.
+template <TMP, class T_outputIterator>
+T_outputIterator flatten(const CardinalCubic<TMA> & aCurve, T_number aTolerance, T_outputIterator aOutput)
+{
+    return flatten(aCurve.toBezier(), aTolerance, aOutput);
+}
+
+
+/// \brief Unit tangent vector at `aParameter`.
+/// \see tangent() for Bezier, which is used on the equivalent Bezier curve.
+template <TMP>
+UnitVec<N_pointDimension, T_number> tangent(const CardinalCubic<TMA> & aCurve, T_number aParameter)
+{
+    return tangent(aCurve.toBezier(), aParameter);
+}
+
+
+/// \brief Unsigned curvature at `aParameter`.
+/// \see curvature() for Bezier, which is used on the equivalent Bezier curve.
+template <TMP>
+T_number curvature(const CardinalCubic<TMA> & aCurve, T_number aParameter)
+{
+    return curvature(aCurve.toBezier(), aParameter);
+}
+
+
+/// \brief Tight axis aligned bounds of the curve, found analytically.
+/// \see boundingBox() for Bezier, which is used on the equivalent Bezier curve.
+template <TMP>
+auto boundingBox(const CardinalCubic<TMA> & aCurve)
+{
+    return boundingBox(aCurve.toBezier());
+}
+
+
 //
 // Implementations
 //
 template <TMP>
-T_number CardinalCubic<TMA>::computeSFactor(T_number aTension)
+constexpr T_number CardinalCubic<TMA>::computeSFactor(T_number aTension)
 {
     return (T_number{1} - aTension) / T_number{2};
 }
@@ -61,21 +145,40 @@ T_number CardinalCubic<TMA>::computeSFactor(T_number aTension)
 
 template <TMP>
 constexpr math::Vec<4, T_number> CardinalCubic<TMA>::getBlendingCoefficients(T_number aParameter) const
+{
+    return detail::getCardinalBlendingCoefficients(mSFactor, aParameter);
+}
+
+
+template <TMP>
+constexpr math::Vec<4, T_number> CardinalCubic<TMA>::getBlendingDerivativeCoefficients(T_number aParameter) const
 {
     const T_number t = aParameter;
     const T_number s = mSFactor;
-    const T_number t2 = std::pow(t, 2);
-    const T_number t3 = std::pow(t, 3);
+    const T_number t2 = t * t;
 
     return {
-            -s * t  + (2 * s) * t2      - s * t3,
-        1.f         + (s - 3) * t2      + (2 - s) * t3,
-            s * t   + (3 - 2 * s) * t2  + (s - 2) * t3,
-                    - s * t2            + s * t3
+        -s      + (4 * s) * t           - (3 * s) * t2,
+                  (2 * s - 6) * t       + (6 - 3 * s) * t2,
+         s      + (6 - 4 * s) * t       + (3 * s - 6) * t2,
+                - (2 * s) * t           + (3 * s) * t2
     };
 }
 
 
+template <TMP>
+constexpr Vec<N_pointDimension, T_number> CardinalCubic<TMA>::evaluateDerivative(T_number aParameter) const
+{
+    auto coeffs = getBlendingDerivativeCoefficients(aParameter);
+    auto derivative = Vec<N_pointDimension, T_number>::Zero();
+    for (int controlId = 0; controlId != 4; ++controlId)
+    {
+        derivative += (*this)[controlId].template as<math::Vec>() * coeffs[controlId];
+    }
+    return derivative;
+}
+
+
 template <TMP>
 constexpr Bezier<4, N_pointDimension, T_number> CardinalCubic<TMA>::toBezier() const
 {
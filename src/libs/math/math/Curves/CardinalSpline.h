@@ -0,0 +1,302 @@
+#pragma once
+
+
+#include "CardinalCubic.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+#define TMP int N_pointDimension, class T_number
+#define TMP_D int N_pointDimension, class T_number = double
+#define TMA N_pointDimension, T_number
+
+
+namespace detail {
+
+
+    /// \brief Integrate `aFunction` over [aLow, aHigh] with 5 points Gauss-Legendre quadrature.
+    ///
+    /// It is exact for polynomials up to degree 9.
+    template <class T_number, class F_function>
+    T_number integrateGaussLegendre(F_function && aFunction, T_number aLow, T_number aHigh)
+    {
+        constexpr std::array<T_number, 5> gNodes{
+            T_number{0},
+            T_number{0.5384693101056830910363144},
+            T_number{-0.5384693101056830910363144},
+            T_number{0.9061798459386639927976269},
+            T_number{-0.9061798459386639927976269},
+        };
+        constexpr std::array<T_number, 5> gWeights{
+            T_number{0.5688888888888888888888889},
+            T_number{0.4786286704993664680412915},
+            T_number{0.4786286704993664680412915},
+            T_number{0.2369268850561890875142640},
+            T_number{0.2369268850561890875142640},
+        };
+
+        const T_number halfRange = (aHigh - aLow) / 2;
+        const T_number middle = (aHigh + aLow) / 2;
+        T_number result{0};
+        for (std::size_t nodeId = 0; nodeId != gNodes.size(); ++nodeId)
+        {
+            result += gWeights[nodeId] * aFunction(middle + halfRange * gNodes[nodeId]);
+        }
+        return result * halfRange;
+    }
+
+
+} // namespace detail
+
+
+/// \brief Piecewise cardinal cubic curve, over a contiguous sequence of control points.
+///
+/// Segment i is the CardinalCubic over control points [i, i + 3], so it goes from control point i + 1
+/// to control point i + 2: the first and last control points only define the end tangents.
+///
+/// The spline can be evaluated by its parameter, in [0, segmentCount()] (the integral part being the segment),
+/// or by arc length distance from its start, for constant speed traversal.
+/// The arc length is tabulated at construction, each segment being split in `aArcLengthSubdivisions`
+/// intervals integrated by Gauss-Legendre quadrature.
+template <TMP_D>
+class CardinalSpline
+{
+public:
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Segment_t = CardinalCubic<N_pointDimension, T_number>;
+
+    /// \brief Evaluate the spline at increasing distances, each in amortized constant time.
+    ///
+    /// The cursor keeps the arc length table entry of the previous query, and walks it forward.
+    /// Queries at a decreasing distance are still correct, but fall back to a binary search.
+    /// \attention The cursor refers to the spline, which must outlive it.
+    class Cursor
+    {
+    public:
+        explicit Cursor(const CardinalSpline & aSpline) :
+            mSpline{&aSpline}
+        {}
+
+        T_number getParameterAtDistance(T_number aDistance);
+
+        Position_t evaluateAtDistance(T_number aDistance)
+        { return mSpline->evaluate(getParameterAtDistance(aDistance)); }
+
+    private:
+        const CardinalSpline * mSpline;
+        std::size_t mEntry{0};
+    };
+
+    /// \attention Requires at least 4 control points.
+    CardinalSpline(T_number aTension, std::vector<Position_t> aControlPoints, int aArcLengthSubdivisions = 8);
+
+    std::size_t segmentCount() const
+    { return mControlPoints.size() - 3; }
+
+    Segment_t getSegment(std::size_t aSegmentIndex) const;
+
+    const std::vector<Position_t> & controlPoints() const
+    { return mControlPoints; }
+
+    /// \brief Evaluate the position at `aParameter`, clamped to [0, segmentCount()].
+    Position_t evaluate(T_number aParameter) const;
+
+    /// \brief The tangent vector at `aParameter`, clamped to [0, segmentCount()].
+    Vec<N_pointDimension, T_number> evaluateDerivative(T_number aParameter) const;
+
+    /// \brief Arc length of the complete spline.
+    T_number getLength() const
+    { return mCumulativeLengths.back(); }
+
+    /// \brief The parameter at `aDistance` along the curve from its start, in O(log n).
+    ///
+    /// `aDistance` is clamped to [0, getLength()].
+    T_number getParameterAtDistance(T_number aDistance) const;
+
+    Position_t evaluateAtDistance(T_number aDistance) const
+    { return evaluate(getParameterAtDistance(aDistance)); }
+
+private:
+    /// \brief Split a parameter as the segment index and the local parameter in this segment.
+    std::pair<std::size_t, T_number> locate(T_number aParameter) const;
+
+    /// \brief The entry `e` of the arc length table such that `aDistance` is in [length(e), length(e + 1)].
+    std::size_t findEntry(T_number aDistance) const;
+
+    /// \brief The parameter at `aDistance`, which must be in the interval of the arc length table entry.
+    T_number refineParameter(std::size_t aEntry, T_number aDistance) const;
+
+    T_number mTension;
+    std::vector<Position_t> mControlPoints;
+    int mSubdivisions;
+    /// \brief Entry e is the arc length at parameter (e / mSubdivisions).
+    std::vector<T_number> mCumulativeLengths;
+};
+
+
+//
+// Implementations
+//
+template <TMP>
+CardinalSpline<TMA>::CardinalSpline(T_number aTension,
+                                    std::vector<Position_t> aControlPoints,
+                                    int aArcLengthSubdivisions) :
+    mTension{aTension},
+    mControlPoints{std::move(aControlPoints)},
+    mSubdivisions{aArcLengthSubdivisions}
+{
+    assert(mControlPoints.size() >= 4);
+    assert(mSubdivisions >= 1);
+
+    mCumulativeLengths.reserve(segmentCount() * mSubdivisions + 1);
+    mCumulativeLengths.push_back(T_number{0});
+    for (std::size_t segmentId = 0; segmentId != segmentCount(); ++segmentId)
+    {
+        const Segment_t segment = getSegment(segmentId);
+        auto speed = [&segment](T_number aLocal)
+        {
+            return segment.evaluateDerivative(aLocal).getNorm();
+        };
+
+        for (int intervalId = 0; intervalId != mSubdivisions; ++intervalId)
+        {
+            const T_number low = static_cast<T_number>(intervalId) / mSubdivisions;
+            const T_number high = static_cast<T_number>(intervalId + 1) / mSubdivisions;
+            mCumulativeLengths.push_back(mCumulativeLengths.back()
+                                         + detail::integrateGaussLegendre(speed, low, high));
+        }
+    }
+}
+
+
+template <TMP>
+typename CardinalSpline<TMA>::Segment_t CardinalSpline<TMA>::getSegment(std::size_t aSegmentIndex) const
+{
+    assert(aSegmentIndex < segmentCount());
+    return Segment_t{
+        mTension,
+        mControlPoints[aSegmentIndex],
+        mControlPoints[aSegmentIndex + 1],
+        mControlPoints[aSegmentIndex + 2],
+        mControlPoints[aSegmentIndex + 3],
+    };
+}
+
+
+template <TMP>
+std::pair<std::size_t, T_number> CardinalSpline<TMA>::locate(T_number aParameter) const
+{
+    const T_number clamped = std::clamp(aParameter, T_number{0}, static_cast<T_number>(segmentCount()));
+    // The end of the spline is the end of the last segment.
+    const std::size_t segmentId = std::min(static_cast<std::size_t>(clamped), segmentCount() - 1);
+    return {segmentId, clamped - static_cast<T_number>(segmentId)};
+}
+
+
+template <TMP>
+typename CardinalSpline<TMA>::Position_t CardinalSpline<TMA>::evaluate(T_number aParameter) const
+{
+    auto [segmentId, local] = locate(aParameter);
+    return getSegment(segmentId).evaluate(local);
+}
+
+
+template <TMP>
+Vec<N_pointDimension, T_number> CardinalSpline<TMA>::evaluateDerivative(T_number aParameter) const
+{
+    auto [segmentId, local] = locate(aParameter);
+    return getSegment(segmentId).evaluateDerivative(local);
+}
+
+
+template <TMP>
+std::size_t CardinalSpline<TMA>::findEntry(T_number aDistance) const
+{
+    auto found = std::upper_bound(mCumulativeLengths.begin(), mCumulativeLengths.end(), aDistance);
+    const std::size_t entry = (found == mCumulativeLengths.begin()) ? 0 : (found - mCumulativeLengths.begin() - 1);
+    // The last table entry has no following interval.
+    return std::min(entry, mCumulativeLengths.size() - 2);
+}
+
+
+template <TMP>
+T_number CardinalSpline<TMA>::refineParameter(std::size_t aEntry, T_number aDistance) const
+{
+    const std::size_t segmentId = aEntry / mSubdivisions;
+    const T_number low = static_cast<T_number>(aEntry % mSubdivisions) / mSubdivisions;
+    const T_number high = low + T_number{1} / mSubdivisions;
+    const T_number lowDistance = mCumulativeLengths[aEntry];
+    const T_number intervalLength = mCumulativeLengths[aEntry + 1] - lowDistance;
+
+    if (intervalLength <= T_number{0})
+    {
+        return static_cast<T_number>(segmentId) + low;
+    }
+
+    const Segment_t segment = getSegment(segmentId);
+    auto speed = [&segment](T_number aLocal)
+    {
+        return segment.evaluateDerivative(aLocal).getNorm();
+    };
+
+    // Initial guess assumes constant speed over the interval, then Newton iterations on the arc length.
+    T_number local = low + (aDistance - lowDistance) / intervalLength * (high - low);
+    for (int iteration = 0; iteration != 3; ++iteration)
+    {
+        const T_number error = lowDistance + detail::integrateGaussLegendre(speed, low, local) - aDistance;
+        const T_number currentSpeed = speed(local);
+        if (currentSpeed <= T_number{0})
+        {
+            break;
+        }
+        local = std::clamp(local - error / currentSpeed, low, high);
+    }
+    return static_cast<T_number>(segmentId) + local;
+}
+
+
+template <TMP>
+T_number CardinalSpline<TMA>::getParameterAtDistance(T_number aDistance) const
+{
+    aDistance = std::clamp(aDistance, T_number{0}, getLength());
+    return refineParameter(findEntry(aDistance), aDistance);
+}
+
+
+template <TMP>
+T_number CardinalSpline<TMA>::Cursor::getParameterAtDistance(T_number aDistance)
+{
+    const std::vector<T_number> & lengths = mSpline->mCumulativeLengths;
+    aDistance = std::clamp(aDistance, T_number{0}, mSpline->getLength());
+
+    if (aDistance < lengths[mEntry])
+    {
+        mEntry = mSpline->findEntry(aDistance);
+    }
+    else
+    {
+        while (mEntry + 2 < lengths.size() && lengths[mEntry + 1] <= aDistance)
+        {
+            ++mEntry;
+        }
+    }
+    return mSpline->refineParameter(mEntry, aDistance);
+}
+
+
+#undef TMA
+#undef TMP_D
+#undef TMP
+
+
+} // namespace math
+} // namespace ad
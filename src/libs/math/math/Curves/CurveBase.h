@@ -33,16 +33,16 @@ public:
               std::enable_if_t<sizeof...(T_position) == N_controlPoints, int> = 0>
     constexpr CurveBase(T_position... vaControlPoints);
 
-    Position_t & operator[](std::size_t aIndex);
-    Position_t operator[](std::size_t aIndex) const;
+    constexpr Position_t & operator[](std::size_t aIndex);
+    constexpr Position_t operator[](std::size_t aIndex) const;
 
-    Position_t & start()
+    constexpr Position_t & start()
     { return (*this)[0]; }
-    Position_t start() const
+    constexpr Position_t start() const
     { return (*this)[0]; }
-    Position_t & end()
+    constexpr Position_t & end()
     { return (*this)[N_controlPoints - 1]; }
-    Position_t end() const
+    constexpr Position_t end() const
     { return (*this)[N_controlPoints - 1]; }
 
     constexpr const Position_t * data() const noexcept;
@@ -73,14 +73,14 @@ constexpr CurveBase<TMA>::CurveBase(T_position... vaControlPoints) :
 
 
 template<TMP>
-typename CurveBase<TMA>::Position_t & CurveBase<TMA>::operator[](std::size_t aIndex)
+constexpr typename CurveBase<TMA>::Position_t & CurveBase<TMA>::operator[](std::size_t aIndex)
 {
     return mControlPoints[aIndex];
 }
 
 
 template<TMP>
-typename CurveBase<TMA>::Position_t CurveBase<TMA>::operator[](std::size_t aIndex) const
+constexpr typename CurveBase<TMA>::Position_t CurveBase<TMA>::operator[](std::size_t aIndex) const
 {
     return mControlPoints[aIndex];
 }
@@ -94,7 +94,7 @@ constexpr const typename CurveBase<TMA>::Position_t * CurveBase<TMA>::data() con
 
 
 template <TMP>
-typename CurveBase<TMA>::Position_t evaluate(CurveBase<TMA> aCurve, T_number aParameter)
+constexpr typename CurveBase<TMA>::Position_t evaluate(CurveBase<TMA> aCurve, T_number aParameter)
 {
     // Uses the CurveBase object as storage, hence the copy
     for (std::size_t step = 1; step != N_controlPoints; ++step)
@@ -111,7 +111,7 @@ typename CurveBase<TMA>::Position_t evaluate(CurveBase<TMA> aCurve, T_number aPa
 
 
 template <TMP>
-std::pair<CurveBase<TMA>, CurveBase<TMA>> subdivide(CurveBase<TMA> aCurve, T_number aParameter)
+constexpr std::pair<CurveBase<TMA>, CurveBase<TMA>> subdivide(CurveBase<TMA> aCurve, T_number aParameter)
 {
     // Would be enough to only copy first element, but we cannot make unitialized CurveBase.
     CurveBase<TMA> left = aCurve;
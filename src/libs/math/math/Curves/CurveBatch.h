@@ -0,0 +1,226 @@
+#pragma once
+
+
+#include "Bezier.h"
+#include "CardinalCubic.h"
+#include "CurveBase.h"
+
+#include <array>
+#include <cassert>
+#include <span>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+#define TMP int N_controlPoints, int N_pointDimension, class T_number
+#define TMP_D int N_controlPoints, int N_pointDimension, class T_number = double
+#define TMA N_controlPoints, N_pointDimension, T_number
+
+
+/// \brief Control points of many curves with the same number of control points,
+/// stored as structure of arrays.
+///
+/// Each coordinate of each control point is stored contiguously across all curves.
+/// Curves defined by blending coefficients (Bezier, CardinalCubic with a common tension)
+/// can then be evaluated together: the coefficients are computed once per parameter,
+/// and applied in loops over contiguous coordinates that the compiler can vectorize.
+template <TMP_D>
+class CurveBatch
+{
+public:
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Coefficients_t = Vec<N_controlPoints, T_number>;
+
+    CurveBatch() = default;
+
+    void reserve(std::size_t aCurveCount);
+
+    template <class T_derived>
+    void push_back(const CurveBase<T_derived, TMA> & aCurve);
+
+    void clear();
+
+    std::size_t size() const
+    { return mCoordinates[0].size(); }
+
+    /// \brief The `aDimension` coordinate of control point `aControlIndex`, for all curves.
+    std::span<const T_number> coordinates(int aControlIndex, int aDimension) const
+    { return mCoordinates[aControlIndex * N_pointDimension + aDimension]; }
+
+    /// \brief Write the position of each curve for the given blending coefficients in `aPositions`.
+    void evaluate(const Coefficients_t & aCoefficients, std::span<Position_t> aPositions) const;
+
+    /// \brief Write each coordinate of the position of each curve in the corresponding span of `aCoordinates`.
+    ///
+    /// This structure of arrays output allows contiguous stores.
+    void evaluate(const Coefficients_t & aCoefficients,
+                  const std::array<std::span<T_number>, N_pointDimension> & aCoordinates) const;
+
+private:
+    std::array<std::vector<T_number>, N_controlPoints * N_pointDimension> mCoordinates;
+};
+
+
+/// \brief Evaluate all curves of the batch, as Bezier curves, at each of `aParameters`.
+///
+/// `aPositions` receives `aParameters.size() * aBatch.size()` positions, ordered by parameter first:
+/// position of curve `c` at parameter `p` is at index `p * aBatch.size() + c`.
+template <TMP>
+void evaluateBezier(const CurveBatch<TMA> & aBatch,
+                    std::span<const T_number> aParameters,
+                    std::span<Position<N_pointDimension, T_number>> aPositions);
+
+
+/// \brief Evaluate all curves of the batch, as cardinal cubics with `aTension`, at each of `aParameters`.
+///
+/// `aPositions` layout is the same as for evaluateBezier().
+template <int N_pointDimension, class T_number>
+void evaluateCardinal(const CurveBatch<4, N_pointDimension, T_number> & aBatch,
+                      T_number aTension,
+                      std::span<const T_number> aParameters,
+                      std::span<Position<N_pointDimension, T_number>> aPositions);
+
+
+//
+// Implementations
+//
+template <TMP>
+void CurveBatch<TMA>::reserve(std::size_t aCurveCount)
+{
+    for (std::vector<T_number> & coordinates : mCoordinates)
+    {
+        coordinates.reserve(aCurveCount);
+    }
+}
+
+
+template <TMP>
+template <class T_derived>
+void CurveBatch<TMA>::push_back(const CurveBase<T_derived, TMA> & aCurve)
+{
+    for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+    {
+        const Position_t controlPoint = aCurve[controlId];
+        for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+        {
+            mCoordinates[controlId * N_pointDimension + dimension].push_back(controlPoint[dimension]);
+        }
+    }
+}
+
+
+template <TMP>
+void CurveBatch<TMA>::clear()
+{
+    for (std::vector<T_number> & coordinates : mCoordinates)
+    {
+        coordinates.clear();
+    }
+}
+
+
+template <TMP>
+void CurveBatch<TMA>::evaluate(const Coefficients_t & aCoefficients, std::span<Position_t> aPositions) const
+{
+    assert(aPositions.size() == size());
+
+    std::array<T_number, N_controlPoints> coefficients;
+    for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+    {
+        coefficients[controlId] = aCoefficients[controlId];
+    }
+
+    for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+    {
+        std::array<const T_number *, N_controlPoints> sources;
+        for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+        {
+            sources[controlId] = mCoordinates[controlId * N_pointDimension + dimension].data();
+        }
+
+        for (std::size_t curveId = 0; curveId != aPositions.size(); ++curveId)
+        {
+            T_number accumulated{0};
+            for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+            {
+                accumulated += coefficients[controlId] * sources[controlId][curveId];
+            }
+            aPositions[curveId][dimension] = accumulated;
+        }
+    }
+}
+
+
+template <TMP>
+void CurveBatch<TMA>::evaluate(const Coefficients_t & aCoefficients,
+                               const std::array<std::span<T_number>, N_pointDimension> & aCoordinates) const
+{
+    std::array<T_number, N_controlPoints> coefficients;
+    for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+    {
+        coefficients[controlId] = aCoefficients[controlId];
+    }
+
+    for (int dimension = 0; dimension != N_pointDimension; ++dimension)
+    {
+        assert(aCoordinates[dimension].size() == size());
+        T_number * destination = aCoordinates[dimension].data();
+
+        // Accumulate one control point at a time, each pass is a contiguous multiply-add over all curves.
+        const T_number * source = mCoordinates[dimension].data();
+        for (std::size_t curveId = 0; curveId != size(); ++curveId)
+        {
+            destination[curveId] = coefficients[0] * source[curveId];
+        }
+        for (int controlId = 1; controlId != N_controlPoints; ++controlId)
+        {
+            source = mCoordinates[controlId * N_pointDimension + dimension].data();
+            const T_number coefficient = coefficients[controlId];
+            for (std::size_t curveId = 0; curveId != size(); ++curveId)
+            {
+                destination[curveId] += coefficient * source[curveId];
+            }
+        }
+    }
+}
+
+
+template <TMP>
+void evaluateBezier(const CurveBatch<TMA> & aBatch,
+                    std::span<const T_number> aParameters,
+                    std::span<Position<N_pointDimension, T_number>> aPositions)
+{
+    assert(aPositions.size() == aParameters.size() * aBatch.size());
+    for (std::size_t parameterId = 0; parameterId != aParameters.size(); ++parameterId)
+    {
+        aBatch.evaluate(getBernsteinCoefficients<N_controlPoints>(aParameters[parameterId]),
+                        aPositions.subspan(parameterId * aBatch.size(), aBatch.size()));
+    }
+}
+
+
+template <int N_pointDimension, class T_number>
+void evaluateCardinal(const CurveBatch<4, N_pointDimension, T_number> & aBatch,
+                      T_number aTension,
+                      std::span<const T_number> aParameters,
+                      std::span<Position<N_pointDimension, T_number>> aPositions)
+{
+    assert(aPositions.size() == aParameters.size() * aBatch.size());
+    for (std::size_t parameterId = 0; parameterId != aParameters.size(); ++parameterId)
+    {
+        aBatch.evaluate(getCardinalBlendingCoefficients(aTension, aParameters[parameterId]),
+                        aPositions.subspan(parameterId * aBatch.size(), aBatch.size()));
+    }
+}
+
+
+#undef TMA
+#undef TMP_D
+#undef TMP
+
+
+} // namespace math
+} // namespace ad
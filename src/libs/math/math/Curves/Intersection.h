@@ -0,0 +1,763 @@
+#pragma once
+
+
+#include "Bezier.h"
+#include "Projection.h"
+
+#include "../Utilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+// Intersection of planar Bezier curves, by Bezier clipping.
+//
+// The algorithm relies on the convex hull property: a Bezier curve is contained in the convex hull
+// of its control points. Each iteration clips the parameter interval of one curve to the part
+// where its control polygon hull intersects the "fat line" bounding the other curve,
+// then restricts the curve to this interval with subdivide().
+// When clipping does not make enough progress (e.g. several intersections), the curves are halved.
+// Overlapping curves stall at any depth: they are detected once a piece lies close to the other one.
+// Pending pairs of curves are processed from a fixed size stack, without recursion nor allocation
+// (except for the returned results, and the detected overlaps).
+//
+// \see Sederberg & Nishita, Curve intersection using Bezier clipping, 1990
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Parameters of an intersection, on the first and on the second intersected primitives.
+template <class T_number>
+struct IntersectionParameters
+{
+    bool operator==(const IntersectionParameters & aRhs) const
+    { return mOnFirst == aRhs.mOnFirst && mOnSecond == aRhs.mOnSecond; }
+    bool operator!=(const IntersectionParameters & aRhs) const
+    { return !(*this == aRhs); }
+
+    T_number mOnFirst;
+    T_number mOnSecond;
+};
+
+
+/// \brief Intersections of two planar Bezier curves, sorted by parameter on `aFirst`.
+///
+/// Each intersection is located within `aTolerance` in the parameter space of both curves.
+/// Intersections closer than this tolerance are merged.
+/// \note The tolerance is at least 64 times the machine epsilon of `T_number`.
+/// \attention Overlapping curves are reported by the two ends of each overlap.
+/// Pieces of the curves are considered to overlap once one lies within `aTolerance` times the length
+/// of the longest control polygon from the other, so tangent curves which are this close around the tangency
+/// are also reported by the two ends of this neighbourhood.
+template <int N_firstControlPoints, int N_secondControlPoints, class T_number>
+std::vector<IntersectionParameters<T_number>>
+intersect(const Bezier<N_firstControlPoints, 2, T_number> & aFirst,
+          const Bezier<N_secondControlPoints, 2, T_number> & aSecond,
+          T_number aTolerance);
+
+
+/// \brief Intersections of a planar Bezier curve with the ray starting at `aOrigin`, along `aDirection`.
+///
+/// `mOnFirst` is the parameter on the curve, and `mOnSecond` the parameter `s` along the ray,
+/// so the intersection is at `aOrigin + s * aDirection`, with `s >= 0`.
+/// The intersections are sorted by parameter on the curve, which is located within `aTolerance`.
+/// \attention A curve lying on the ray line (all its control points within `aTolerance` times the length
+/// of its control polygon from the line) is not intersected by the ray: no intersections are returned.
+template <int N_controlPoints, class T_number>
+std::vector<IntersectionParameters<T_number>>
+intersectRay(const Bezier<N_controlPoints, 2, T_number> & aBezier,
+             Position<2, T_number> aOrigin,
+             Vec<2, T_number> aDirection,
+             T_number aTolerance);
+
+
+//
+// Implementations
+//
+namespace detail {
+
+
+    /// \brief Parameter interval where the convex hull of the points (i / degree, aValues[i])
+    /// is within [aLow, aHigh].
+    ///
+    /// Each vertex of the intersection of the hull with the band is either a hull vertex within the band,
+    /// or the crossing of a band bound by a hull edge. Hull edges being segments between pairs of points,
+    /// testing all pairs is exact (and cheap, for the low degrees of practical curves).
+    template <class T_number, std::size_t N_size>
+    std::optional<std::pair<T_number, T_number>>
+    clipHullToBand(const std::array<T_number, N_size> & aValues, T_number aLow, T_number aHigh)
+    {
+        constexpr T_number degree = static_cast<T_number>(N_size - 1);
+        T_number low{2};
+        T_number high{-1};
+        auto include = [&](T_number aParameter)
+        {
+            low = std::min(low, aParameter);
+            high = std::max(high, aParameter);
+        };
+
+        for (std::size_t i = 0; i != N_size; ++i)
+        {
+            if (aValues[i] >= aLow && aValues[i] <= aHigh)
+            {
+                include(i / degree);
+            }
+            for (std::size_t j = i + 1; j != N_size; ++j)
+            {
+                for (T_number bound : {aLow, aHigh})
+                {
+                    if ((aValues[i] - bound) * (aValues[j] - bound) < T_number{0})
+                    {
+                        const T_number ratio = (bound - aValues[i]) / (aValues[j] - aValues[i]);
+                        include((i + ratio * (j - i)) / degree);
+                    }
+                }
+            }
+        }
+
+        if (low > high)
+        {
+            return std::nullopt;
+        }
+        return std::pair{std::clamp(low, T_number{0}, T_number{1}), std::clamp(high, T_number{0}, T_number{1})};
+    }
+
+
+    /// \brief The part of `aBezier` over the parameter interval [aLow, aHigh] (included in [0, 1]).
+    template <int N_controlPoints, class T_number>
+    Bezier<N_controlPoints, 2, T_number> restrictTo(Bezier<N_controlPoints, 2, T_number> aBezier,
+                                                    T_number aLow,
+                                                    T_number aHigh)
+    {
+        if (aHigh < T_number{1})
+        {
+            aBezier = subdivide(aBezier, aHigh).first;
+        }
+        if (aLow > T_number{0})
+        {
+            aBezier = subdivide(aBezier, aLow / aHigh).second;
+        }
+        return aBezier;
+    }
+
+
+    /// \brief Unit normal of the line best approximating the curve, for its fat line.
+    ///
+    /// It is normal to the chord, or to the farthest control point if the endpoints coincide.
+    /// Any direction would bound the curve, the choice only affects how tight the bounds are.
+    /// \return A null vector if the curve is reduced to a point.
+    template <int N_controlPoints, class T_number>
+    Vec<2, T_number> getFatLineNormal(const Bezier<N_controlPoints, 2, T_number> & aBezier)
+    {
+        Vec<2, T_number> direction = aBezier.end() - aBezier.start();
+        for (int controlId = 1; controlId != N_controlPoints - 1; ++controlId)
+        {
+            if (direction.getNormSquared() > T_number{0})
+            {
+                break;
+            }
+            direction = aBezier[controlId] - aBezier.start();
+        }
+
+        const T_number norm = direction.getNorm();
+        if (norm == T_number{0})
+        {
+            return Vec<2, T_number>::Zero();
+        }
+        return Vec<2, T_number>{-direction.y(), direction.x()} / norm;
+    }
+
+
+    /// \brief Signed distances of the control points of `aBezier` to the line through `aOrigin`.
+    template <int N_controlPoints, class T_number>
+    std::array<T_number, N_controlPoints> getSignedDistances(const Bezier<N_controlPoints, 2, T_number> & aBezier,
+                                                             Position<2, T_number> aOrigin,
+                                                             Vec<2, T_number> aNormal)
+    {
+        std::array<T_number, N_controlPoints> distances;
+        for (int controlId = 0; controlId != N_controlPoints; ++controlId)
+        {
+            distances[controlId] = aNormal.dot(aBezier[controlId] - aOrigin);
+        }
+        return distances;
+    }
+
+
+    /// \brief Clip `aClipped` to the fat line of `aReference`.
+    ///
+    /// \return The local parameter interval of `aClipped` which might intersect `aReference`,
+    /// or nothing if they cannot intersect.
+    template <int N_clippedControlPoints, int N_referenceControlPoints, class T_number>
+    std::optional<std::pair<T_number, T_number>>
+    clipToFatLine(const Bezier<N_clippedControlPoints, 2, T_number> & aClipped,
+                  const Bezier<N_referenceControlPoints, 2, T_number> & aReference)
+    {
+        Vec<2, T_number> normal = getFatLineNormal(aReference);
+        if (normal == Vec<2, T_number>::Zero())
+        {
+            // The reference is a point (e.g. clipped to an intersection at a control point):
+            // the line through it across the clipped curve is the most selective.
+            normal = getFatLineNormal(aClipped);
+            normal = normal == Vec<2, T_number>::Zero() ? Vec<2, T_number>{T_number{0}, T_number{1}}
+                                                        : Vec<2, T_number>{normal.y(), -normal.x()};
+        }
+        const auto referenceDistances = getSignedDistances(aReference, aReference.start(), normal);
+        const auto [low, high] = std::minmax_element(referenceDistances.begin(), referenceDistances.end());
+        // The band is widened by the rounding errors on the distances, so that it cannot miss
+        // an intersection once the pieces are as small as these errors.
+        T_number magnitude = std::max(std::abs(aReference.start().x()), std::abs(aReference.start().y()));
+        for (int controlId = 0; controlId != N_clippedControlPoints; ++controlId)
+        {
+            magnitude = std::max({magnitude, std::abs(aClipped[controlId].x()), std::abs(aClipped[controlId].y())});
+        }
+        const T_number rounding = 8 * std::numeric_limits<T_number>::epsilon() * magnitude;
+        return clipHullToBand(getSignedDistances(aClipped, aReference.start(), normal),
+                              *low - rounding, *high + rounding);
+    }
+
+
+    /// \brief Length of the control polygon, an upper bound of the curve length.
+    template <int N_controlPoints, class T_number>
+    T_number getControlPolygonLength(const Bezier<N_controlPoints, 2, T_number> & aBezier)
+    {
+        T_number length{0};
+        for (int controlId = 1; controlId != N_controlPoints; ++controlId)
+        {
+            length += (aBezier[controlId] - aBezier[controlId - 1]).getNorm();
+        }
+        return length;
+    }
+
+
+    /// \brief When both curves lie within `aDistance` of a common line, the ends of the part of this line
+    /// where they overlap.
+    ///
+    /// The ends are given as local parameters on both curves, found by Newton iterations on the position
+    /// of the curves along the line (starting from the linear interpolation along their chords).
+    /// Curves only touching along the line have both ends at the contact.
+    /// \return Nothing if the curves are not within `aDistance` of a common line, or are both points.
+    template <int N_firstControlPoints, int N_secondControlPoints, class T_number>
+    std::optional<std::pair<IntersectionParameters<T_number>, IntersectionParameters<T_number>>>
+    getCollinearOverlap(const Bezier<N_firstControlPoints, 2, T_number> & aFirst,
+                        const Bezier<N_secondControlPoints, 2, T_number> & aSecond,
+                        T_number aDistance)
+    {
+        Position<2, T_number> origin = aSecond.start();
+        Vec<2, T_number> normal = getFatLineNormal(aSecond);
+        if (normal == Vec<2, T_number>::Zero())
+        {
+            origin = aFirst.start();
+            normal = getFatLineNormal(aFirst);
+            if (normal == Vec<2, T_number>::Zero())
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto isNear = [aDistance](T_number aSignedDistance)
+        {
+            return std::abs(aSignedDistance) <= aDistance;
+        };
+        const auto firstDistances = getSignedDistances(aFirst, origin, normal);
+        const auto secondDistances = getSignedDistances(aSecond, origin, normal);
+        if (!std::all_of(firstDistances.begin(), firstDistances.end(), isNear)
+            || !std::all_of(secondDistances.begin(), secondDistances.end(), isNear))
+        {
+            return std::nullopt;
+        }
+
+        const Vec<2, T_number> direction{normal.y(), -normal.x()};
+        auto along = [&](Position<2, T_number> aPosition)
+        {
+            return direction.dot(aPosition - origin);
+        };
+
+        const T_number firstStart = along(aFirst.start());
+        const T_number firstEnd = along(aFirst.end());
+        const T_number secondStart = along(aSecond.start());
+        const T_number secondEnd = along(aSecond.end());
+        T_number low = std::max(std::min(firstStart, firstEnd), std::min(secondStart, secondEnd));
+        T_number high = std::min(std::max(firstStart, firstEnd), std::max(secondStart, secondEnd));
+        if (low > high)
+        {
+            low = high = (low + high) / 2;
+        }
+
+        auto parameterAt = [&](const auto & aBezier, T_number aStart, T_number aEnd, T_number aAlong)
+        {
+            T_number parameter = (aStart == aEnd) ? T_number{0.5}
+                                                  : std::clamp((aAlong - aStart) / (aEnd - aStart),
+                                                               T_number{0}, T_number{1});
+            for (int iteration = 0; iteration != 4; ++iteration)
+            {
+                const T_number slope = direction.dot(evaluateDerivative(aBezier, parameter));
+                if (slope == T_number{0})
+                {
+                    break;
+                }
+                parameter = std::clamp(parameter - (along(evaluate(aBezier, parameter)) - aAlong) / slope,
+                                       T_number{0}, T_number{1});
+            }
+            return parameter;
+        };
+
+        return std::pair{
+            IntersectionParameters<T_number>{parameterAt(aFirst, firstStart, firstEnd, low),
+                                             parameterAt(aSecond, secondStart, secondEnd, low)},
+            IntersectionParameters<T_number>{parameterAt(aFirst, firstStart, firstEnd, high),
+                                             parameterAt(aSecond, secondStart, secondEnd, high)},
+        };
+    }
+
+
+    /// \brief When one curve lies within `aDistance` of the other, the ends of the contained curve,
+    /// as local parameters on both curves.
+    ///
+    /// The contained curve is compared at a few positions evenly spaced in parameter,
+    /// projected on the other curve.
+    /// \return Nothing if neither curve lies within `aDistance` of the other.
+    template <int N_firstControlPoints, int N_secondControlPoints, class T_number>
+    std::optional<std::pair<IntersectionParameters<T_number>, IntersectionParameters<T_number>>>
+    getContainedOverlap(const Bezier<N_firstControlPoints, 2, T_number> & aFirst,
+                        const Bezier<N_secondControlPoints, 2, T_number> & aSecond,
+                        T_number aDistance)
+    {
+        constexpr int samples = 2 * std::max(N_firstControlPoints, N_secondControlPoints);
+
+        auto isContained = [aDistance](const auto & aContained, const auto & aProjector)
+        {
+            for (int sampleId = 0; sampleId != samples; ++sampleId)
+            {
+                const T_number parameter = sampleId / static_cast<T_number>(samples - 1);
+                if (aProjector.project(evaluate(aContained, parameter)).mDistanceSquared > aDistance * aDistance)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        const BezierProjector<N_firstControlPoints, 2, T_number> firstProjector{aFirst};
+        if (isContained(aSecond, firstProjector))
+        {
+            return std::pair{
+                IntersectionParameters<T_number>{firstProjector.project(aSecond.start()).mParameter, T_number{0}},
+                IntersectionParameters<T_number>{firstProjector.project(aSecond.end()).mParameter, T_number{1}},
+            };
+        }
+        const BezierProjector<N_secondControlPoints, 2, T_number> secondProjector{aSecond};
+        if (isContained(aFirst, secondProjector))
+        {
+            return std::pair{
+                IntersectionParameters<T_number>{T_number{0}, secondProjector.project(aFirst.start()).mParameter},
+                IntersectionParameters<T_number>{T_number{1}, secondProjector.project(aFirst.end()).mParameter},
+            };
+        }
+        return std::nullopt;
+    }
+
+
+    /// \brief Whether the axis aligned bounds of the control points overlap.
+    template <int N_firstControlPoints, int N_secondControlPoints, class T_number>
+    bool overlapControlBounds(const Bezier<N_firstControlPoints, 2, T_number> & aFirst,
+                              const Bezier<N_secondControlPoints, 2, T_number> & aSecond)
+    {
+        auto bounds = [](const auto & aBezier)
+        {
+            Position<2, T_number> low = aBezier.start();
+            Position<2, T_number> high = aBezier.start();
+            for (int controlId = 1; controlId != std::decay_t<decltype(aBezier)>::size_v; ++controlId)
+            {
+                low = min(low, aBezier[controlId]);
+                high = max(high, aBezier[controlId]);
+            }
+            return std::pair{low, high};
+        };
+        const auto [firstLow, firstHigh] = bounds(aFirst);
+        const auto [secondLow, secondHigh] = bounds(aSecond);
+        return firstLow.x() <= secondHigh.x() && secondLow.x() <= firstHigh.x()
+            && firstLow.y() <= secondHigh.y() && secondLow.y() <= firstHigh.y();
+    }
+
+
+    /// \brief Sort `aIntersections` by parameter on the first primitive, and merge the ones closer than `aTolerance`.
+    template <class T_number>
+    void sortAndMerge(std::vector<IntersectionParameters<T_number>> & aIntersections, T_number aTolerance)
+    {
+        std::sort(aIntersections.begin(), aIntersections.end(),
+                  [](const auto & aLhs, const auto & aRhs)
+                  {
+                      return std::tie(aLhs.mOnFirst, aLhs.mOnSecond) < std::tie(aRhs.mOnFirst, aRhs.mOnSecond);
+                  });
+        auto last = std::unique(aIntersections.begin(), aIntersections.end(),
+                                [aTolerance](const auto & aLhs, const auto & aRhs)
+                                {
+                                    return std::abs(aLhs.mOnFirst - aRhs.mOnFirst) <= aTolerance
+                                        && std::abs(aLhs.mOnSecond - aRhs.mOnSecond) <= aTolerance;
+                                });
+        aIntersections.erase(last, aIntersections.end());
+    }
+
+
+    /// \brief Merge the overlaps found on pieces into continuous overlaps, whose ends are added to `aIntersections`.
+    ///
+    /// The intersections within a continuous overlap are removed.
+    /// \note Assumes the second curve does not overlap itself, overlaps are chained along the first curve.
+    template <class T_number>
+    void addOverlaps(std::vector<IntersectionParameters<T_number>> & aIntersections,
+                     std::vector<std::pair<IntersectionParameters<T_number>, IntersectionParameters<T_number>>> aOverlaps,
+                     T_number aTolerance)
+    {
+        for (auto & [start, end] : aOverlaps)
+        {
+            if (start.mOnFirst > end.mOnFirst)
+            {
+                std::swap(start, end);
+            }
+        }
+        std::sort(aOverlaps.begin(), aOverlaps.end(),
+                  [](const auto & aLhs, const auto & aRhs)
+                  {
+                      return aLhs.first.mOnFirst < aRhs.first.mOnFirst;
+                  });
+
+        std::vector<std::pair<IntersectionParameters<T_number>, IntersectionParameters<T_number>>> merged;
+        for (const auto & overlap : aOverlaps)
+        {
+            if (!merged.empty() && overlap.first.mOnFirst <= merged.back().second.mOnFirst + aTolerance)
+            {
+                if (overlap.second.mOnFirst > merged.back().second.mOnFirst)
+                {
+                    merged.back().second = overlap.second;
+                }
+            }
+            else
+            {
+                merged.push_back(overlap);
+            }
+        }
+
+        for (const auto & [start, end] : merged)
+        {
+            const auto [secondLow, secondHigh] = std::minmax(start.mOnSecond, end.mOnSecond);
+            std::erase_if(aIntersections,
+                          [&, start = start, end = end](const auto & aIntersection)
+                          {
+                              return aIntersection.mOnFirst >= start.mOnFirst - aTolerance
+                                  && aIntersection.mOnFirst <= end.mOnFirst + aTolerance
+                                  && aIntersection.mOnSecond >= secondLow - aTolerance
+                                  && aIntersection.mOnSecond <= secondHigh + aTolerance;
+                          });
+        }
+        for (const auto & [start, end] : merged)
+        {
+            aIntersections.push_back(start);
+            aIntersections.push_back(end);
+        }
+    }
+
+
+    /// \brief Depth of halving after which a pending pair is reported as an intersection.
+    ///
+    /// It is only reached by (almost) overlapping curves, or intersections closer than 2^-gMaxDepth.
+    constexpr int gMaxIntersectionDepth = 20;
+
+    /// \brief Number of successive clippings of a pending pair, before it is reported as an intersection.
+    ///
+    /// Clipping converges quadratically for transversal intersections, this is only reached by tangencies.
+    constexpr int gMaxClippings = 64;
+
+    /// \brief Clipping is considered to stall when it keeps more than this ratio of the interval.
+    template <class T_number>
+    constexpr T_number gStallingRatio = T_number{0.8};
+
+
+} // namespace detail
+
+
+template <int N_firstControlPoints, int N_secondControlPoints, class T_number>
+std::vector<IntersectionParameters<T_number>>
+intersect(const Bezier<N_firstControlPoints, 2, T_number> & aFirst,
+          const Bezier<N_secondControlPoints, 2, T_number> & aSecond,
+          T_number aTolerance)
+{
+    struct Pending
+    {
+        Bezier<N_firstControlPoints, 2, T_number> first;
+        Bezier<N_secondControlPoints, 2, T_number> second;
+        // Parameter intervals of the pending pieces, on the original curves.
+        T_number firstLow, firstHigh;
+        T_number secondLow, secondHigh;
+        int depth;
+    };
+
+    // Below this, the rounding errors on the clipped intervals exceed the tolerance.
+    aTolerance = std::max(aTolerance, 64 * std::numeric_limits<T_number>::epsilon());
+
+    std::vector<IntersectionParameters<T_number>> result;
+    std::vector<std::pair<IntersectionParameters<T_number>, IntersectionParameters<T_number>>> overlaps;
+
+    // Overlapping pieces never stop stalling, they are detected when they are close to each other.
+    const T_number overlapDistance = aTolerance * std::max(detail::getControlPolygonLength(aFirst),
+                                                           detail::getControlPolygonLength(aSecond));
+
+    // Each halving pops a pair and pushes two, so the stack grows by at most one per depth level.
+    auto stack = makeFilledArray<detail::gMaxIntersectionDepth + 1>(
+        Pending{aFirst, aSecond, T_number{0}, T_number{1}, T_number{0}, T_number{1}, 0});
+    std::size_t stackSize = 1;
+
+    while (stackSize != 0)
+    {
+        Pending pending = stack[--stackSize];
+
+        auto report = [&]()
+        {
+            result.push_back({(pending.firstLow + pending.firstHigh) / 2,
+                              (pending.secondLow + pending.secondHigh) / 2});
+        };
+
+        for (int clipping = 0; /* exits from the body */; ++clipping)
+        {
+            if (!detail::overlapControlBounds(pending.first, pending.second))
+            {
+                break;
+            }
+
+            if ((pending.firstHigh - pending.firstLow) <= aTolerance
+                && (pending.secondHigh - pending.secondLow) <= aTolerance)
+            {
+                report();
+                break;
+            }
+
+            if (clipping == detail::gMaxClippings)
+            {
+                report();
+                break;
+            }
+
+            auto firstClip = detail::clipToFatLine(pending.first, pending.second);
+            if (!firstClip)
+            {
+                break;
+            }
+            auto [firstLocalLow, firstLocalHigh] = *firstClip;
+            pending.first = detail::restrictTo(pending.first, firstLocalLow, firstLocalHigh);
+            const T_number firstWidth = pending.firstHigh - pending.firstLow;
+            pending.firstHigh = pending.firstLow + firstLocalHigh * firstWidth;
+            pending.firstLow = pending.firstLow + firstLocalLow * firstWidth;
+
+            auto secondClip = detail::clipToFatLine(pending.second, pending.first);
+            if (!secondClip)
+            {
+                break;
+            }
+            auto [secondLocalLow, secondLocalHigh] = *secondClip;
+            pending.second = detail::restrictTo(pending.second, secondLocalLow, secondLocalHigh);
+            const T_number secondWidth = pending.secondHigh - pending.secondLow;
+            pending.secondHigh = pending.secondLow + secondLocalHigh * secondWidth;
+            pending.secondLow = pending.secondLow + secondLocalLow * secondWidth;
+
+            if (firstLocalHigh - firstLocalLow > detail::gStallingRatio<T_number>
+                && secondLocalHigh - secondLocalLow > detail::gStallingRatio<T_number>)
+            {
+                // At the maximal depth, the pieces are considered to overlap along the line of the second one.
+                const bool isMaxDepth = (pending.depth == detail::gMaxIntersectionDepth);
+                auto overlap = detail::getCollinearOverlap(
+                    pending.first, pending.second,
+                    isMaxDepth ? std::numeric_limits<T_number>::infinity() : overlapDistance);
+                if (!overlap && !isMaxDepth)
+                {
+                    overlap = detail::getContainedOverlap(pending.first, pending.second, overlapDistance);
+                }
+                if (overlap)
+                {
+                    auto toCurves = [&](IntersectionParameters<T_number> aLocal)
+                    {
+                        return IntersectionParameters<T_number>{
+                            pending.firstLow + aLocal.mOnFirst * (pending.firstHigh - pending.firstLow),
+                            pending.secondLow + aLocal.mOnSecond * (pending.secondHigh - pending.secondLow),
+                        };
+                    };
+                    const IntersectionParameters<T_number> start = toCurves(overlap->first);
+                    const IntersectionParameters<T_number> end = toCurves(overlap->second);
+                    if (std::abs(end.mOnFirst - start.mOnFirst) <= aTolerance
+                        && std::abs(end.mOnSecond - start.mOnSecond) <= aTolerance)
+                    {
+                        result.push_back({(start.mOnFirst + end.mOnFirst) / 2, (start.mOnSecond + end.mOnSecond) / 2});
+                    }
+                    else
+                    {
+                        overlaps.push_back({start, end});
+                    }
+                    break;
+                }
+
+                if (isMaxDepth)
+                {
+                    report();
+                    break;
+                }
+
+                // Halve the piece with the widest parameter interval.
+                Pending low = pending;
+                Pending high = pending;
+                low.depth = high.depth = pending.depth + 1;
+                if (pending.firstHigh - pending.firstLow >= pending.secondHigh - pending.secondLow)
+                {
+                    std::tie(low.first, high.first) = subdivide(pending.first, T_number{0.5});
+                    low.firstHigh = high.firstLow = (pending.firstLow + pending.firstHigh) / 2;
+                }
+                else
+                {
+                    std::tie(low.second, high.second) = subdivide(pending.second, T_number{0.5});
+                    low.secondHigh = high.secondLow = (pending.secondLow + pending.secondHigh) / 2;
+                }
+                stack[stackSize++] = high;
+                stack[stackSize++] = low;
+                break;
+            }
+        }
+    }
+
+    detail::addOverlaps(result, std::move(overlaps), aTolerance);
+    detail::sortAndMerge(result, aTolerance);
+    return result;
+}
+
+
+template <int N_controlPoints, class T_number>
+std::vector<IntersectionParameters<T_number>>
+intersectRay(const Bezier<N_controlPoints, 2, T_number> & aBezier,
+             Position<2, T_number> aOrigin,
+             Vec<2, T_number> aDirection,
+             T_number aTolerance)
+{
+    // The signed distance of the curve to the ray line is the explicit (1D) Bezier function
+    // whose control values are the distances of the control points.
+    // Its roots are found by clipping its control polygon hull to the zero band.
+    using Distances_t = std::array<T_number, N_controlPoints>;
+
+    struct Pending
+    {
+        Distances_t distances;
+        T_number low, high;
+        int depth;
+    };
+
+    auto subdivideDistances = [](Distances_t aDistances, T_number aParameter)
+    {
+        Distances_t left = aDistances;
+        for (std::size_t step = 1; step != N_controlPoints; ++step)
+        {
+            left[step] = left[step - 1] + aParameter * (aDistances[1] - left[step - 1]);
+            for (std::size_t valueId = 1; valueId != N_controlPoints - step; ++valueId)
+            {
+                aDistances[valueId] = aDistances[valueId] + aParameter * (aDistances[valueId + 1] - aDistances[valueId]);
+            }
+        }
+        aDistances[0] = left[N_controlPoints - 1];
+        return std::pair{left, aDistances};
+    };
+
+    auto restrictDistances = [&](Distances_t aDistances, T_number aLow, T_number aHigh)
+    {
+        if (aHigh < T_number{1})
+        {
+            aDistances = subdivideDistances(aDistances, aHigh).first;
+        }
+        if (aLow > T_number{0})
+        {
+            aDistances = subdivideDistances(aDistances, aLow / aHigh).second;
+        }
+        return aDistances;
+    };
+
+    std::vector<IntersectionParameters<T_number>> result;
+    const T_number directionSquared = aDirection.getNormSquared();
+    if (directionSquared == T_number{0})
+    {
+        return result;
+    }
+
+    auto report = [&](T_number aParameter)
+    {
+        const T_number alongRay = aDirection.dot(evaluate(aBezier, aParameter) - aOrigin) / directionSquared;
+        if (alongRay >= T_number{0})
+        {
+            result.push_back({aParameter, alongRay});
+        }
+    };
+
+    const Vec<2, T_number> normal =
+        Vec<2, T_number>{-aDirection.y(), aDirection.x()} / std::sqrt(directionSquared);
+
+    const Distances_t distances = detail::getSignedDistances(aBezier, aOrigin, normal);
+
+    // A curve on the ray line has all its distances null, so clipping would never shrink the interval.
+    const T_number polygonLength = detail::getControlPolygonLength(aBezier);
+    if (std::all_of(distances.begin(), distances.end(),
+                    [&](T_number aDistance){ return std::abs(aDistance) <= aTolerance * polygonLength; }))
+    {
+        return result;
+    }
+
+    std::array<Pending, detail::gMaxIntersectionDepth + 1> stack;
+    stack[0] = Pending{distances, T_number{0}, T_number{1}, 0};
+    std::size_t stackSize = 1;
+
+    while (stackSize != 0)
+    {
+        Pending pending = stack[--stackSize];
+
+        for (int clipping = 0; /* exits from the body */; ++clipping)
+        {
+            if (pending.high - pending.low <= aTolerance || clipping == detail::gMaxClippings)
+            {
+                report((pending.low + pending.high) / 2);
+                break;
+            }
+
+            auto clip = detail::clipHullToBand(pending.distances, T_number{0}, T_number{0});
+            if (!clip)
+            {
+                break;
+            }
+            auto [localLow, localHigh] = *clip;
+            pending.distances = restrictDistances(pending.distances, localLow, localHigh);
+            const T_number width = pending.high - pending.low;
+            pending.high = pending.low + localHigh * width;
+            pending.low = pending.low + localLow * width;
+
+            if (localHigh - localLow > detail::gStallingRatio<T_number>)
+            {
+                if (pending.depth == detail::gMaxIntersectionDepth)
+                {
+                    report((pending.low + pending.high) / 2);
+                    break;
+                }
+
+                auto [lowDistances, highDistances] = subdivideDistances(pending.distances, T_number{0.5});
+                const T_number middle = (pending.low + pending.high) / 2;
+                stack[stackSize++] = Pending{highDistances, middle, pending.high, pending.depth + 1};
+                stack[stackSize++] = Pending{lowDistances, pending.low, middle, pending.depth + 1};
+                break;
+            }
+        }
+    }
+
+    detail::sortAndMerge(result, aTolerance);
+    return result;
+}
+
+
+} // namespace math
+} // namespace ad
@@ -0,0 +1,219 @@
+#pragma once
+
+
+#include "Bezier.h"
+#include "CardinalCubic.h"
+
+#include "../Utilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+
+
+namespace ad {
+namespace math {
+
+
+#define TMP int N_controlPoints, int N_pointDimension, class T_number
+#define TMA N_controlPoints, N_pointDimension, T_number
+
+
+/// \brief The closest point on a curve, with its parameter and squared distance to the projected position.
+template <int N_pointDimension, class T_number = real_number>
+struct CurveProjection
+{
+    T_number mParameter;
+    Position<N_pointDimension, T_number> mPosition;
+    T_number mDistanceSquared;
+};
+
+
+/// \brief Project positions on a Bezier curve, i.e. find the closest point on the curve.
+///
+/// The projector caches a table of `N_samples` positions evenly spaced in parameter space,
+/// and the power basis coefficients of the curve.
+/// Each projection is seeded by the closest sample, then refined by Halley iterations
+/// on the derivative of the squared distance, using the analytic derivatives of the curve.
+///
+/// \note The refinement converges to the local minimum near the closest sample.
+/// Increase `N_samples` for curves with features smaller than the sample spacing
+/// (e.g. tight loops), where the closest sample might be in the basin of another local minimum.
+template <int N_controlPoints, int N_pointDimension, class T_number = double, int N_samples = 16>
+class BezierProjector
+{
+    static_assert(N_samples >= 2, "The sample table must at least contain the curve endpoints.");
+
+public:
+    using Bezier_t = Bezier<TMA>;
+    using Position_t = Position<N_pointDimension, T_number>;
+    using Projection_t = CurveProjection<N_pointDimension, T_number>;
+
+    explicit BezierProjector(const Bezier_t & aBezier);
+
+    /// \brief Project on the Bezier curve equivalent to `aCardinal`, with the same parameterization.
+    explicit BezierProjector(const CardinalCubic<N_pointDimension, T_number> & aCardinal)
+        requires (N_controlPoints == 4) :
+        BezierProjector{aCardinal.toBezier()}
+    {}
+
+    Projection_t project(Position_t aPosition) const;
+
+    /// \brief Project each of `aPositions`, writing the results at the same index in `aProjections`.
+    void project(std::span<const Position_t> aPositions, std::span<Projection_t> aProjections) const;
+
+private:
+    /// \brief Position and its first three derivatives at `aParameter`.
+    std::array<Vec<N_pointDimension, T_number>, 4> evaluateDerivatives(T_number aParameter) const;
+
+    Bezier_t mBezier;
+    std::array<Vec<N_pointDimension, T_number>, N_controlPoints> mCoefficients;
+    std::array<Position_t, N_samples> mSamples;
+};
+
+
+/// \brief Closest point to `aPosition` on `aBezier`.
+/// \see BezierProjector, to project several positions on the same curve.
+template <TMP>
+CurveProjection<N_pointDimension, T_number> project(const Bezier<TMA> & aBezier,
+                                                    Position<N_pointDimension, T_number> aPosition);
+
+
+/// \brief Closest point to `aPosition` on `aCardinal`.
+/// \see BezierProjector, to project several positions on the same curve.
+template <int N_pointDimension, class T_number>
+CurveProjection<N_pointDimension, T_number> project(const CardinalCubic<N_pointDimension, T_number> & aCardinal,
+                                                    Position<N_pointDimension, T_number> aPosition);
+
+
+//
+// Implementations
+//
+template <TMP, int N_samples>
+BezierProjector<TMA, N_samples>::BezierProjector(const Bezier_t & aBezier) :
+    mBezier{aBezier},
+    mCoefficients{toPowerBasis(aBezier)},
+    mSamples{makeFilledArray<N_samples>(aBezier.start())}
+{
+    tessellate(mBezier, std::span<Position_t>{mSamples});
+}
+
+
+template <TMP, int N_samples>
+std::array<Vec<N_pointDimension, T_number>, 4>
+BezierProjector<TMA, N_samples>::evaluateDerivatives(T_number aParameter) const
+{
+    constexpr int degree = N_controlPoints - 1;
+
+    // Horner scheme, carrying the derivatives along (each one being scaled by its factorial order).
+    auto result = makeFilledArray<4>(Vec<N_pointDimension, T_number>::Zero());
+    result[0] = mCoefficients[degree];
+    for (int k = degree - 1; k >= 0; --k)
+    {
+        result[3] = result[3] * aParameter + result[2];
+        result[2] = result[2] * aParameter + result[1];
+        result[1] = result[1] * aParameter + result[0];
+        result[0] = result[0] * aParameter + mCoefficients[k];
+    }
+    result[2] *= T_number{2};
+    result[3] *= T_number{6};
+    return result;
+}
+
+
+template <TMP, int N_samples>
+typename BezierProjector<TMA, N_samples>::Projection_t
+BezierProjector<TMA, N_samples>::project(Position_t aPosition) const
+{
+    // Seed from the closest sample.
+    std::size_t closestSample = 0;
+    T_number closestDistanceSquared = (mSamples[0] - aPosition).getNormSquared();
+    for (std::size_t sampleId = 1; sampleId != N_samples; ++sampleId)
+    {
+        const T_number distanceSquared = (mSamples[sampleId] - aPosition).getNormSquared();
+        if (distanceSquared < closestDistanceSquared)
+        {
+            closestSample = sampleId;
+            closestDistanceSquared = distanceSquared;
+        }
+    }
+    const T_number seed = static_cast<T_number>(closestSample) / (N_samples - 1);
+
+    // Find a root of g(t) = B'(t).(B(t) - P), the derivative of half the squared distance.
+    constexpr int gMaxIterations = 8;
+    const T_number epsilon = 4 * std::numeric_limits<T_number>::epsilon();
+    T_number parameter = seed;
+    for (int iteration = 0; iteration != gMaxIterations; ++iteration)
+    {
+        const auto [position, first, second, third] = evaluateDerivatives(parameter);
+        const Vec<N_pointDimension, T_number> offset = position.template as<Vec>() - aPosition.template as<Vec>();
+
+        const T_number g = first.dot(offset);
+        const T_number gPrime = second.dot(offset) + first.getNormSquared();
+        const T_number gSecond = third.dot(offset) + 3 * second.dot(first);
+
+        // Halley step, falling back to Newton where its denominator is not safe.
+        T_number denominator = gPrime * gPrime - g * gSecond / 2;
+        T_number step = (denominator > T_number{0}) ? g * gPrime / denominator : g / gPrime;
+        if (!std::isfinite(step))
+        {
+            break;
+        }
+
+        const T_number next = std::clamp(parameter - step, T_number{0}, T_number{1});
+        const T_number change = std::abs(next - parameter);
+        parameter = next;
+        if (change <= epsilon)
+        {
+            break;
+        }
+    }
+
+    const Position_t position = evaluate(mBezier, parameter);
+    const T_number distanceSquared = (position - aPosition).getNormSquared();
+    // The refinement might have converged to a farther critical point.
+    if (distanceSquared <= closestDistanceSquared)
+    {
+        return {parameter, position, distanceSquared};
+    }
+    return {seed, mSamples[closestSample], closestDistanceSquared};
+}
+
+
+template <TMP, int N_samples>
+void BezierProjector<TMA, N_samples>::project(std::span<const Position_t> aPositions,
+                                              std::span<Projection_t> aProjections) const
+{
+    assert(aPositions.size() == aProjections.size());
+    for (std::size_t positionId = 0; positionId != aPositions.size(); ++positionId)
+    {
+        aProjections[positionId] = project(aPositions[positionId]);
+    }
+}
+
+
+template <TMP>
+CurveProjection<N_pointDimension, T_number> project(const Bezier<TMA> & aBezier,
+                                                    Position<N_pointDimension, T_number> aPosition)
+{
+    return BezierProjector<TMA>{aBezier}.project(aPosition);
+}
+
+
+template <int N_pointDimension, class T_number>
+CurveProjection<N_pointDimension, T_number> project(const CardinalCubic<N_pointDimension, T_number> & aCardinal,
+                                                    Position<N_pointDimension, T_number> aPosition)
+{
+    return project(aCardinal.toBezier(), aPosition);
+}
+
+
+#undef TMA
+#undef TMP
+
+
+} // namespace math
+} // namespace ad
@@ -0,0 +1,124 @@
+#pragma once
+
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <ostream>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Signed fixed-point number, with `N_fractionalBits` of its 32 bits after the point.
+///
+/// Arithmetic is carried on the integer representation, with 64 bits intermediates.
+/// Results are thus bit-identical on all platforms, contrary to floating point computations
+/// which depend on the compiler and instruction set (e.g. contraction to fused multiply-add).
+/// \note Multiplication rounds toward negative infinity, division truncates toward zero.
+/// Overflows are not detected.
+template <int N_fractionalBits = 16>
+class FixedPoint
+{
+    static_assert(N_fractionalBits > 0 && N_fractionalBits < 31);
+
+public:
+    using Raw_t = std::int32_t;
+    using Intermediate_t = std::int64_t;
+
+    static constexpr int gFractionalBits = N_fractionalBits;
+    static constexpr Raw_t gOneRaw = Raw_t{1} << N_fractionalBits;
+    static constexpr Raw_t gFractionMask = gOneRaw - 1;
+
+    constexpr FixedPoint() = default;
+
+    /// \note Implicit, so integer literals mix with fixed-point values as they do with floating point.
+    /*implicit*/ constexpr FixedPoint(int aInteger) :
+        mRaw{static_cast<Raw_t>(aInteger * gOneRaw)}
+    {}
+
+    /// \brief Round `aValue` to the nearest representable value.
+    template <std::floating_point T_floating>
+    explicit constexpr FixedPoint(T_floating aValue) :
+        mRaw{static_cast<Raw_t>(aValue * gOneRaw + (aValue < 0 ? T_floating{-0.5} : T_floating{0.5}))}
+    {}
+
+    static constexpr FixedPoint FromRaw(Raw_t aRaw)
+    {
+        FixedPoint result;
+        result.mRaw = aRaw;
+        return result;
+    }
+
+    /// \brief The smallest positive value, which is the quantization step.
+    static constexpr FixedPoint Epsilon()
+    { return FromRaw(1); }
+
+    constexpr Raw_t raw() const
+    { return mRaw; }
+
+    /// \brief Exact conversion for floating types with at least 32 bits of mantissa.
+    template <std::floating_point T_floating>
+    explicit constexpr operator T_floating() const
+    { return static_cast<T_floating>(mRaw) * (T_floating{1} / gOneRaw); }
+
+    constexpr auto operator<=>(const FixedPoint &) const = default;
+
+    constexpr FixedPoint operator-() const
+    { return FromRaw(-mRaw); }
+
+    constexpr FixedPoint & operator+=(FixedPoint aRhs)
+    {
+        mRaw += aRhs.mRaw;
+        return *this;
+    }
+
+    constexpr FixedPoint & operator-=(FixedPoint aRhs)
+    {
+        mRaw -= aRhs.mRaw;
+        return *this;
+    }
+
+    constexpr FixedPoint & operator*=(FixedPoint aRhs)
+    {
+        mRaw = static_cast<Raw_t>((static_cast<Intermediate_t>(mRaw) * aRhs.mRaw) >> N_fractionalBits);
+        return *this;
+    }
+
+    constexpr FixedPoint & operator/=(FixedPoint aRhs)
+    {
+        mRaw = static_cast<Raw_t>((static_cast<Intermediate_t>(mRaw) * gOneRaw) / aRhs.mRaw);
+        return *this;
+    }
+
+    friend constexpr FixedPoint operator+(FixedPoint aLhs, FixedPoint aRhs)
+    { return aLhs += aRhs; }
+
+    friend constexpr FixedPoint operator-(FixedPoint aLhs, FixedPoint aRhs)
+    { return aLhs -= aRhs; }
+
+    friend constexpr FixedPoint operator*(FixedPoint aLhs, FixedPoint aRhs)
+    { return aLhs *= aRhs; }
+
+    friend constexpr FixedPoint operator/(FixedPoint aLhs, FixedPoint aRhs)
+    { return aLhs /= aRhs; }
+
+private:
+    Raw_t mRaw{0};
+};
+
+
+/// \brief Fixed-point number with 16 integral bits (including the sign) and 16 fractional bits.
+using Q16_16 = FixedPoint<16>;
+
+
+template <int N_fractionalBits>
+std::ostream & operator<<(std::ostream & aOut, FixedPoint<N_fractionalBits> aValue)
+{
+    return aOut << static_cast<double>(aValue) << " (raw " << aValue.raw() << ")";
+}
+
+
+} // namespace math
+} // namespace ad
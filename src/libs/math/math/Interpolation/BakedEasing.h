@@ -0,0 +1,272 @@
+#pragma once
+
+
+#include "../Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+namespace ease {
+
+
+/// \brief How a baked easing reconstructs values between its samples.
+enum class Reconstruction
+{
+    Linear,
+    CubicHermite,
+};
+
+
+/// \brief Easing functor sampling another easing functor into a fixed-size table, over the input range [0, 1].
+///
+/// Easing is then constant time, whatever the cost of the source functor
+/// (e.g. ease::Bezier solving a cubic to invert x(t)), at the price of an approximation.
+/// Inputs outside of [0, 1] are clamped.
+///
+/// With h = 1 / (N_samples - 1) the sample spacing, the maximum error over an interval where the source
+/// is smooth is bounded by:
+/// * Linear: h^2 / 8 * max|f''|
+/// * CubicHermite: h^4 / 384 * max|f''''|, the slopes being estimated by finite differences of the source.
+///
+/// \see getErrorBound() to evaluate these bounds, getBakingError() for the error measured while baking.
+/// \note Near a discontinuity of the source derivative (e.g. a corner between segments of a Bezier easing),
+/// the error is only first order in h.
+/// \see Baked, to use it as a ParameterAnimation easing functor.
+/// \see BakedEaseRef, to share a table between many animations.
+template <class T_parameter,
+          template <class> class TT_easeFunctor,
+          std::size_t N_samples = 256,
+          Reconstruction N_reconstruction = Reconstruction::Linear>
+class BakedEase
+{
+    static_assert(N_samples >= 2, "The table must at least contain the values at 0 and 1.");
+
+    // Linear reconstruction stores the sampled values,
+    // cubic Hermite stores the polynomial coefficients of each interval.
+    static constexpr std::size_t gTableSize =
+        (N_reconstruction == Reconstruction::Linear) ? N_samples : 4 * (N_samples - 1);
+
+public:
+    using Source_t = TT_easeFunctor<T_parameter>;
+
+    static constexpr T_parameter gStep = T_parameter{1} / static_cast<T_parameter>(N_samples - 1);
+
+    /// \brief Bake a default constructed source functor.
+    BakedEase() :
+        BakedEase{Source_t{}}
+    {}
+
+    /// \note Implicit, so a source functor can be provided where a baked one is expected
+    /// (e.g. ParameterAnimation constructor).
+    BakedEase(Source_t aSource);
+
+    T_parameter ease(T_parameter aInput) const;
+
+    std::vector<math::Position<2, float>> getKnots() const
+    { return mSource.getKnots(); }
+
+    const Source_t & getSource() const
+    { return mSource; }
+
+    /// \brief The maximum absolute difference with the source, measured at the middle of each interval
+    /// while baking.
+    ///
+    /// For a smooth source, this is where the reconstruction error is the largest.
+    T_parameter getBakingError() const
+    { return mBakingError; }
+
+    /// \brief Upper bound of the reconstruction error for a smooth source.
+    /// \param aDerivativeBound Bound of the absolute value of the source second derivative (Linear)
+    /// or fourth derivative (CubicHermite) over [0, 1].
+    static constexpr T_parameter getErrorBound(T_parameter aDerivativeBound);
+
+    /// \note The table is not exposed to the witness: edit the source and bake it again instead.
+    template<class T_witness>
+    void describeTo(T_witness && aWitness)
+    {}
+
+private:
+    /// \brief Slope of the source at `aInput`, estimated by finite differences within [0, 1].
+    T_parameter estimateSlope(T_parameter aInput) const;
+
+    Source_t mSource;
+    std::array<T_parameter, gTableSize> mTable;
+    T_parameter mBakingError{0};
+};
+
+
+/// \brief Easing functor referencing a BakedEase owned elsewhere, so many animations share its table.
+///
+/// It is the size of a pointer, where each BakedEase stores its source and its table.
+/// \attention The referenced BakedEase must outlive the functor.
+template <class T_parameter,
+          template <class> class TT_easeFunctor,
+          std::size_t N_samples = 256,
+          Reconstruction N_reconstruction = Reconstruction::Linear>
+class BakedEaseRef
+{
+public:
+    using Baked_t = BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>;
+
+    /// \note Implicit, so a baked easing can be provided where a reference is expected
+    /// (e.g. ParameterAnimation constructor).
+    BakedEaseRef(const Baked_t & aBaked) :
+        mBaked{&aBaked}
+    {}
+
+    T_parameter ease(T_parameter aInput) const
+    { return mBaked->ease(aInput); }
+
+    std::vector<math::Position<2, float>> getKnots() const
+    { return mBaked->getKnots(); }
+
+    const Baked_t & getBaked() const
+    { return *mBaked; }
+
+    /// \note The shared baked easing is not exposed to the witness.
+    template<class T_witness>
+    void describeTo(T_witness && aWitness)
+    {}
+
+private:
+    const Baked_t * mBaked;
+};
+
+
+/// \brief Adapt BakedEase to the single parameter easing functor template expected by ParameterAnimation.
+///
+/// e.g. `ParameterAnimation<float, Clamp, None, ease::Baked<ease::Bezier>::type>`,
+/// or `ease::Baked<ease::Bezier>::shared` to reference a BakedEase owned elsewhere.
+template <template <class> class TT_easeFunctor,
+          std::size_t N_samples = 256,
+          Reconstruction N_reconstruction = Reconstruction::Linear>
+struct Baked
+{
+    template <class T_parameter>
+    using type = BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>;
+
+    template <class T_parameter>
+    using shared = BakedEaseRef<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>;
+};
+
+
+//
+// Implementations
+//
+template <class T_parameter, template <class> class TT_easeFunctor, std::size_t N_samples, Reconstruction N_reconstruction>
+BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>::BakedEase(Source_t aSource) :
+    mSource{std::move(aSource)}
+{
+    auto sampleAt = [](std::size_t aSampleId)
+    {
+        // The last sample is exactly at 1, whatever the rounding of the step.
+        return (aSampleId == N_samples - 1) ? T_parameter{1} : static_cast<T_parameter>(aSampleId) * gStep;
+    };
+
+    if constexpr (N_reconstruction == Reconstruction::Linear)
+    {
+        for (std::size_t sampleId = 0; sampleId != N_samples; ++sampleId)
+        {
+            mTable[sampleId] = mSource.ease(sampleAt(sampleId));
+        }
+    }
+    else
+    {
+        T_parameter startValue = mSource.ease(T_parameter{0});
+        // Slopes are scaled to the interval length, so the cubic is parameterized over [0, 1].
+        T_parameter startSlope = estimateSlope(T_parameter{0}) * gStep;
+        for (std::size_t intervalId = 0; intervalId != N_samples - 1; ++intervalId)
+        {
+            const T_parameter endInput = sampleAt(intervalId + 1);
+            const T_parameter endValue = mSource.ease(endInput);
+            const T_parameter endSlope = estimateSlope(endInput) * gStep;
+
+            T_parameter * coefficients = mTable.data() + 4 * intervalId;
+            coefficients[0] = startValue;
+            coefficients[1] = startSlope;
+            coefficients[2] = 3 * (endValue - startValue) - 2 * startSlope - endSlope;
+            coefficients[3] = 2 * (startValue - endValue) + startSlope + endSlope;
+
+            startValue = endValue;
+            startSlope = endSlope;
+        }
+    }
+
+    for (std::size_t intervalId = 0; intervalId != N_samples - 1; ++intervalId)
+    {
+        const T_parameter middle = (static_cast<T_parameter>(intervalId) + T_parameter{0.5}) * gStep;
+        mBakingError = std::max(mBakingError, std::abs(ease(middle) - mSource.ease(middle)));
+    }
+}
+
+
+template <class T_parameter, template <class> class TT_easeFunctor, std::size_t N_samples, Reconstruction N_reconstruction>
+T_parameter BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>::ease(T_parameter aInput) const
+{
+    const T_parameter position = std::clamp(aInput, T_parameter{0}, T_parameter{1})
+                                 * static_cast<T_parameter>(N_samples - 1);
+    const std::size_t intervalId = std::min(static_cast<std::size_t>(position), N_samples - 2);
+    const T_parameter t = position - static_cast<T_parameter>(intervalId);
+
+    if constexpr (N_reconstruction == Reconstruction::Linear)
+    {
+        const T_parameter start = mTable[intervalId];
+        return start + t * (mTable[intervalId + 1] - start);
+    }
+    else
+    {
+        const T_parameter * coefficients = mTable.data() + 4 * intervalId;
+        return coefficients[0] + t * (coefficients[1] + t * (coefficients[2] + t * coefficients[3]));
+    }
+}
+
+
+template <class T_parameter, template <class> class TT_easeFunctor, std::size_t N_samples, Reconstruction N_reconstruction>
+constexpr T_parameter
+BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>::getErrorBound(T_parameter aDerivativeBound)
+{
+    if constexpr (N_reconstruction == Reconstruction::Linear)
+    {
+        return gStep * gStep / 8 * aDerivativeBound;
+    }
+    else
+    {
+        return gStep * gStep * gStep * gStep / 384 * aDerivativeBound;
+    }
+}
+
+
+template <class T_parameter, template <class> class TT_easeFunctor, std::size_t N_samples, Reconstruction N_reconstruction>
+T_parameter BakedEase<T_parameter, TT_easeFunctor, N_samples, N_reconstruction>::estimateSlope(T_parameter aInput) const
+{
+    // Balances the truncation and rounding errors of a second order difference.
+    static const T_parameter delta = std::cbrt(std::numeric_limits<T_parameter>::epsilon());
+
+    // Second order one-sided differences at the ends, so the source is only evaluated within [0, 1].
+    if (aInput - delta < T_parameter{0})
+    {
+        return (-3 * mSource.ease(aInput) + 4 * mSource.ease(aInput + delta) - mSource.ease(aInput + 2 * delta))
+               / (2 * delta);
+    }
+    else if (aInput + delta > T_parameter{1})
+    {
+        return (3 * mSource.ease(aInput) - 4 * mSource.ease(aInput - delta) + mSource.ease(aInput - 2 * delta))
+               / (2 * delta);
+    }
+    else
+    {
+        return (mSource.ease(aInput + delta) - mSource.ease(aInput - delta)) / (2 * delta);
+    }
+}
+
+
+} // namespace ease
+} // namespace math
+} // namespace ad
@@ -0,0 +1,303 @@
+#pragma once
+
+
+#include "ParameterAnimation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Runtime counterpart of ParameterAnimation, where the result range, periodicity and easing are data.
+///
+/// Animations with different behaviours have the same type, so they can be stored contiguously.
+/// The periodicity and easing are tagged variants, dispatched without virtual calls.
+/// Curve based easings, which are large, are referenced instead of copied, so the animation stays compact.
+/// \attention The referenced easings must outlive the animation.
+///
+/// \see at() evaluating a contiguous array of animations, a single dispatch per run of animations of the same kind.
+template <class T_parameter>
+class DynamicParameterAnimation
+{
+public:
+    using Periodicity_t = std::variant<None<T_parameter>,
+                                       periodic::Repeat<T_parameter>,
+                                       periodic::PingPong<T_parameter>>;
+
+    using Easing_t = std::variant<None<T_parameter>,
+                                  ease::SmoothStep<T_parameter>,
+                                  const ease::Bezier<T_parameter> *,
+                                  const ease::CubicSpline<T_parameter> *,
+                                  const ease::MassSpringDamper<T_parameter> *>;
+
+    /// \brief The combination of behaviours of an animation.
+    /// Animations of the same kind are evaluated by the same code path.
+    struct Kind
+    {
+        AnimationResult mResultRange;
+        std::size_t mPeriodicity;
+        std::size_t mEasing;
+
+        auto operator<=>(const Kind &) const = default;
+    };
+
+    /// \note The speed is notably available for clamped output, contrary to ParameterAnimation.
+    DynamicParameterAnimation(AnimationResult aResultRange,
+                              Periodicity_t aPeriodicity,
+                              Easing_t aEasing,
+                              T_parameter aPeriod = T_parameter{1},
+                              T_parameter aSpeed = T_parameter{1}) :
+        mPeriodicity{aPeriodicity},
+        mEasing{aEasing},
+        mResultRange{aResultRange},
+        mPeriod{aPeriod},
+        mInversePeriod{T_parameter{1} / aPeriod},
+        mSpeed{aSpeed}
+    {}
+
+    T_parameter at(T_parameter aInput) const;
+
+    /// \brief Evaluate at `aInput`, with the behaviours statically known.
+    /// \attention The types must be the alternatives currently held by the periodicity and the easing,
+    /// and `N_isClamped` must match the result range.
+    template <class T_periodicity, class T_easing, bool N_isClamped>
+    T_parameter evaluateAs(T_parameter aInput) const;
+
+    Kind getKind() const
+    { return {mResultRange, mPeriodicity.index(), mEasing.index()}; }
+
+    const Periodicity_t & getPeriodicity() const
+    { return mPeriodicity; }
+
+    const Easing_t & getEasing() const
+    { return mEasing; }
+
+    AnimationResult getResultRange() const
+    { return mResultRange; }
+
+    const T_parameter & getPeriod() const
+    { return mPeriod; }
+
+    const T_parameter & getSpeed() const
+    { return mSpeed; }
+
+    /// \brief Indicates if this animation can reach completion (or if it goes on forever).
+    /// \see ParameterAnimation::IsFinite()
+    bool isFinite() const;
+
+    /// \see ParameterAnimation::isCompleted()
+    bool isCompleted(T_parameter aInput) const;
+
+    /// \see ParameterAnimation::getOvershoot()
+    T_parameter getOvershoot(T_parameter aInput) const;
+
+private:
+    bool isPeriodic() const
+    { return !std::holds_alternative<None<T_parameter>>(mPeriodicity); }
+
+    bool isEasing() const
+    { return !std::holds_alternative<None<T_parameter>>(mEasing); }
+
+    Periodicity_t mPeriodicity;
+    Easing_t mEasing;
+    AnimationResult mResultRange;
+    T_parameter mPeriod;
+    T_parameter mInversePeriod;
+    T_parameter mSpeed;
+};
+
+
+/// \brief Evaluate each of `aAnimations` at the input of same index, writing the result at the same index.
+///
+/// The behaviours are dispatched once per run of consecutive animations of the same kind,
+/// the loop over the run being specialized for this kind.
+/// \see sortByKind() to get the longest runs.
+template <class T_parameter>
+void at(std::span<const DynamicParameterAnimation<T_parameter>> aAnimations,
+        std::span<const T_parameter> aInputs,
+        std::span<T_parameter> aResults);
+
+
+/// \brief Reorder `aAnimations` so animations of the same kind are consecutive,
+/// preserving the relative order of animations of a given kind.
+template <class T_parameter>
+void sortByKind(std::span<DynamicParameterAnimation<T_parameter>> aAnimations);
+
+
+//
+// Implementations
+//
+namespace detail {
+
+    template <class T_easing, class T_parameter>
+    T_parameter easeWith(const T_easing & aEasing, T_parameter aInput)
+    {
+        if constexpr (std::is_pointer_v<T_easing>)
+        {
+            return aEasing->ease(aInput);
+        }
+        else
+        {
+            return aEasing.ease(aInput);
+        }
+    }
+
+
+    template <class T_periodicity, class T_easing, bool N_isClamped, class T_parameter>
+    void evaluateRun(std::span<const DynamicParameterAnimation<T_parameter>> aAnimations,
+                     std::span<const T_parameter> aInputs,
+                     std::span<T_parameter> aResults)
+    {
+        for (std::size_t animationId = 0; animationId != aAnimations.size(); ++animationId)
+        {
+            aResults[animationId] = aAnimations[animationId]
+                .template evaluateAs<T_periodicity, T_easing, N_isClamped>(aInputs[animationId]);
+        }
+    }
+
+} // namespace detail
+
+
+template <class T_parameter>
+template <class T_periodicity, class T_easing, bool N_isClamped>
+T_parameter DynamicParameterAnimation<T_parameter>::evaluateAs(T_parameter aInput) const
+{
+    assert(std::holds_alternative<T_periodicity>(mPeriodicity));
+    assert(std::holds_alternative<T_easing>(mEasing));
+    assert(N_isClamped == (mResultRange == Clamp));
+
+    // Same logic as ParameterAnimation::at()
+    aInput *= mSpeed;
+
+    if constexpr (!std::is_same_v<T_periodicity, None<T_parameter>>)
+    {
+        aInput = std::get<T_periodicity>(mPeriodicity)(mPeriod, mInversePeriod, aInput);
+    }
+
+    if constexpr (!std::is_same_v<T_easing, None<T_parameter>>)
+    {
+        aInput = detail::easeWith(std::get<T_easing>(mEasing), aInput * mInversePeriod);
+        if constexpr (!N_isClamped)
+        {
+            aInput *= mPeriod;
+        }
+    }
+    else if constexpr (N_isClamped)
+    {
+        aInput *= mInversePeriod;
+    }
+
+    if constexpr (N_isClamped)
+    {
+        return Clamped<T_parameter>{aInput};
+    }
+    else
+    {
+        return aInput;
+    }
+}
+
+
+template <class T_parameter>
+T_parameter DynamicParameterAnimation<T_parameter>::at(T_parameter aInput) const
+{
+    return std::visit([&](const auto & aPeriodicity, const auto & aEasing)
+        {
+            using Periodicity = std::decay_t<decltype(aPeriodicity)>;
+            using Easing = std::decay_t<decltype(aEasing)>;
+            return (mResultRange == Clamp) ?
+                evaluateAs<Periodicity, Easing, true>(aInput)
+                : evaluateAs<Periodicity, Easing, false>(aInput);
+        },
+        mPeriodicity, mEasing);
+}
+
+
+template <class T_parameter>
+bool DynamicParameterAnimation<T_parameter>::isFinite() const
+{
+    const bool isTrivial = mResultRange != Clamp && !isPeriodic() && !isEasing();
+    return !isPeriodic() && !isTrivial;
+}
+
+
+template <class T_parameter>
+bool DynamicParameterAnimation<T_parameter>::isCompleted(T_parameter aInput) const
+{
+    return isFinite() && (aInput * mSpeed) >= mPeriod;
+}
+
+
+template <class T_parameter>
+T_parameter DynamicParameterAnimation<T_parameter>::getOvershoot(T_parameter aInput) const
+{
+    if (isFinite())
+    {
+        return std::max<T_parameter>(0, aInput - (mPeriod / mSpeed));
+    }
+    return T_parameter{0};
+}
+
+
+template <class T_parameter>
+void at(std::span<const DynamicParameterAnimation<T_parameter>> aAnimations,
+        std::span<const T_parameter> aInputs,
+        std::span<T_parameter> aResults)
+{
+    assert(aAnimations.size() == aInputs.size() && aAnimations.size() == aResults.size());
+
+    std::size_t runBegin = 0;
+    while (runBegin != aAnimations.size())
+    {
+        const auto kind = aAnimations[runBegin].getKind();
+        std::size_t runEnd = runBegin + 1;
+        while (runEnd != aAnimations.size() && aAnimations[runEnd].getKind() == kind)
+        {
+            ++runEnd;
+        }
+
+        const std::size_t runSize = runEnd - runBegin;
+        std::visit([&](const auto & aPeriodicity, const auto & aEasing)
+            {
+                using Periodicity = std::decay_t<decltype(aPeriodicity)>;
+                using Easing = std::decay_t<decltype(aEasing)>;
+                auto animations = aAnimations.subspan(runBegin, runSize);
+                auto inputs = aInputs.subspan(runBegin, runSize);
+                auto results = aResults.subspan(runBegin, runSize);
+                if (kind.mResultRange == Clamp)
+                {
+                    detail::evaluateRun<Periodicity, Easing, true>(animations, inputs, results);
+                }
+                else
+                {
+                    detail::evaluateRun<Periodicity, Easing, false>(animations, inputs, results);
+                }
+            },
+            aAnimations[runBegin].getPeriodicity(), aAnimations[runBegin].getEasing());
+
+        runBegin = runEnd;
+    }
+}
+
+
+template <class T_parameter>
+void sortByKind(std::span<DynamicParameterAnimation<T_parameter>> aAnimations)
+{
+    std::stable_sort(aAnimations.begin(), aAnimations.end(),
+                     [](const auto & aLhs, const auto & aRhs)
+                     {
+                         return aLhs.getKind() < aRhs.getKind();
+                     });
+}
+
+
+} // namespace math
+} // namespace ad
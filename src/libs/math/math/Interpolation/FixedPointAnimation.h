@@ -0,0 +1,163 @@
+#pragma once
+
+
+#include "BakedEasing.h"
+#include "ParameterAnimation.h"
+
+#include "../FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+
+// Deterministic ParameterAnimation, with a FixedPoint parameter (e.g. Q16_16).
+//
+// Periodicities and baked easings are specialized for fixed-point parameters,
+// so they only rely on integer operations: there is no floating point division nor std::floor.
+// The clamping and the normalization by the period done by ParameterAnimation directly use
+// the FixedPoint operators.
+//
+// e.g. `ParameterAnimation<Q16_16, Clamp, periodic::Repeat, ease::Baked<ease::Bezier>::type>`
+
+
+namespace ad {
+namespace math {
+
+
+namespace periodic {
+
+
+template <int N_fractionalBits>
+struct Repeat<FixedPoint<N_fractionalBits>>
+{
+    using Fixed_t = FixedPoint<N_fractionalBits>;
+
+    Fixed_t operator()(Fixed_t aPeriod, Fixed_t aAbsoluteValue) const
+    {
+        // Integer remainder, moved to [0, period[ for negative values.
+        typename Fixed_t::Raw_t remainder = aAbsoluteValue.raw() % aPeriod.raw();
+        if (remainder < 0)
+        {
+            remainder += aPeriod.raw();
+        }
+        return Fixed_t::FromRaw(remainder);
+    }
+};
+
+
+template <int N_fractionalBits>
+struct PingPong<FixedPoint<N_fractionalBits>>
+{
+    using Fixed_t = FixedPoint<N_fractionalBits>;
+
+    Fixed_t operator()(Fixed_t aPeriod, Fixed_t aAbsoluteValue) const
+    {
+        const Fixed_t doublePeriod = Repeat<Fixed_t>{}(2 * aPeriod, aAbsoluteValue);
+        return doublePeriod - 2 * std::max(Fixed_t{0}, doublePeriod - aPeriod);
+    }
+};
+
+
+} // namespace periodic
+
+
+namespace ease {
+
+
+/// \brief Baked easing for fixed-point parameters, with linear reconstruction.
+///
+/// The source easing is evaluated in double precision at construction, and its samples are rounded
+/// to the fixed-point representation. Easing then only uses integer operations.
+/// \attention The baked table is identical on all platforms only if the source evaluation is
+/// (e.g. sources using transcendental functions, such as ease::MassSpringDamper, might differ in the last bits
+/// between standard libraries). The table can otherwise be baked once, then distributed with getTable().
+template <int N_fractionalBits, template <class> class TT_easeFunctor, std::size_t N_samples>
+class BakedEase<FixedPoint<N_fractionalBits>, TT_easeFunctor, N_samples, Reconstruction::Linear>
+{
+    static_assert(N_samples >= 2, "The table must at least contain the values at 0 and 1.");
+
+    using Fixed_t = FixedPoint<N_fractionalBits>;
+    using Raw_t = typename Fixed_t::Raw_t;
+    using Intermediate_t = typename Fixed_t::Intermediate_t;
+
+public:
+    using Source_t = TT_easeFunctor<double>;
+    using Table_t = std::array<Fixed_t, N_samples>;
+
+    /// \brief Bake a default constructed source functor.
+    BakedEase() :
+        BakedEase{Source_t{}}
+    {}
+
+    /// \note Implicit, so a source functor can be provided where a baked one is expected
+    /// (e.g. ParameterAnimation constructor).
+    BakedEase(Source_t aSource);
+
+    /// \brief Use a table baked previously (e.g. on another machine).
+    BakedEase(Source_t aSource, const Table_t & aTable) :
+        mSource{std::move(aSource)},
+        mTable{aTable}
+    {}
+
+    Fixed_t ease(Fixed_t aInput) const;
+
+    std::vector<math::Position<2, float>> getKnots() const
+    { return mSource.getKnots(); }
+
+    const Source_t & getSource() const
+    { return mSource; }
+
+    const Table_t & getTable() const
+    { return mTable; }
+
+    /// \note The table is not exposed to the witness: edit the source and bake it again instead.
+    template<class T_witness>
+    void describeTo(T_witness && aWitness)
+    {}
+
+private:
+    Source_t mSource;
+    Table_t mTable;
+};
+
+
+//
+// Implementations
+//
+template <int N_fractionalBits, template <class> class TT_easeFunctor, std::size_t N_samples>
+BakedEase<FixedPoint<N_fractionalBits>, TT_easeFunctor, N_samples, Reconstruction::Linear>::BakedEase(
+    Source_t aSource) :
+    mSource{std::move(aSource)}
+{
+    for (std::size_t sampleId = 0; sampleId != N_samples; ++sampleId)
+    {
+        // The last sample is exactly at 1.
+        const double input = (sampleId == N_samples - 1) ?
+            1. : static_cast<double>(sampleId) / static_cast<double>(N_samples - 1);
+        mTable[sampleId] = Fixed_t{mSource.ease(input)};
+    }
+}
+
+
+template <int N_fractionalBits, template <class> class TT_easeFunctor, std::size_t N_samples>
+auto BakedEase<FixedPoint<N_fractionalBits>, TT_easeFunctor, N_samples, Reconstruction::Linear>::ease(
+    Fixed_t aInput) const -> Fixed_t
+{
+    // The position in the table, with the same fractional bits as the input.
+    const Intermediate_t position =
+        static_cast<Intermediate_t>(std::clamp(aInput, Fixed_t{0}, Fixed_t{1}).raw()) * (N_samples - 1);
+    const std::size_t intervalId =
+        std::min(static_cast<std::size_t>(position >> N_fractionalBits), N_samples - 2);
+    const Intermediate_t t = position - (static_cast<Intermediate_t>(intervalId) << N_fractionalBits);
+
+    const Raw_t start = mTable[intervalId].raw();
+    const Raw_t end = mTable[intervalId + 1].raw();
+    return Fixed_t::FromRaw(static_cast<Raw_t>(start + ((t * (end - start)) >> N_fractionalBits)));
+}
+
+
+} // namespace ease
+} // namespace math
+} // namespace ad
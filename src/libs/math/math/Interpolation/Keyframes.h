@@ -0,0 +1,375 @@
+#pragma once
+
+
+#include "DynamicParameterAnimation.h"
+#include "Interpolation.h"
+#include "QuaternionInterpolation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Interpolate between two consecutive keys of a KeyframeTrack, with lerp().
+///
+/// It can be specialized for value types requiring another interpolation.
+template <class T_value>
+struct KeyframeInterpolator
+{
+    template <class T_parameter>
+    T_value operator()(const T_value & aFirst,
+                       const T_value & aLast,
+                       const Clamped<T_parameter> & aParameter) const
+    {
+        return lerp(aFirst, aLast, aParameter);
+    }
+};
+
+
+/// \brief Quaternions keys are interpolated with slerp().
+template <class T_number>
+struct KeyframeInterpolator<Quaternion<T_number>>
+{
+    template <class T_parameter>
+    Quaternion<T_number> operator()(const Quaternion<T_number> & aFirst,
+                                    const Quaternion<T_number> & aLast,
+                                    const Clamped<T_parameter> & aParameter) const
+    {
+        return slerp(aFirst, aLast, aParameter);
+    }
+};
+
+
+/// \brief A sequence of keys, each associating a value to a time, sampled by interpolating between the keys.
+///
+/// The times and the values are stored in separate contiguous arrays.
+/// Each key has an easing, applied to the interpolation parameter between this key and the next one.
+/// The easings are the ones of DynamicParameterAnimation, the curve based easings being referenced.
+/// \attention The referenced easings must outlive the track.
+///
+/// Before the first key, the track has the first value, after the last key it has the last value.
+template <class T_value, class T_parameter = float, class T_interpolator = KeyframeInterpolator<T_value>>
+class KeyframeTrack
+{
+public:
+    using Value_type = T_value;
+    using Easing_t = typename DynamicParameterAnimation<T_parameter>::Easing_t;
+
+    /// \brief Append a key, which must not be before the last key.
+    void addKey(T_parameter aTime, T_value aValue, Easing_t aEasing = None<T_parameter>{});
+
+    /// \brief The value at `aTime`, finding the keys around it in O(log n).
+    /// \attention The track must have at least one key.
+    T_value at(T_parameter aTime) const;
+
+    /// \brief The value at `aTime`, using and updating `aCursor` to find the keys around it.
+    ///
+    /// When the track is sampled at increasing times, the keys are found in constant time.
+    T_value at(T_parameter aTime, std::size_t & aCursor) const;
+
+    std::size_t size() const
+    { return mTimes.size(); }
+
+    std::span<const T_parameter> getTimes() const
+    { return mTimes; }
+
+    std::span<const T_value> getValues() const
+    { return mValues; }
+
+    std::span<const Easing_t> getEasings() const
+    { return mEasings; }
+
+    /// \brief The index of the key starting the interval containing `aTime`, in O(log n).
+    /// \attention `aTime` must be in [first key time, last key time[.
+    std::size_t getKeyIndex(T_parameter aTime) const;
+
+    /// \brief Same as getKeyIndex(aTime), but first tests the interval `aHint` and the next one.
+    std::size_t getKeyIndex(T_parameter aTime, std::size_t aHint) const;
+
+private:
+    /// \brief Interpolate between the key `aKeyIndex` and the next one.
+    T_value interpolate(T_parameter aTime, std::size_t aKeyIndex) const;
+
+    std::vector<T_parameter> mTimes;
+    std::vector<T_value> mValues;
+    std::vector<Easing_t> mEasings;
+};
+
+
+/// \brief A group of keyframe tracks sharing a timing, sampled all at once for an animation frame.
+///
+/// The clip time is mapped to the tracks local time by a full range ParameterAnimation,
+/// with the clip duration as period, so the clip can be sped up, and repeated or ping-ponged.
+/// A clip can hold tracks of each of the value types `VT_values`, which must be distinct.
+///
+/// The clip keeps a cursor for each track, so sampling at increasing times does not search the keys.
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+class KeyframeClip
+{
+    static constexpr bool IsPeriodic()
+    {
+        return !std::is_same_v<TT_periodicity<T_parameter>, None<T_parameter>>;
+    }
+
+    template <class T_value>
+    struct Channel
+    {
+        KeyframeTrack<T_value, T_parameter> mTrack;
+        std::size_t mCursor{0};
+    };
+
+public:
+    using Timing_type = ParameterAnimation<T_parameter, FullRange, TT_periodicity>;
+
+    template <class T_value>
+    using Track_type = KeyframeTrack<T_value, T_parameter>;
+
+    /// \brief The values of all tracks at a given time, for each value type at the index of the track.
+    using Frame = std::tuple<std::vector<VT_values>...>;
+
+    explicit KeyframeClip(T_parameter aDuration, T_parameter aSpeed = T_parameter{1});
+
+    /// \return The index of the track among the tracks of the same value type.
+    template <class T_value>
+    std::size_t addTrack(Track_type<T_value> aTrack);
+
+    template <class T_value>
+    const Track_type<T_value> & getTrack(std::size_t aIndex) const
+    { return getChannels<T_value>()[aIndex].mTrack; }
+
+    template <class T_value>
+    std::size_t getTrackCount() const
+    { return getChannels<T_value>().size(); }
+
+    /// \brief Sample all tracks at the clip time `aTime`, replacing the content of `aFrame`.
+    /// \note Reusing the same frame between calls avoids allocations.
+    void sample(T_parameter aTime, Frame & aFrame);
+
+    Frame sample(T_parameter aTime);
+
+    /// \brief The time of the tracks corresponding to the clip time `aTime`.
+    T_parameter getLocalTime(T_parameter aTime) const
+    { return mTiming.at(aTime); }
+
+    /// \brief Indicate whether the tracks reached the end of the clip at `aTime`,
+    /// which never happens for a periodic clip.
+    bool isCompleted(T_parameter aTime) const;
+
+    T_parameter getDuration() const
+    { return mDuration; }
+
+private:
+    template <class T_value>
+    std::vector<Channel<T_value>> & getChannels()
+    { return std::get<std::vector<Channel<T_value>>>(mChannels); }
+
+    template <class T_value>
+    const std::vector<Channel<T_value>> & getChannels() const
+    { return std::get<std::vector<Channel<T_value>>>(mChannels); }
+
+    static Timing_type makeTiming(T_parameter aDuration, T_parameter aSpeed);
+
+    std::tuple<std::vector<Channel<VT_values>>...> mChannels;
+    Timing_type mTiming;
+    T_parameter mDuration;
+};
+
+
+//
+// Implementations
+//
+template <class T_value, class T_parameter, class T_interpolator>
+void KeyframeTrack<T_value, T_parameter, T_interpolator>::addKey(T_parameter aTime,
+                                                                 T_value aValue,
+                                                                 Easing_t aEasing)
+{
+    assert(mTimes.empty() || aTime >= mTimes.back());
+
+    mTimes.push_back(aTime);
+    mValues.push_back(std::move(aValue));
+    mEasings.push_back(aEasing);
+}
+
+
+template <class T_value, class T_parameter, class T_interpolator>
+T_value KeyframeTrack<T_value, T_parameter, T_interpolator>::at(T_parameter aTime) const
+{
+    assert(size() > 0);
+
+    if (aTime <= mTimes.front())
+    {
+        return mValues.front();
+    }
+    else if (aTime >= mTimes.back())
+    {
+        return mValues.back();
+    }
+    return interpolate(aTime, getKeyIndex(aTime));
+}
+
+
+template <class T_value, class T_parameter, class T_interpolator>
+T_value KeyframeTrack<T_value, T_parameter, T_interpolator>::at(T_parameter aTime, std::size_t & aCursor) const
+{
+    assert(size() > 0);
+
+    if (aTime <= mTimes.front())
+    {
+        aCursor = 0;
+        return mValues.front();
+    }
+    else if (aTime >= mTimes.back())
+    {
+        aCursor = size() - 1;
+        return mValues.back();
+    }
+    aCursor = getKeyIndex(aTime, aCursor);
+    return interpolate(aTime, aCursor);
+}
+
+
+template <class T_value, class T_parameter, class T_interpolator>
+T_value KeyframeTrack<T_value, T_parameter, T_interpolator>::interpolate(T_parameter aTime,
+                                                                         std::size_t aKeyIndex) const
+{
+    const T_parameter parameter =
+        (aTime - mTimes[aKeyIndex]) / (mTimes[aKeyIndex + 1] - mTimes[aKeyIndex]);
+
+    const T_parameter eased = std::visit([parameter](const auto & aEasing)
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(aEasing)>, None<T_parameter>>)
+            {
+                return parameter;
+            }
+            else
+            {
+                return detail::easeWith(aEasing, parameter);
+            }
+        },
+        mEasings[aKeyIndex]);
+
+    return T_interpolator{}(mValues[aKeyIndex], mValues[aKeyIndex + 1], Clamped<T_parameter>{eased});
+}
+
+
+template <class T_value, class T_parameter, class T_interpolator>
+std::size_t KeyframeTrack<T_value, T_parameter, T_interpolator>::getKeyIndex(T_parameter aTime) const
+{
+    assert(aTime >= mTimes.front() && aTime < mTimes.back());
+
+    // The first key strictly after aTime ends the interval.
+    auto next = std::upper_bound(mTimes.begin(), mTimes.end(), aTime);
+    return (next - mTimes.begin()) - 1;
+}
+
+
+template <class T_value, class T_parameter, class T_interpolator>
+std::size_t KeyframeTrack<T_value, T_parameter, T_interpolator>::getKeyIndex(T_parameter aTime,
+                                                                             std::size_t aHint) const
+{
+    auto isInInterval = [&](std::size_t aIndex)
+    {
+        return aIndex + 1 < size() && mTimes[aIndex] <= aTime && aTime < mTimes[aIndex + 1];
+    };
+
+    if (isInInterval(aHint))
+    {
+        return aHint;
+    }
+    else if (isInInterval(aHint + 1))
+    {
+        return aHint + 1;
+    }
+    return getKeyIndex(aTime);
+}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+KeyframeClip<T_parameter, TT_periodicity, VT_values...>::KeyframeClip(T_parameter aDuration,
+                                                                     T_parameter aSpeed) :
+    mTiming{makeTiming(aDuration, aSpeed)},
+    mDuration{aDuration}
+{}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+auto KeyframeClip<T_parameter, TT_periodicity, VT_values...>::makeTiming(T_parameter aDuration,
+                                                                        T_parameter aSpeed)
+    -> Timing_type
+{
+    if constexpr (IsPeriodic())
+    {
+        return Timing_type{aDuration, aSpeed};
+    }
+    else
+    {
+        // The trivial ParameterAnimation has no period.
+        return Timing_type{aSpeed};
+    }
+}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+template <class T_value>
+std::size_t KeyframeClip<T_parameter, TT_periodicity, VT_values...>::addTrack(Track_type<T_value> aTrack)
+{
+    assert(aTrack.size() > 0);
+
+    auto & channels = getChannels<T_value>();
+    channels.push_back(Channel<T_value>{std::move(aTrack)});
+    return channels.size() - 1;
+}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+void KeyframeClip<T_parameter, TT_periodicity, VT_values...>::sample(T_parameter aTime, Frame & aFrame)
+{
+    const T_parameter localTime = getLocalTime(aTime);
+
+    auto sampleChannels = [localTime](auto & aChannels, auto & aValues)
+    {
+        aValues.clear();
+        for (auto & channel : aChannels)
+        {
+            aValues.push_back(channel.mTrack.at(localTime, channel.mCursor));
+        }
+    };
+
+    (sampleChannels(getChannels<VT_values>(), std::get<std::vector<VT_values>>(aFrame)), ...);
+}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+auto KeyframeClip<T_parameter, TT_periodicity, VT_values...>::sample(T_parameter aTime) -> Frame
+{
+    Frame frame;
+    sample(aTime, frame);
+    return frame;
+}
+
+
+template <class T_parameter, template <class> class TT_periodicity, class... VT_values>
+bool KeyframeClip<T_parameter, TT_periodicity, VT_values...>::isCompleted(T_parameter aTime) const
+{
+    if constexpr (IsPeriodic())
+    {
+        return false;
+    }
+    else
+    {
+        return getLocalTime(aTime) >= mDuration;
+    }
+}
+
+
+} // namespace math
+} // namespace ad
@@ -5,10 +5,18 @@
 #include "../Vector.h"
 #include "../Utilities.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ad {
@@ -23,6 +31,17 @@ T_number cubeRoot(const T_number & a)
 
 /// \brief Namespace containing all the easing functions.
 namespace ease {
+
+/// \brief How ease::Bezier inverts the x(t) cubic of a segment, to find the parameter of an input.
+enum class BezierSolver
+{
+    /// \brief Closed form roots of the cubic.
+    Analytic,
+    /// \brief Newton-Raphson iterations, seeded from a table of x samples per segment,
+    /// falling back to bisection where the slope is too flat.
+    Newton,
+};
+
 template <class T_parameter>
 struct Bezier
 {
@@ -37,33 +56,84 @@ struct Bezier
     std::array<T_parameter, Bezier::sMaxStageSize> mYValues;
     size_t mOnCurveCount;
 
+    // Number of x samples per segment, evenly spaced in t, used to seed the Newton solver.
+    constexpr static size_t sSampleCount = 11;
+    constexpr static size_t sNewtonIterations = 8;
+    constexpr static size_t sBisectionIterations = 64;
+
+    BezierSolver mSolver{BezierSolver::Analytic};
+    // Only populated with the Newton solver, so the analytic Bezier do not pay for the table.
+    std::vector<T_parameter> mXSamples;
+
     Bezier() :
         mXValues{0.f, 0.f, 1.f, 1.f},
         mYValues{0.f, 0.f, 1.f, 1.f},
         mOnCurveCount{2}
     {}
 
+    /// \brief Select how x(t) is inverted, building the sample table if required.
+    void setSolver(BezierSolver aSolver)
+    {
+        mSolver = aSolver;
+        updateXSamples();
+    }
+
+    /// \brief Rebuild the table of x samples of each segment, when the solver is BezierSolver::Newton.
+    ///
+    /// It is done by the member functions editing the points. Other solvers release the table.
+    /// \attention Must be called after editing mXValues or mOnCurveCount directly.
+    void updateXSamples()
+    {
+        if (mSolver != BezierSolver::Newton)
+        {
+            mXSamples = {};
+            return;
+        }
+
+        mXSamples.resize((mOnCurveCount - 1) * sSampleCount);
+        for (size_t segment = 0; segment + 1 < mOnCurveCount; ++segment)
+        {
+            for (size_t sample = 0; sample != sSampleCount; ++sample)
+            {
+                const T_parameter t = static_cast<T_parameter>(sample) / (sSampleCount - 1);
+                mXSamples[segment * sSampleCount + sample] = evaluateX(t, segment * 3);
+            }
+        }
+    }
+
     T_parameter ease(T_parameter aInput) const
     {
         size_t valueIndex = getValueIndex(aInput) * 3;
         return easeFromIndex(aInput, valueIndex);
     }
 
-    T_parameter easeFromIndex(T_parameter aInput, size_t aValueIndex) const
+    /// \brief Ease `aInput`, using and updating `aSegmentHint` to find its segment.
+    ///
+    /// When successive inputs are monotonic (e.g. time), keeping the hint makes the lookup constant time.
+    T_parameter ease(T_parameter aInput, size_t & aSegmentHint) const
     {
-        T_parameter startOnCurve = mYValues.at(aValueIndex);
-        T_parameter startOffCurve = mYValues.at(aValueIndex + 1);
-        T_parameter endOffCurve = mYValues.at(aValueIndex + 2);
-        T_parameter endOnCurve = mYValues.at(aValueIndex + 3);
+        aSegmentHint = getValueIndex(aInput, aSegmentHint);
+        return easeFromIndex(aInput, aSegmentHint * 3);
+    }
 
-        T_parameter startOnCurveX = mXValues.at(aValueIndex);
-        T_parameter startOffCurveX = mXValues.at(aValueIndex + 1);
-        T_parameter endOffCurveX = mXValues.at(aValueIndex + 2);
-        T_parameter endOnCurveX = mXValues.at(aValueIndex + 3);
-        T_parameter t =
-            getCubicRoots(startOnCurveX - aInput, startOffCurveX - aInput,
-                          endOffCurveX - aInput, endOnCurveX - aInput)
-                .at(0);
+    T_parameter easeFromIndex(T_parameter aInput, size_t aValueIndex) const
+    {
+        assert(aValueIndex + 3 <= (mOnCurveCount - 1) * 3);
+
+        T_parameter startOnCurve = mYValues[aValueIndex];
+        T_parameter startOffCurve = mYValues[aValueIndex + 1];
+        T_parameter endOffCurve = mYValues[aValueIndex + 2];
+        T_parameter endOnCurve = mYValues[aValueIndex + 3];
+
+        T_parameter startOnCurveX = mXValues[aValueIndex];
+        T_parameter startOffCurveX = mXValues[aValueIndex + 1];
+        T_parameter endOffCurveX = mXValues[aValueIndex + 2];
+        T_parameter endOnCurveX = mXValues[aValueIndex + 3];
+        T_parameter t = (mSolver == BezierSolver::Newton) ?
+            solveNewton(aInput, aValueIndex)
+            : getCubicRoots(startOnCurveX - aInput, startOffCurveX - aInput,
+                            endOffCurveX - aInput, endOnCurveX - aInput)
+                  .at(0);
 
         T_parameter tSqr = t * t;
         T_parameter OneMinusT = 1 - t;
@@ -74,15 +144,132 @@ struct Bezier
                + endOffCurve * 3 * OneMinusT * tSqr + endOnCurve * t * tSqr;
     }
 
+    /// \brief The index of the segment containing `aInput`, in O(log n).
+    ///
+    /// It is the segment before the first on-curve point (after the start) which is not before `aInput`.
+    /// Inputs past the end are in the last segment.
     size_t getValueIndex(T_parameter aInput) const
     {
-        size_t currentIndex = 0;
-        while (currentIndex < mOnCurveCount - 1
-               && mXValues.at((currentIndex + 1) * 3) < aInput)
+        // Binary search on the on-curve points, which are sorted by x.
+        size_t low = 1;
+        size_t high = mOnCurveCount - 1;
+        while (low < high)
+        {
+            const size_t middle = (low + high) / 2;
+            if (mXValues[middle * 3] < aInput)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low - 1;
+    }
+
+    /// \brief Same as getValueIndex(aInput), but first tests the segment `aHint` and the next one.
+    size_t getValueIndex(T_parameter aInput, size_t aHint) const
+    {
+        const size_t lastSegment = mOnCurveCount - 2;
+        auto contains = [&](size_t aSegment)
         {
-            currentIndex++;
+            return aSegment <= lastSegment
+                && (aSegment == 0 || mXValues[aSegment * 3] < aInput)
+                && (aSegment == lastSegment || !(mXValues[(aSegment + 1) * 3] < aInput));
+        };
+
+        if (contains(aHint))
+        {
+            return aHint;
+        }
+        else if (contains(aHint + 1))
+        {
+            return aHint + 1;
         }
-        return currentIndex;
+        return getValueIndex(aInput);
+    }
+
+    /// \brief x of the segment starting at `aValueIndex`, at parameter `aT`.
+    T_parameter evaluateX(T_parameter aT, size_t aValueIndex) const
+    {
+        const T_parameter oneMinusT = 1 - aT;
+        return mXValues[aValueIndex] * oneMinusT * oneMinusT * oneMinusT
+               + mXValues[aValueIndex + 1] * 3 * oneMinusT * oneMinusT * aT
+               + mXValues[aValueIndex + 2] * 3 * oneMinusT * aT * aT
+               + mXValues[aValueIndex + 3] * aT * aT * aT;
+    }
+
+    /// \brief Derivative of x with respect to t, for the segment starting at `aValueIndex`.
+    T_parameter evaluateXDerivative(T_parameter aT, size_t aValueIndex) const
+    {
+        const T_parameter oneMinusT = 1 - aT;
+        return 3 * (mXValues[aValueIndex + 1] - mXValues[aValueIndex]) * oneMinusT * oneMinusT
+               + 6 * (mXValues[aValueIndex + 2] - mXValues[aValueIndex + 1]) * oneMinusT * aT
+               + 3 * (mXValues[aValueIndex + 3] - mXValues[aValueIndex + 2]) * aT * aT;
+    }
+
+    /// \brief Parameter t of the segment starting at `aValueIndex` where x(t) is `aInput`.
+    ///
+    /// The initial guess interpolates the segment sample table, which also brackets the solution.
+    /// It is refined by Newton-Raphson iterations, or by bisection of the bracket
+    /// if the slope is too flat or an iteration leaves the bracket.
+    /// Inputs outside of the segment give the parameter of its closest end.
+    /// \note Requires the sample table to be up to date, see updateXSamples().
+    T_parameter solveNewton(T_parameter aInput, size_t aValueIndex) const
+    {
+        const T_parameter * samples = mXSamples.data() + (aValueIndex / 3) * sSampleCount;
+        const T_parameter step = T_parameter{1} / (sSampleCount - 1);
+        const T_parameter tolerance = 4 * std::numeric_limits<T_parameter>::epsilon();
+        const T_parameter minSlope = T_parameter{1e-3};
+
+        // Bracket of the solution, assuming x is increasing along the segment.
+        size_t sample = 1;
+        while (sample != sSampleCount - 1 && samples[sample] < aInput)
+        {
+            ++sample;
+        }
+        --sample;
+        T_parameter low = sample * step;
+        T_parameter high = low + step;
+
+        const T_parameter sampleSpan = samples[sample + 1] - samples[sample];
+        T_parameter t = (sampleSpan > T_parameter{0}) ?
+            std::clamp(low + (aInput - samples[sample]) / sampleSpan * step, low, high)
+            : low;
+
+        for (size_t iteration = 0; iteration != sNewtonIterations; ++iteration)
+        {
+            const T_parameter error = evaluateX(t, aValueIndex) - aInput;
+            if (std::abs(error) <= tolerance)
+            {
+                return t;
+            }
+            const T_parameter slope = evaluateXDerivative(t, aValueIndex);
+            if (std::abs(slope) < minSlope)
+            {
+                break;
+            }
+            t -= error / slope;
+            if (t < low || t > high)
+            {
+                break;
+            }
+        }
+
+        for (size_t iteration = 0; iteration != sBisectionIterations && high - low > tolerance; ++iteration)
+        {
+            t = (low + high) / 2;
+            if (evaluateX(t, aValueIndex) < aInput)
+            {
+                low = t;
+            }
+            else
+            {
+                high = t;
+            }
+        }
+        return (low + high) / 2;
     }
 
     size_t addPoint(T_parameter aInput)
@@ -104,6 +291,7 @@ struct Bezier
             mYValues.at(insertIndex) = yValue;
             mYValues.at(insertIndex + 1) = yValue;
             mYValues.at(insertIndex + 2) = yValue;
+            updateXSamples();
 
             return insertIndex + 1;
         }
@@ -121,6 +309,7 @@ struct Bezier
                 mYValues.at(i) = mYValues.at(i + 3);
             }
             mOnCurveCount--;
+            updateXSamples();
         }
     }
 
@@ -135,8 +324,8 @@ struct Bezier
         {
             case 0:
             {
-                float oldX = mXValues.at(index);
-                float oldY = mYValues.at(index);
+                T_parameter oldX = mXValues.at(index);
+                T_parameter oldY = mYValues.at(index);
                 if (index > 0)
                 {
                     mXValues.at(index - 1) = std::clamp((mXValues.at(index - 1) - oldX) + aPosition.x(), T_parameter{0}, T_parameter{1});
@@ -152,19 +341,20 @@ struct Bezier
             }
             case 1:
             {
-                float onX = mXValues.at(index - 1);
+                T_parameter onX = mXValues.at(index - 1);
                 aPosition.x() = std::max(onX, aPosition.x());
                 break;
             }
             case 2:
             {
-                float onX = mXValues.at(index + 1);
+                T_parameter onX = mXValues.at(index + 1);
                 aPosition.x() = std::min(onX, aPosition.x());
                 break;
             }
         }
         mXValues.at(index) = std::clamp(aPosition.x(), T_parameter{0}, T_parameter{1});
         mYValues.at(index) = std::clamp(aPosition.y(), T_parameter{0}, T_parameter{1});
+        updateXSamples();
     }
 
     std::vector<math::Position<2, float>> getKnots() const
@@ -173,12 +363,12 @@ struct Bezier
 
         for (int i = 0; i < (int)mOnCurveCount - 1; i++)
         {
-            ret.push_back({mXValues.at(i * 3), mYValues.at(i * 3)});
-            ret.push_back({mXValues.at(i * 3 + 1), mYValues.at(i * 3 + 1)});
-            ret.push_back({mXValues.at(i * 3 + 2), mYValues.at(i * 3 + 2)});
+            ret.push_back({(float)mXValues.at(i * 3), (float)mYValues.at(i * 3)});
+            ret.push_back({(float)mXValues.at(i * 3 + 1), (float)mYValues.at(i * 3 + 1)});
+            ret.push_back({(float)mXValues.at(i * 3 + 2), (float)mYValues.at(i * 3 + 2)});
         }
 
-        ret.push_back({mXValues.at((mOnCurveCount - 1) * 3), mYValues.at((mOnCurveCount - 1) * 3)});
+        ret.push_back({(float)mXValues.at((mOnCurveCount - 1) * 3), (float)mYValues.at((mOnCurveCount - 1) * 3)});
 
         return ret;
     }
@@ -222,7 +412,18 @@ struct Bezier
         T_parameter u;
         T_parameter v;
         int index = 0;
-        std::array<T_parameter, 3> result;
+        std::array<T_parameter, 3> result{};
+
+        // The roots are computed with single precision constants, so a root at an end of the segment
+        // might be found slightly outside of [0, 1].
+        const T_parameter tolerance = std::sqrt(std::numeric_limits<float>::epsilon());
+        auto addRoot = [&](T_parameter aRoot)
+        {
+            if (aRoot >= -tolerance && aRoot <= 1 + tolerance)
+            {
+                result.at(index++) = std::clamp(aRoot, T_parameter{0}, T_parameter{1});
+            }
+        };
 
         // We need to do everything because sometimes the polynomial
         // has multiple root but only one in 0 -- 1
@@ -237,20 +438,11 @@ struct Bezier
             T_parameter t1 = cubeRoot(r) * 2.f;
 
             root = (t1 * std::cos(phi / 3.f)) - (b / 3.f);
-            if (root >= 0.f && root <= 1.f)
-            {
-                result.at(index++) = root;
-            }
+            addRoot(root);
             root = (t1 * std::cos((phi + 2.f * pi<float>) / 3.f)) - (b / 3.f);
-            if (root >= 0.f && root <= 1.f)
-            {
-                result.at(index++) = root;
-            }
+            addRoot(root);
             root = (t1 * std::cos((phi + 4.f * pi<float>) / 3.f)) - (b / 3.f);
-            if (root >= 0.f && root <= 1.f)
-            {
-                result.at(index++) = root;
-            }
+            addRoot(root);
             return result;
         }
 
@@ -258,15 +450,9 @@ struct Bezier
         {
             u = q2 < 0 ? cubeRoot(-q2) : -cubeRoot(q2);
             root = 2.f * u - b / 3.f;
-            if (root >= 0.f && root <= 1.f)
-            {
-                result.at(index++) = root;
-            }
+            addRoot(root);
             root = -u - b / 3.f;
-            if (root >= 0.f && root <= 1.f)
-            {
-                result.at(index++) = root;
-            }
+            addRoot(root);
         }
 
         T_parameter sd = std::sqrt(discrimant);
@@ -274,10 +460,7 @@ struct Bezier
         v = cubeRoot(q2 + sd);
         root = u - v - b / 3.f;
 
-        if (root >= 0.f && root <= 1.f)
-        {
-            result.at(index++) = root;
-        }
+        addRoot(root);
 
         return result;
     }
@@ -288,16 +471,18 @@ struct Bezier
         aWitness.witness(std::make_pair("mXValues", &mXValues));
         aWitness.witness(std::make_pair("mYValues", &mYValues));
         aWitness.witness(std::make_pair("mOnCurveCount", &mOnCurveCount));
+        // The witness might have modified the points.
+        updateXSamples();
     }
 };
 /// \see https://en.wikipedia.org/wiki/Smoothstep
 template <class T_parameter>
 struct SmoothStep
 {
-    T_parameter ease(T_parameter aInput) const
+    constexpr T_parameter ease(T_parameter aInput) const
     {
-        Clamped<T_parameter> x{aInput};
-        return std::pow(x, 2) * (3 - 2 * x);
+        const T_parameter x = Clamped<T_parameter>{aInput};
+        return x * x * (3 - 2 * x);
     }
 
     std::vector<math::Position<2, float>> getKnots() const
@@ -311,9 +496,31 @@ struct SmoothStep
     }
 };
 
+/// \brief Regime of a ease::MassSpringDamper, from its damping ratio.
+enum class DampingRegime
+{
+    /// \brief Oscillates around the target, with an exponentially decaying amplitude.
+    Underdamped,
+    /// \brief Fastest convergence without oscillation.
+    Critical,
+    /// \brief Converges without oscillation, slowed down by the dampening.
+    Overdamped,
+};
+
+/// \brief Response of a mass attached to a spring and a damper, released with a displacement of -1
+/// from its rest position and `mInitialVelocity`.
+///
+/// The input in [0, 1] is mapped to the lifetime of the system, which is the time for its
+/// slowest decay to reach 1/1024.
+/// The regime and the constants of the closed form solution are computed once, by updateCoefficients().
+/// \attention updateCoefficients() must be called after the public members are modified.
+///
+/// \see Stepper to advance the system with a fixed time step, without evaluating transcendental functions.
 template <class T_parameter>
 struct MassSpringDamper
 {
+    class Stepper;
+
     MassSpringDamper(
         T_parameter aMass,
         T_parameter aSpringStrength,
@@ -324,28 +531,101 @@ struct MassSpringDamper
         mSpringStrength{aSpringStrength},
         mDampening{aDampening}
     {
-        assert(mDampening < std::sqrt(T_parameter{4} * mSpringStrength * mMass));
+        updateCoefficients();
+    }
+
+    /// \brief Compute the regime and the constants of the solution from the public members.
+    void updateCoefficients()
+    {
         assert(mMass > T_parameter{0});
+        assert(mSpringStrength > T_parameter{0});
+        assert(mDampening > T_parameter{0});
+
+        // The displacement u from the rest position follows u'' + 2 * decay * u' + naturalFreq^2 * u = 0
+        mDecayRate = mDampening / (2 * mMass);
+        const T_parameter naturalFrequencySquared = mSpringStrength / mMass;
+        const T_parameter discriminant = mDecayRate * mDecayRate - naturalFrequencySquared;
+        const T_parameter tolerance =
+            16 * std::numeric_limits<T_parameter>::epsilon() * naturalFrequencySquared;
+
+        T_parameter slowestDecay = mDecayRate;
+        if (discriminant < -tolerance)
+        {
+            mRegime = DampingRegime::Underdamped;
+            mFrequency = std::sqrt(-discriminant);
+        }
+        else if (discriminant <= tolerance)
+        {
+            mRegime = DampingRegime::Critical;
+            mFrequency = T_parameter{0};
+        }
+        else
+        {
+            mRegime = DampingRegime::Overdamped;
+            mFrequency = std::sqrt(discriminant);
+            slowestDecay = mDecayRate - mFrequency;
+        }
+
+        // This 10 times log(2)/decay waits for the slowest decay to reach 1/1024
+        mLifetime = T_parameter{10} * (T_parameter{0.69314718056} / slowestDecay);
+
+        const T_parameter u0{-1};
+        switch (mRegime)
+        {
+            case DampingRegime::Underdamped:
+            {
+                // u = e^(-decay t) * (u0 cos(w t) + b sin(w t)), written as a single phase shifted cosine.
+                const T_parameter b = (mInitialVelocity + mDecayRate * u0) / mFrequency;
+                mFirst = std::sqrt(u0 * u0 + b * b);
+                mSecond = std::atan2(b, u0);
+                break;
+            }
+            case DampingRegime::Critical:
+                // u = e^(-decay t) * (u0 + b t)
+                mFirst = u0;
+                mSecond = mInitialVelocity + mDecayRate * u0;
+                break;
+            case DampingRegime::Overdamped:
+            {
+                // u = c1 e^(r1 t) + c2 e^(r2 t), with r1 the slowest decay.
+                const T_parameter r1 = -mDecayRate + mFrequency;
+                const T_parameter r2 = -mDecayRate - mFrequency;
+                mFirst = (mInitialVelocity - r2 * u0) / (r1 - r2);
+                mSecond = u0 - mFirst;
+                break;
+            }
+        }
     }
 
     T_parameter ease(T_parameter aInput) const
     {
-        T_parameter mDecayRate = mDampening / (2 * mMass);
-        T_parameter mAngularFreq =
-            sqrt((T_parameter{4} * mSpringStrength * mMass) - std::pow(mDampening, T_parameter{2})) 
-            / (T_parameter{2} * mMass);
-        // This 10 times log(2)/mDecayRate this wait for the decay to reach 1/1024
-        T_parameter mLifetime =
-        T_parameter{10} * (T_parameter{0.69314718056} / mDecayRate);
-        T_parameter t = aInput * mLifetime;
-        const T_parameter g1{1};
-        T_parameter value =
-            g1 + (-g1 * std::exp(-mDecayRate * t) * std::cos(mAngularFreq * t))
-            + (((mInitialVelocity + mDecayRate * -g1) / mAngularFreq)
-                  * std::exp(-mDecayRate * t) * std::sin(mAngularFreq * t));
-        return value;
+        const T_parameter t = aInput * mLifetime;
+        switch (mRegime)
+        {
+            case DampingRegime::Underdamped:
+                return T_parameter{1}
+                       + mFirst * std::exp(-mDecayRate * t) * std::cos(mFrequency * t - mSecond);
+            case DampingRegime::Critical:
+                return T_parameter{1} + std::exp(-mDecayRate * t) * (mFirst + mSecond * t);
+            case DampingRegime::Overdamped:
+            default:
+                return T_parameter{1}
+                       + mFirst * std::exp((mFrequency - mDecayRate) * t)
+                       + mSecond * std::exp((-mDecayRate - mFrequency) * t);
+        }
     }
 
+    DampingRegime getRegime() const
+    { return mRegime; }
+
+    /// \brief Duration of the simulated motion mapped to the input range [0, 1].
+    T_parameter getLifetime() const
+    { return mLifetime; }
+
+    /// \brief The transition matrix advancing (displacement, velocity) by `aDuration`,
+    /// in row major order.
+    std::array<T_parameter, 4> getTransition(T_parameter aDuration) const;
+
     T_parameter mInitialVelocity;
     T_parameter mMass;
     T_parameter mSpringStrength;
@@ -359,9 +639,193 @@ struct MassSpringDamper
         aWitness.witness(std::make_pair("mMass", &mMass));
         aWitness.witness(std::make_pair("mSpringStrength", &mSpringStrength));
         aWitness.witness(std::make_pair("mDampening", &mDampening));
+        // The witness might have modified the public members.
+        updateCoefficients();
     }
+
+private:
+    DampingRegime mRegime;
+    T_parameter mDecayRate;
+    // Damped angular frequency when underdamped, half the distance between the decay rates when overdamped.
+    T_parameter mFrequency;
+    T_parameter mLifetime;
+    // Constants of the solution, depending on the regime.
+    T_parameter mFirst;
+    T_parameter mSecond;
 };
 
+
+/// \brief Advance a ease::MassSpringDamper by a fixed input step, for fixed time step simulations.
+///
+/// The (displacement, velocity) state is multiplied by a transition matrix computed at construction,
+/// which is exact for the linear system: there are no transcendental function evaluation per step.
+/// \note The rounding errors accumulate with the steps, but they decay with the motion.
+template <class T_parameter>
+class MassSpringDamper<T_parameter>::Stepper
+{
+public:
+    /// \param aInputStep The advance of the easing input at each step, so the state after `n` steps
+    /// is the one eased at `n * aInputStep`.
+    Stepper(const MassSpringDamper & aSpring, T_parameter aInputStep) :
+        mTransition{aSpring.getTransition(aInputStep * aSpring.getLifetime())},
+        mDisplacement{T_parameter{-1}},
+        mVelocity{aSpring.mInitialVelocity}
+    {}
+
+    /// \brief Advance by one step.
+    /// \return The eased value after the step.
+    T_parameter step()
+    {
+        const T_parameter displacement = mTransition[0] * mDisplacement + mTransition[1] * mVelocity;
+        mVelocity = mTransition[2] * mDisplacement + mTransition[3] * mVelocity;
+        mDisplacement = displacement;
+        return value();
+    }
+
+    /// \brief The eased value at the current step.
+    T_parameter value() const
+    { return T_parameter{1} + mDisplacement; }
+
+    /// \brief The velocity of the simulated mass at the current step (per unit of simulated time).
+    T_parameter velocity() const
+    { return mVelocity; }
+
+private:
+    std::array<T_parameter, 4> mTransition;
+    T_parameter mDisplacement;
+    T_parameter mVelocity;
+};
+
+
+template <class T_parameter>
+std::array<T_parameter, 4> MassSpringDamper<T_parameter>::getTransition(T_parameter aDuration) const
+{
+    // Columns are the (displacement, velocity) after aDuration, when starting from (1, 0) and (0, 1).
+    const T_parameter decay = std::exp(-mDecayRate * aDuration);
+    const T_parameter naturalFrequencySquared = mSpringStrength / mMass;
+    switch (mRegime)
+    {
+        case DampingRegime::Underdamped:
+        {
+            const T_parameter cosine = std::cos(mFrequency * aDuration);
+            const T_parameter sine = std::sin(mFrequency * aDuration) / mFrequency;
+            return {
+                decay * (cosine + mDecayRate * sine), decay * sine,
+                -decay * naturalFrequencySquared * sine, decay * (cosine - mDecayRate * sine),
+            };
+        }
+        case DampingRegime::Critical:
+            return {
+                decay * (1 + mDecayRate * aDuration), decay * aDuration,
+                -decay * mDecayRate * mDecayRate * aDuration, decay * (1 - mDecayRate * aDuration),
+            };
+        case DampingRegime::Overdamped:
+        default:
+        {
+            const T_parameter r1 = -mDecayRate + mFrequency;
+            const T_parameter r2 = -mDecayRate - mFrequency;
+            const T_parameter e1 = std::exp(r1 * aDuration);
+            const T_parameter e2 = std::exp(r2 * aDuration);
+            const T_parameter width = r1 - r2;
+            return {
+                (r1 * e2 - r2 * e1) / width, (e1 - e2) / width,
+                r1 * r2 * (e2 - e1) / width, (r1 * e1 - r2 * e2) / width,
+            };
+        }
+    }
+}
+
+namespace detail {
+
+    /// \brief Solve the tridiagonal system giving the second derivatives of a cubic spline at its knots
+    /// (Thomas algorithm).
+    ///
+    /// The knots are accessed through `aX(i)` and `aY(i)`, and the second derivatives are written
+    /// in place to `aSecondDerivative(i)`, which must return a reference.
+    /// `aScratch` must point to at least `aCount` values, holding the modified upper diagonal.
+    /// A null end slope gives a natural end (null second derivative), otherwise the end is clamped to this slope.
+    template <class T_parameter, class F_x, class F_y, class F_secondDerivative>
+    void solveSplineSecondDerivatives(size_t aCount,
+                                      F_x && aX,
+                                      F_y && aY,
+                                      F_secondDerivative && aSecondDerivative,
+                                      T_parameter * aScratch,
+                                      T_parameter aStartSlope,
+                                      T_parameter aEndSlope)
+    {
+        T_parameter newX = aX(1);
+        T_parameter newY = aY(1);
+        T_parameter cj = aX(1) - aX(0);
+        T_parameter newDj = (aY(1) - aY(0)) / cj;
+
+        if (aStartSlope == T_parameter{0})
+        {
+            aScratch[0] = T_parameter{0};
+            aSecondDerivative(0) = T_parameter{0};
+        }
+        else
+        {
+            aScratch[0] = T_parameter{0.5};
+            aSecondDerivative(0) = T_parameter{3 * (newDj - aStartSlope) / cj};
+        }
+
+        for (size_t i = 1; i < aCount - 1; i++)
+        {
+            T_parameter oldX = newX;
+            T_parameter oldY = newY;
+
+            T_parameter aj = cj;
+            T_parameter oldDj = newDj;
+
+            newX = aX(i + 1);
+            newY = aY(i + 1);
+
+            cj = newX - oldX;
+            newDj = (newY - oldY) / cj;
+            T_parameter bj = T_parameter{2} * (cj + aj);
+            T_parameter invDenom =
+                T_parameter{1} / (bj - (aj * aScratch[i - 1]));
+            T_parameter dj = T_parameter{6} * (newDj - oldDj);
+
+            aSecondDerivative(i) =
+                (dj - aj * aSecondDerivative(i - 1)) * invDenom;
+            aScratch[i] = cj * invDenom;
+        }
+
+        size_t lastElementIndex = aCount - 1;
+        if (aEndSlope == T_parameter{0})
+        {
+            aScratch[lastElementIndex] = 0;
+            aSecondDerivative(lastElementIndex) = 0;
+        }
+        else
+        {
+            T_parameter aj = cj;
+            T_parameter oldDj = newDj;
+
+            cj = 0;
+            newDj = aEndSlope;
+            T_parameter bj = T_parameter{2} * (cj + aj);
+            T_parameter invDenom =
+                T_parameter{1}
+                / (bj - aj * aScratch[lastElementIndex - 1]);
+            T_parameter dj = T_parameter{6} * (newDj - oldDj);
+
+            aSecondDerivative(lastElementIndex) =
+                (dj - aj * aSecondDerivative(lastElementIndex - 1)) * invDenom;
+            aScratch[lastElementIndex] = cj * invDenom;
+        }
+
+        for (int i = (int) aCount - 2; i >= 0; i--)
+        {
+            aSecondDerivative(i) =
+                aSecondDerivative(i) - aScratch[i] * aSecondDerivative(i + 1);
+        }
+    }
+
+} // namespace detail
+
+
 template <class T_parameter>
 struct CubicSpline
 {
@@ -377,7 +841,7 @@ struct CubicSpline
         computeSecDerivative();
     }
 
-    CubicSpline(std::vector<Position<2, float>> aValues,
+    CubicSpline(const std::vector<Position<2, float>> & aValues,
                 T_parameter aX0Prime = T_parameter{0},
                 T_parameter aXNPrime = T_parameter{0}) :
         x0Prime{aX0Prime}, xNPrime{aXNPrime}
@@ -399,7 +863,7 @@ struct CubicSpline
 
         for (int i = 0; i < xValues.size(); i++)
         {
-            ret.push_back({xValues.at(i), yValues.at(i)});
+            ret.push_back({(float)xValues.at(i), (float)yValues.at(i)});
         }
 
         return ret;
@@ -411,119 +875,265 @@ struct CubicSpline
         assert(xValues.size() > 2);
 
         size_t valLength = xValues.size();
-        for (int i = 0; i < valLength - 1; i++)
+        for (size_t i = 0; i < valLength - 1; i++)
         {
             assert(xValues.at(i) < xValues.at(i + 1));
         }
 
-        std::vector<T_parameter> cPrime(valLength, 0);
-        std::vector<T_parameter> yPrimePrime(valLength, 0);
+        fppValues.resize(valLength);
+        std::vector<T_parameter> cPrime(valLength);
+        detail::solveSplineSecondDerivatives(
+            valLength,
+            [this](size_t aIndex){ return xValues[aIndex]; },
+            [this](size_t aIndex){ return yValues[aIndex]; },
+            [this](size_t aIndex) -> T_parameter & { return fppValues[aIndex]; },
+            cPrime.data(),
+            x0Prime,
+            xNPrime);
+    }
+
+    T_parameter ease(T_parameter aInput) const
+    {
+        return easeFromIndex(aInput, getValueIndex(aInput));
+    }
+
+    /// \brief Ease `aInput`, using and updating `aSegmentHint` to find its segment.
+    ///
+    /// When successive inputs are monotonic (e.g. time), keeping the hint makes the lookup constant time.
+    T_parameter ease(T_parameter aInput, size_t & aSegmentHint) const
+    {
+        aSegmentHint = getValueIndex(aInput, aSegmentHint);
+        return easeFromIndex(aInput, aSegmentHint);
+    }
+
+    T_parameter easeFromIndex(T_parameter aInput, size_t aValueIndex) const
+    {
+        assert(aValueIndex + 1 < xValues.size());
+        return interpSpline(
+            aInput, xValues[aValueIndex], xValues[aValueIndex + 1],
+            yValues[aValueIndex], yValues[aValueIndex + 1],
+            fppValues[aValueIndex], fppValues[aValueIndex + 1]);
+    }
 
-        T_parameter newX = xValues.at(1);
-        T_parameter newY = yValues.at(1);
-        T_parameter cj = xValues.at(1) - xValues.at(0);
-        T_parameter newDj = (yValues.at(1) - yValues.at(0)) / cj;
+    static constexpr T_parameter oneSixth = T_parameter{1} / T_parameter{6};
 
-        if (x0Prime == T_parameter{0})
+    /// \brief Evaluate the cubic between knots (x0, y0) and (x1, y1), from the second derivatives at the knots.
+    static T_parameter interpSpline(T_parameter aInput,
+                                    T_parameter aX0, T_parameter aX1,
+                                    T_parameter aY0, T_parameter aY1,
+                                    T_parameter aYpp0, T_parameter aYpp1)
+    {
+        const T_parameter h = aX1 - aX0;
+        const T_parameter a = (aX1 - aInput) / h;
+        const T_parameter b = T_parameter{1} - a;
+        return a * aY0 + b * aY1
+               + ((a * a * a - a) * aYpp0 + (b * b * b - b) * aYpp1) * (h * h) * oneSixth;
+    }
+
+    /// \brief The index of the segment containing `aInput`, in O(log n).
+    ///
+    /// It is the segment before the first knot (after the first one) which is not before `aInput`.
+    /// Inputs past the end are in the last segment.
+    size_t getValueIndex(T_parameter aInput) const
+    {
+        auto firstNotBefore = std::lower_bound(xValues.begin() + 1, xValues.end() - 1, aInput);
+        return static_cast<size_t>(firstNotBefore - xValues.begin()) - 1;
+    }
+
+    /// \brief Same as getValueIndex(aInput), but first tests the segment `aHint` and the next one.
+    size_t getValueIndex(T_parameter aInput, size_t aHint) const
+    {
+        const size_t lastSegment = xValues.size() - 2;
+        auto contains = [&](size_t aSegment)
         {
-            cPrime.at(0) = T_parameter{0};
-            yPrimePrime.at(0) = T_parameter{0};
-        }
-        else
+            return aSegment <= lastSegment
+                && (aSegment == 0 || xValues[aSegment] < aInput)
+                && (aSegment == lastSegment || !(xValues[aSegment + 1] < aInput));
+        };
+
+        if (contains(aHint))
         {
-            cPrime.at(0) = T_parameter{0.5};
-            yPrimePrime.at(0) = T_parameter{3 * (newDj - x0Prime) / cj};
+            return aHint;
         }
-
-        for (int i = 1; i < valLength - 1; i++)
+        else if (contains(aHint + 1))
         {
-            T_parameter oldX = newX;
-            T_parameter oldY = newY;
+            return aHint + 1;
+        }
+        return getValueIndex(aInput);
+    }
 
-            T_parameter aj = cj;
-            T_parameter oldDj = newDj;
+    size_t addPoint(T_parameter aValue) {return -1;}
 
-            newX = xValues.at(i + 1);
-            newY = yValues.at(i + 1);
+    void changePoint(size_t index, math::Position<2, T_parameter> aPoint) {}
 
-            cj = newX - oldX;
-            newDj = (newY - oldY) / cj;
-            T_parameter bj = T_parameter{2} * (cj + aj);
-            T_parameter invDenom =
-                T_parameter{1} / (bj - (aj * cPrime.at(i - 1)));
-            T_parameter dj = T_parameter{6} * (newDj - oldDj);
+    std::vector<T_parameter> xValues;
+    std::vector<T_parameter> yValues;
+    // double derivatives values
+    std::vector<T_parameter> fppValues;
+    T_parameter x0Prime;
+    T_parameter xNPrime;
+};
 
-            yPrimePrime.at(i) =
-                (dj - aj * yPrimePrime.at(i - 1)) * invDenom;
-            cPrime.at(i) = cj * invDenom;
-        }
+/// \brief Cubic spline easing with a fixed capacity of knots, which never allocates.
+///
+/// Contrary to CubicSpline, the knot positions and second derivatives are interleaved,
+/// so evaluating a segment reads two contiguous knots.
+/// The second derivatives are solved in place in the knot storage, with a scratch buffer on the stack.
+/// \see CubicSpline for the end slopes semantic.
+///
+/// The constructors throw std::length_error if the knot count is not in [3, N_maxKnots],
+/// and std::invalid_argument if the x and y values have different sizes.
+template <class T_parameter, size_t N_maxKnots = 16>
+class FixedCubicSpline
+{
+    static_assert(N_maxKnots > 2, "A cubic spline requires at least 3 knots.");
 
-        size_t lastElementIndex = valLength - 1;
-        if (xNPrime == T_parameter{0})
+public:
+    struct Knot
+    {
+        T_parameter mX;
+        T_parameter mY;
+        T_parameter mSecondDerivative;
+    };
+
+    FixedCubicSpline(std::span<const T_parameter> aXValues,
+                     std::span<const T_parameter> aYValues,
+                     T_parameter aX0Prime = T_parameter{0},
+                     T_parameter aXNPrime = T_parameter{0}) :
+        mKnotCount{checkKnotCount(aXValues.size())},
+        mX0Prime{aX0Prime},
+        mXNPrime{aXNPrime}
+    {
+        if (aXValues.size() != aYValues.size())
         {
-            cPrime.at(lastElementIndex) = 0;
-            yPrimePrime.at(lastElementIndex) = 0;
+            throw std::invalid_argument{__func__ + std::string{": x and y values must have the same size."}};
         }
-        else
+        for (size_t i = 0; i != mKnotCount; ++i)
         {
-            T_parameter aj = cj;
-            T_parameter oldDj = newDj;
-
-            cj = 0;
-            newDj = xNPrime;
-            T_parameter bj = T_parameter{2} * (cj + aj);
-            T_parameter invDenom =
-                T_parameter{1}
-                / (bj - aj * cPrime.at(lastElementIndex - 1));
-            T_parameter dj = T_parameter{6} * (newDj - oldDj);
-
-            yPrimePrime.at(lastElementIndex) =
-                (dj - aj * yPrimePrime.at(lastElementIndex - 1)) * invDenom;
-            cPrime.at(lastElementIndex) = cj * invDenom;
+            mKnots[i] = {aXValues[i], aYValues[i], T_parameter{0}};
         }
+        computeSecDerivative();
+    }
 
-        for (int i = (int) valLength - 2; i >= 0; i--)
+    FixedCubicSpline(std::span<const Position<2, T_parameter>> aValues,
+                     T_parameter aX0Prime = T_parameter{0},
+                     T_parameter aXNPrime = T_parameter{0}) :
+        mKnotCount{checkKnotCount(aValues.size())},
+        mX0Prime{aX0Prime},
+        mXNPrime{aXNPrime}
+    {
+        for (size_t i = 0; i != mKnotCount; ++i)
         {
-            yPrimePrime.at(i) =
-                yPrimePrime.at(i) - cPrime.at(i) * yPrimePrime.at(i + 1);
+            mKnots[i] = {aValues[i].x(), aValues[i].y(), T_parameter{0}};
         }
-
-        fppValues = yPrimePrime;
+        computeSecDerivative();
     }
 
     T_parameter ease(T_parameter aInput) const
     {
-        size_t valueIndex = getValueIndex(aInput);
-        return interpSpline(
-            aInput, xValues.at(valueIndex), xValues.at(valueIndex + 1),
-            yValues.at(valueIndex), yValues.at(valueIndex + 1),
-            fppValues.at(valueIndex), fppValues.at(valueIndex + 1));
+        return easeFromIndex(aInput, getValueIndex(aInput));
     }
 
-    static constexpr T_parameter oneSixth = T_parameter{1} / T_parameter{6};
+    /// \brief Ease `aInput`, using and updating `aSegmentHint` to find its segment.
+    /// \see CubicSpline::ease(T_parameter, size_t &)
+    T_parameter ease(T_parameter aInput, size_t & aSegmentHint) const
+    {
+        aSegmentHint = getValueIndex(aInput, aSegmentHint);
+        return easeFromIndex(aInput, aSegmentHint);
+    }
 
+    T_parameter easeFromIndex(T_parameter aInput, size_t aValueIndex) const
+    {
+        assert(aValueIndex + 1 < mKnotCount);
+        const Knot & start = mKnots[aValueIndex];
+        const Knot & end = mKnots[aValueIndex + 1];
+        return CubicSpline<T_parameter>::interpSpline(aInput,
+                                                      start.mX, end.mX,
+                                                      start.mY, end.mY,
+                                                      start.mSecondDerivative, end.mSecondDerivative);
+    }
+
+    /// \see CubicSpline::getValueIndex()
     size_t getValueIndex(T_parameter aInput) const
     {
-        size_t index = 0;
+        auto firstNotBefore = std::lower_bound(mKnots.begin() + 1, mKnots.begin() + mKnotCount - 1, aInput,
+                                               [](const Knot & aKnot, T_parameter aValue)
+                                               {
+                                                   return aKnot.mX < aValue;
+                                               });
+        return static_cast<size_t>(firstNotBefore - mKnots.begin()) - 1;
+    }
+
+    /// \brief Same as getValueIndex(aInput), but first tests the segment `aHint` and the next one.
+    size_t getValueIndex(T_parameter aInput, size_t aHint) const
+    {
+        const size_t lastSegment = mKnotCount - 2;
+        auto contains = [&](size_t aSegment)
+        {
+            return aSegment <= lastSegment
+                && (aSegment == 0 || mKnots[aSegment].mX < aInput)
+                && (aSegment == lastSegment || !(mKnots[aSegment + 1].mX < aInput));
+        };
+
+        if (contains(aHint))
+        {
+            return aHint;
+        }
+        else if (contains(aHint + 1))
+        {
+            return aHint + 1;
+        }
+        return getValueIndex(aInput);
+    }
 
-        while (index + 1 < xValues.size() && xValues.at(index + 1) < aInput)
+    std::vector<math::Position<2, float>> getKnots() const
+    {
+        std::vector<math::Position<2, float>> ret;
+        for (size_t i = 0; i != mKnotCount; ++i)
         {
-            index++;
+            ret.push_back({(float)mKnots[i].mX, (float)mKnots[i].mY});
         }
+        return ret;
+    }
 
-        return index;
+    std::span<const Knot> getKnotData() const
+    {
+        return {mKnots.data(), mKnotCount};
     }
 
-    size_t addPoint(T_parameter aValue) {return -1;}
+private:
+    /// \brief Validate the number of knots provided to a constructor, before they are copied.
+    static size_t checkKnotCount(size_t aKnotCount)
+    {
+        if (aKnotCount <= 2 || aKnotCount > N_maxKnots)
+        {
+            throw std::length_error{__func__ + std::string{": the knot count must be in [3, N_maxKnots]."}};
+        }
+        return aKnotCount;
+    }
 
-    void changePoint(size_t index, math::Position<2, T_parameter> aPoint) {}
+    void computeSecDerivative()
+    {
+        for (size_t i = 0; i + 1 < mKnotCount; ++i)
+        {
+            assert(mKnots[i].mX < mKnots[i + 1].mX);
+        }
 
-    std::vector<T_parameter> xValues;
-    std::vector<T_parameter> yValues;
-    // double derivatives values
-    std::vector<T_parameter> fppValues;
-    T_parameter x0Prime;
-    T_parameter xNPrime;
+        std::array<T_parameter, N_maxKnots> cPrime;
+        detail::solveSplineSecondDerivatives(
+            mKnotCount,
+            [this](size_t aIndex){ return mKnots[aIndex].mX; },
+            [this](size_t aIndex){ return mKnots[aIndex].mY; },
+            [this](size_t aIndex) -> T_parameter & { return mKnots[aIndex].mSecondDerivative; },
+            cPrime.data(),
+            mX0Prime,
+            mXNPrime);
+    }
+
+    std::array<Knot, N_maxKnots> mKnots;
+    size_t mKnotCount;
+    T_parameter mX0Prime;
+    T_parameter mXNPrime;
 };
 } // namespace ease
 
@@ -538,6 +1148,47 @@ struct Repeat
     {
         return aAbsoluteValue - std::floor(aAbsoluteValue / aPeriod) * aPeriod;
     }
+
+    /// \brief Same as above, multiplying by the reciprocal of the period instead of dividing.
+    ///
+    /// The result is kept in [0, aPeriod[ when the rounding of the reciprocal
+    /// would place it one period off.
+    ///
+    /// For `float`, the number of periods is floored with a conversion to a 32 bits integer,
+    /// and only integer operations depend on comparisons. Loops over this function can then be vectorized
+    /// without rounding instructions nor relaxed floating point exceptions (see repeat()).
+    /// \note For `float`, values of at least 2^23 periods are wrapped to 0: consecutive floats are then
+    /// at least a period apart, so there is no phase left to preserve.
+    /// Infinities and NaN are also wrapped to 0.
+    T_parameter operator()(T_parameter aPeriod,
+                           T_parameter aInversePeriod,
+                           T_parameter aAbsoluteValue) const
+    {
+        if constexpr (std::is_same_v<T_parameter, float>)
+        {
+            // Also keeps the integer conversion below in range (it is undefined behaviour otherwise).
+            // The input is masked with integer operations, so the compiler does not turn it into a branch.
+            constexpr float maxPeriods = 8388608.f; // 2^23
+            const float unbounded = aAbsoluteValue * aInversePeriod;
+            const std::int32_t keep = -static_cast<std::int32_t>(std::abs(unbounded) < maxPeriods);
+            const float value = std::bit_cast<float>(std::bit_cast<std::int32_t>(aAbsoluteValue) & keep);
+            const float quotient = std::bit_cast<float>(std::bit_cast<std::int32_t>(unbounded) & keep);
+
+            // Truncation, then rounding toward negative infinity.
+            std::int32_t periods = static_cast<std::int32_t>(quotient);
+            periods -= (quotient < static_cast<float>(periods));
+            const float wrapped = value - static_cast<float>(periods) * aPeriod;
+            periods += (wrapped >= aPeriod) - (wrapped < 0.f);
+            return value - static_cast<float>(periods) * aPeriod;
+        }
+        else
+        {
+            T_parameter wrapped =
+                aAbsoluteValue - std::floor(aAbsoluteValue * aInversePeriod) * aPeriod;
+            wrapped = (wrapped < T_parameter{0}) ? wrapped + aPeriod : wrapped;
+            return (wrapped >= aPeriod) ? wrapped - aPeriod : wrapped;
+        }
+    }
 };
 
 template <class T_parameter>
@@ -554,7 +1205,88 @@ struct PingPong
         return doublePeriod
                - 2 * std::max(T_parameter{0}, doublePeriod - aPeriod);
     }
+
+    /// \brief Same as above, multiplying by the reciprocal of the period instead of dividing.
+    T_parameter operator()(T_parameter aPeriod,
+                           T_parameter aInversePeriod,
+                           T_parameter aAbsoluteValue) const
+    {
+        T_parameter doublePeriod =
+            Repeat<T_parameter>{}(2 * aPeriod, aInversePeriod / 2, aAbsoluteValue);
+
+        // Same as above, written as a selection so it is vectorized.
+        return std::min(doublePeriod, 2 * aPeriod - doublePeriod);
+    }
 };
+
+
+/// \brief Apply periodic::Repeat with `aPeriod` to each of `aValues`,
+/// writing the result at the same index in `aResults`.
+///
+/// The reciprocal of the period is computed once, and the loop is written to be vectorized by the compiler.
+/// \note With GCC `-O3` on baseline x86-64 (SSE2), the loop is vectorized for `float`.
+/// For `double`, the conversions to integers are not vectorized on SSE2 and measured slower
+/// than std::floor, which is kept: the loop is scalar unless the compiler can vectorize std::floor
+/// (SSE4.1, and e.g. GCC `-fno-trapping-math`).
+template <class T_parameter>
+void repeat(T_parameter aPeriod,
+            std::span<const T_parameter> aValues,
+            std::span<T_parameter> aResults);
+
+
+/// \brief Apply periodic::PingPong with `aPeriod` to each of `aValues`,
+/// writing the result at the same index in `aResults`.
+///
+/// \see repeat() regarding vectorization.
+template <class T_parameter>
+void pingPong(T_parameter aPeriod,
+              std::span<const T_parameter> aValues,
+              std::span<T_parameter> aResults);
+
+
+//
+// Implementations
+//
+namespace detail {
+
+    template <template <class> class TT_periodicity, class T_parameter>
+    void wrapAll(T_parameter aPeriod,
+                 std::span<const T_parameter> aValues,
+                 std::span<T_parameter> aResults)
+    {
+        assert(aValues.size() == aResults.size());
+
+        const TT_periodicity<T_parameter> periodicity;
+        const T_parameter inversePeriod = T_parameter{1} / aPeriod;
+        const T_parameter * values = aValues.data();
+        T_parameter * results = aResults.data();
+        for (std::size_t valueId = 0; valueId != aValues.size(); ++valueId)
+        {
+            results[valueId] = periodicity(aPeriod, inversePeriod, values[valueId]);
+        }
+    }
+
+} // namespace detail
+
+
+template <class T_parameter>
+void repeat(T_parameter aPeriod,
+            std::span<const T_parameter> aValues,
+            std::span<T_parameter> aResults)
+{
+    detail::wrapAll<Repeat>(aPeriod, aValues, aResults);
+}
+
+
+template <class T_parameter>
+void pingPong(T_parameter aPeriod,
+              std::span<const T_parameter> aValues,
+              std::span<T_parameter> aResults)
+{
+    detail::wrapAll<PingPong>(aPeriod, aValues, aResults);
+}
+
+
 } // namespace periodic
 
 /// \brief Enumaration to control wether ParameterAnimation output should be
@@ -600,9 +1332,6 @@ protected:
 };
 } // namespace detail
 
-// TODO Implement a "dynamic" version (non-templated, having data members to
-// control behaviour)
-
 // TODO Find a more descriptive type name.
 /// \brief Animate a 1D parameter value, with speed factor, and optional easing
 /// and periodicity. The output might be clamped to [0 1] (notably useful for
@@ -610,6 +1339,7 @@ protected:
 ///
 /// This is intended to cover most realistic cases, thanks to the different
 /// available combinations.
+/// \see DynamicParameterAnimation, when the combination is only known at runtime.
 template <class T_parameter,
           AnimationResult N_resultRange,
           template <class> class TT_periodicity = None,
@@ -647,6 +1377,13 @@ class ParameterAnimation
         return !IsClamped() && !IsPeriodic() && !IsEasing();
     }
 
+    /// \brief Floating point parameters are normalized by multiplying with the cached reciprocal of the period.
+    /// \note Other parameter types (e.g. FixedPoint) would lose precision in the reciprocal, so they divide.
+    static constexpr bool IsInversePeriodCached()
+    {
+        return std::is_floating_point_v<T_parameter>;
+    }
+
 public:
     // Note: must be available before its use in ctors.
     static constexpr bool HasSpeed() { return !IsClamped(); }
@@ -656,7 +1393,8 @@ public:
     template <bool N_isClamped = IsClamped()>
     explicit ParameterAnimation(T_parameter aPeriod,
                                 std::enable_if_t<N_isClamped> * = nullptr) :
-        mPeriod{std::move(aPeriod)}
+        mPeriod{std::move(aPeriod)},
+        mInversePeriod{T_parameter{1} / mPeriod}
     {}
 
     template <bool N_isClamped = IsClamped()>
@@ -664,7 +1402,8 @@ public:
                                 T_parameter aPeriod = T_parameter{1},
                                 std::enable_if_t<N_isClamped> * = nullptr) :
         mEaser{aEaseFunctor},
-        mPeriod{std::move(aPeriod)}
+        mPeriod{std::move(aPeriod)},
+        mInversePeriod{T_parameter{1} / mPeriod}
     {}
 
     /// \brief Constructor from a period (i.e. duration) plus an optional speed.
@@ -673,7 +1412,9 @@ public:
     explicit ParameterAnimation(T_parameter aPeriod,
                                 T_parameter aSpeed = T_parameter{1},
                                 std::enable_if_t<N_hasSpeed> * = nullptr) :
-        Base_t{std::move(aSpeed)}, mPeriod{std::move(aPeriod)}
+        Base_t{std::move(aSpeed)},
+        mPeriod{std::move(aPeriod)},
+        mInversePeriod{T_parameter{1} / mPeriod}
     {}
 
     template <bool N_hasSpeed = HasSpeed()>
@@ -683,7 +1424,8 @@ public:
                                 std::enable_if_t<N_hasSpeed> * = nullptr) :
         Base_t{std::move(aSpeed)},
         mEaser{aEaseFunctor},
-        mPeriod{std::move(aPeriod)}
+        mPeriod{std::move(aPeriod)},
+        mInversePeriod{T_parameter{1} / mPeriod}
     {}
 
     template <bool N_isEasing = IsEasing()>
@@ -706,7 +1448,15 @@ public:
 
         if constexpr (IsPeriodic())
         {
-            aInput = mPeriodicBehaviour(mPeriod, aInput);
+            if constexpr (IsInversePeriodCached()
+                          && requires { mPeriodicBehaviour(mPeriod, mInversePeriod, aInput); })
+            {
+                aInput = mPeriodicBehaviour(mPeriod, mInversePeriod, aInput);
+            }
+            else
+            {
+                aInput = mPeriodicBehaviour(mPeriod, aInput);
+            }
         }
 
         if constexpr (IsEasing())
@@ -716,7 +1466,7 @@ public:
                           "normalization.");
 
             // Need to normalize the easing input
-            aInput = mEaser.ease(aInput / mPeriod);
+            aInput = mEaser.ease(normalize(aInput));
 
             if constexpr (N_resultRange == FullRange)
             {
@@ -730,7 +1480,7 @@ public:
             // Normalize the input despite absence of easing, as the output
             // should be clamped. This is equivalent to multiplying by a speed
             // factor that would be 1/period.
-            aInput /= mPeriod;
+            aInput = normalize(aInput);
         }
 
         return aInput;
@@ -811,6 +1561,8 @@ public:
         {
             w.witness(std::make_pair("mEaser", &mEaser));
         }
+        // The witness might have modified the period.
+        mInversePeriod = T_parameter{1} / mPeriod;
     }
 
     const T_parameter & getPeriod()
@@ -821,7 +1573,20 @@ public:
     TT_easeFunctor<T_parameter> mEaser;
 
 private:
+    T_parameter normalize(T_parameter aInput) const
+    {
+        if constexpr (IsInversePeriodCached())
+        {
+            return aInput * mInversePeriod;
+        }
+        else
+        {
+            return aInput / mPeriod;
+        }
+    }
+
     T_parameter mPeriod;
+    T_parameter mInversePeriod;
     TT_periodicity<T_parameter>
         mPeriodicBehaviour; // empty class for basic initial cases (Repeat,
                             // PingPong) but leaves room for more potential
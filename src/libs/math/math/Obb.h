@@ -0,0 +1,280 @@
+#pragma once
+
+
+#include "Base.h"
+#include "LinearMatrix.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Oriented bounding box, i.e. a box with arbitrary orientation.
+///
+/// It is defined by its center, its axes (u, v, w), and its half extent along each axis.
+template <class T_number = real_number>
+struct Obb
+{
+    using Position_t = Position<3, T_number>;
+
+    static constexpr std::size_t gCornerCount = 8;
+
+    T_number volume() const
+    { return 8 * mHalfExtents.x() * mHalfExtents.y() * mHalfExtents.z(); }
+
+    /// \brief The rotation bringing the canonical axes (X, Y, Z) onto the box axes (u, v, w).
+    Quaternion<T_number> orientation() const;
+
+    template <class T_positionValue>
+    bool contains(Position<3, T_positionValue> aPosition) const;
+
+    /// \return Corner position, indexed as [-u, +u] x [-v, +v] x [-w, +w] (u varying fastest).
+    Position_t cornerAt(std::size_t aCornerIdx) const;
+
+    /// \brief Fit a box to the points, aligning its axes on the principal components of the points.
+    ///
+    /// The axes are the eigenvectors of the covariance matrix, by decreasing eigenvalue.
+    /// \note Principal component analysis is fast, but the result is sensitive to the points distribution
+    /// (e.g. dense clusters), it is not the minimal volume box.
+    static Obb FromPointsPca(std::span<const Position_t> aPoints);
+
+    Position_t mCenter;
+    OrthonormalBase<3, T_number> mAxes;
+    Vec<3, T_number> mHalfExtents;
+};
+
+
+namespace detail {
+
+
+    template <class T_number>
+    struct SymmetricEigen
+    {
+        /// \brief The eigenvalues, by decreasing value.
+        Vec<3, T_number> values;
+        /// \brief The i-th row is the eigenvector for the i-th eigen value.
+        Matrix<3, 3, T_number> vectors;
+    };
+
+
+    /// \brief Eigen decomposition of a 3x3 symmetric matrix, with the cyclic Jacobi method.
+    ///
+    /// The eigenvectors are orthonormal, and form a right-handed basis.
+    /// \see Numerical Recipes 3rd p570
+    template <class T_number>
+    SymmetricEigen<T_number> computeSymmetricEigen(Matrix<3, 3, T_number> aMatrix)
+    {
+        assert(aMatrix.isSymmetric());
+
+        // The columns accumulate the eigenvectors.
+        Matrix<3, 3, T_number> vectors = Matrix<3, 3, T_number>::Identity();
+
+        T_number total{0};
+        for (T_number element : aMatrix)
+        {
+            total += element * element;
+        }
+
+        constexpr int gMaxSweeps = 32;
+        for (int sweep = 0; sweep != gMaxSweeps; ++sweep)
+        {
+            T_number offDiagonal = 2 * (aMatrix.at(0, 1) * aMatrix.at(0, 1)
+                                        + aMatrix.at(0, 2) * aMatrix.at(0, 2)
+                                        + aMatrix.at(1, 2) * aMatrix.at(1, 2));
+            if (offDiagonal <= std::numeric_limits<T_number>::epsilon() * total)
+            {
+                break;
+            }
+
+            for (std::size_t p = 0; p != 2; ++p)
+            {
+                for (std::size_t q = p + 1; q != 3; ++q)
+                {
+                    const T_number apq = aMatrix.at(p, q);
+                    if (apq == T_number{0})
+                    {
+                        continue;
+                    }
+
+                    // Rotation annihilating the (p, q) element
+                    const T_number theta = (aMatrix.at(q, q) - aMatrix.at(p, p)) / (2 * apq);
+                    const T_number t = std::copysign(T_number{1}, theta)
+                                       / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                    const T_number c = 1 / std::sqrt(t * t + 1);
+                    const T_number s = t * c;
+
+                    Matrix<3, 3, T_number> rotation = Matrix<3, 3, T_number>::Identity();
+                    rotation.at(p, p) = c;
+                    rotation.at(q, q) = c;
+                    rotation.at(p, q) = s;
+                    rotation.at(q, p) = -s;
+
+                    aMatrix = rotation.transpose() * aMatrix * rotation;
+                    // Enforce the exact zero, and symmetry
+                    aMatrix.at(p, q) = aMatrix.at(q, p) = T_number{0};
+                    vectors *= rotation;
+                }
+            }
+        }
+
+        std::array<std::size_t, 3> order{0, 1, 2};
+        std::sort(order.begin(), order.end(), [&](std::size_t aLhs, std::size_t aRhs)
+        {
+            return aMatrix.at(aLhs, aLhs) > aMatrix.at(aRhs, aRhs);
+        });
+
+        SymmetricEigen<T_number> result{
+            {aMatrix.at(order[0], order[0]), aMatrix.at(order[1], order[1]), aMatrix.at(order[2], order[2])},
+            Matrix<3, 3, T_number>::Zero(),
+        };
+        for (std::size_t row = 0; row != 3; ++row)
+        {
+            for (std::size_t col = 0; col != 3; ++col)
+            {
+                result.vectors.at(row, col) = vectors.at(col, order[row]);
+            }
+        }
+
+        // Make the basis right-handed, flipping the last vector if needed.
+        Vec<3, T_number> u{result.vectors.at(0, 0), result.vectors.at(0, 1), result.vectors.at(0, 2)};
+        Vec<3, T_number> v{result.vectors.at(1, 0), result.vectors.at(1, 1), result.vectors.at(1, 2)};
+        Vec<3, T_number> w = u.cross(v);
+        for (std::size_t col = 0; col != 3; ++col)
+        {
+            result.vectors.at(2, col) = w[col];
+        }
+
+        return result;
+    }
+
+
+} // namespace detail
+
+
+//
+// Implementations
+//
+template <class T_number>
+Quaternion<T_number> Obb<T_number>::orientation() const
+{
+    const UnitVec<3, T_number> u = mAxes.u();
+    const UnitVec<3, T_number> v = mAxes.v();
+    const UnitVec<3, T_number> w = mAxes.w();
+    return toQuaternion(LinearMatrix<3, 3, T_number>{
+        u.x(), u.y(), u.z(),
+        v.x(), v.y(), v.z(),
+        w.x(), w.y(), w.z(),
+    });
+}
+
+
+template <class T_number>
+template <class T_positionValue>
+bool Obb<T_number>::contains(Position<3, T_positionValue> aPosition) const
+{
+    const Vec<3, T_number> local = aPosition - mCenter;
+    return std::abs(local.dot(mAxes.u())) <= mHalfExtents.x()
+        && std::abs(local.dot(mAxes.v())) <= mHalfExtents.y()
+        && std::abs(local.dot(mAxes.w())) <= mHalfExtents.z();
+}
+
+
+template <class T_number>
+auto Obb<T_number>::cornerAt(std::size_t aCornerIdx) const -> Position_t
+{
+    if (aCornerIdx >= gCornerCount)
+    {
+        throw std::domain_error{__func__ + std::string{": obb corners are indexed (0, 7)."}};
+    }
+
+    auto sign = [aCornerIdx](std::size_t aBit)
+    {
+        return (aCornerIdx & (std::size_t{1} << aBit)) ? T_number{1} : T_number{-1};
+    };
+
+    return mCenter
+        + sign(0) * mHalfExtents.x() * mAxes.u()
+        + sign(1) * mHalfExtents.y() * mAxes.v()
+        + sign(2) * mHalfExtents.z() * mAxes.w();
+}
+
+
+template <class T_number>
+Obb<T_number> Obb<T_number>::FromPointsPca(std::span<const Position_t> aPoints)
+{
+    assert(!aPoints.empty());
+
+    Vec<3, T_number> mean = Vec<3, T_number>::Zero();
+    for (const Position_t & point : aPoints)
+    {
+        mean += point.template as<Vec>();
+    }
+    mean /= static_cast<T_number>(aPoints.size());
+
+    // Two passes, which is numerically more robust than accumulating raw moments.
+    Matrix<3, 3, T_number> covariance = Matrix<3, 3, T_number>::Zero();
+    for (const Position_t & point : aPoints)
+    {
+        const Vec<3, T_number> centered = point.template as<Vec>() - mean;
+        covariance += centered.outer(centered);
+    }
+    covariance /= static_cast<T_number>(aPoints.size());
+
+    const detail::SymmetricEigen<T_number> eigen = detail::computeSymmetricEigen(covariance);
+    const Vec<3, T_number> axes[3] = {
+        {eigen.vectors.at(0, 0), eigen.vectors.at(0, 1), eigen.vectors.at(0, 2)},
+        {eigen.vectors.at(1, 0), eigen.vectors.at(1, 1), eigen.vectors.at(1, 2)},
+        {eigen.vectors.at(2, 0), eigen.vectors.at(2, 1), eigen.vectors.at(2, 2)},
+    };
+
+    // Extent of the points projected on each axis.
+    Vec<3, T_number> low = Vec<3, T_number>::Zero();
+    Vec<3, T_number> high = Vec<3, T_number>::Zero();
+    for (std::size_t axis = 0; axis != 3; ++axis)
+    {
+        low[axis] = high[axis] = aPoints.front().template as<Vec>().dot(axes[axis]);
+    }
+    for (const Position_t & point : aPoints)
+    {
+        for (std::size_t axis = 0; axis != 3; ++axis)
+        {
+            const T_number projected = point.template as<Vec>().dot(axes[axis]);
+            low[axis] = std::min(low[axis], projected);
+            high[axis] = std::max(high[axis], projected);
+        }
+    }
+
+    Position_t center = Position_t::Zero();
+    for (std::size_t axis = 0; axis != 3; ++axis)
+    {
+        center += ((low[axis] + high[axis]) / 2) * axes[axis];
+    }
+
+    return Obb{
+        center,
+        // (u, v, w) is right-handed, so MakeFromWUp() recomputes u as v x w.
+        OrthonormalBase<3, T_number>::MakeFromWUp(axes[2], axes[1]),
+        (high - low) / 2,
+    };
+}
+
+
+template <class T_number>
+std::ostream & operator<<(std::ostream & os, const Obb<T_number> & aObb)
+{
+    return os << "[ {" << aObb.mCenter << "}, u{" << aObb.mAxes.u() << "}, v{" << aObb.mAxes.v()
+              << "}, w{" << aObb.mAxes.w() << "}, {" << aObb.mHalfExtents << "} ]";
+}
+
+
+} // namespace math
+} // namespace ad
@@ -0,0 +1,456 @@
+#pragma once
+
+
+#include "Box.h"
+#include "Sphere.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+
+
+// Closest point and distance queries between primitives.
+//
+// Each query has a batch variant, testing one primitive against a span of primitives,
+// and writing the results to a caller provided span of the same size.
+// The batch loops have no dependency between iterations. GCC vectorizes the point-box and sphere-box ones
+// at -O3. The box-box loop is branchless too, but is not vectorized: its interleaved loads of the 6 values
+// of each box are not supported by the vectorizer.
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Line segment between two positions.
+template <int N_dimension, class T_number = real_number>
+struct Segment
+{
+    using Position_t = Position<N_dimension, T_number>;
+
+    Vec<N_dimension, T_number> direction() const
+    { return mB - mA; }
+
+    /// \brief Position at `aParameter` along the segment, i.e. `mA` at 0 and `mB` at 1.
+    Position_t at(T_number aParameter) const
+    { return mA + aParameter * direction(); }
+
+    bool operator==(const Segment & aRhs) const
+    { return mA == aRhs.mA && mB == aRhs.mB; }
+    bool operator!=(const Segment & aRhs) const
+    { return !(*this == aRhs); }
+
+    Position_t mA;
+    Position_t mB;
+};
+
+
+/// \brief The pair of closest points between two primitives, with their squared distance.
+template <int N_dimension, class T_number = real_number>
+struct ClosestPoints
+{
+    Position<N_dimension, T_number> mOnFirst;
+    Position<N_dimension, T_number> mOnSecond;
+    T_number mDistanceSquared;
+};
+
+
+/// \brief Closest position to `aPosition` on the (non-degenerate) triangle (a, b, c).
+/// \see Ericson, Real-Time Collision Detection, 5.1.5
+template <int N_dimension, class T_number>
+Position<N_dimension, T_number> closestPoint(Position<N_dimension, T_number> aPosition,
+                                             Position<N_dimension, T_number> aPointA,
+                                             Position<N_dimension, T_number> aPointB,
+                                             Position<N_dimension, T_number> aPointC);
+
+template <int N_dimension, class T_number>
+void closestPoint(std::span<const Position<N_dimension, T_number>> aPositions,
+                  Position<N_dimension, T_number> aPointA,
+                  Position<N_dimension, T_number> aPointB,
+                  Position<N_dimension, T_number> aPointC,
+                  std::span<Position<N_dimension, T_number>> aResults);
+
+
+/// \brief Closest points between two segments, the first point being on `aFirst`.
+///
+/// If the segments are parallel, one of the closest pairs is returned.
+/// \see Ericson, Real-Time Collision Detection, 5.1.9
+template <int N_dimension, class T_number>
+ClosestPoints<N_dimension, T_number> closestPoints(const Segment<N_dimension, T_number> & aFirst,
+                                                   const Segment<N_dimension, T_number> & aSecond);
+
+template <int N_dimension, class T_number>
+void closestPoints(const Segment<N_dimension, T_number> & aFirst,
+                   std::span<const Segment<N_dimension, T_number>> aSeconds,
+                   std::span<ClosestPoints<N_dimension, T_number>> aResults);
+
+
+/// \brief Closest points between a segment and a box, the first point being on `aSegment`.
+///
+/// The squared distance along the segment is a convex piecewise quadratic function,
+/// whose pieces are delimited by the intersections of the segment with the box slabs.
+/// Each piece is minimized exactly.
+template <class T_number>
+ClosestPoints<3, T_number> closestPoints(const Segment<3, T_number> & aSegment, const Box<T_number> & aBox);
+
+template <class T_number>
+void closestPoints(const Box<T_number> & aBox,
+                   std::span<const Segment<3, T_number>> aSegments,
+                   std::span<ClosestPoints<3, T_number>> aResults);
+
+
+template <class T_number>
+T_number distanceSquared(Position<3, T_number> aPosition, const Box<T_number> & aBox);
+
+template <class T_number>
+void distanceSquared(const Box<T_number> & aBox,
+                     std::span<const Position<3, T_number>> aPositions,
+                     std::span<T_number> aResults);
+
+
+/// \brief Squared distance between the boxes, zero if they overlap.
+template <class T_number>
+T_number distanceSquared(const Box<T_number> & aLhs, const Box<T_number> & aRhs);
+
+template <class T_number>
+void distanceSquared(const Box<T_number> & aBox,
+                     std::span<const Box<T_number>> aBoxes,
+                     std::span<T_number> aResults);
+
+
+/// \brief Test whether the sphere and the box share at least a position (touching counts).
+template <class T_number>
+bool overlaps(const Sphere<3, T_number> & aSphere, const Box<T_number> & aBox);
+
+template <class T_number>
+void overlaps(const Box<T_number> & aBox,
+              std::span<const Sphere<3, T_number>> aSpheres,
+              std::span<bool> aResults);
+
+
+//
+// Implementations
+//
+template <int N_dimension, class T_number>
+Position<N_dimension, T_number> closestPoint(Position<N_dimension, T_number> aPosition,
+                                             Position<N_dimension, T_number> aPointA,
+                                             Position<N_dimension, T_number> aPointB,
+                                             Position<N_dimension, T_number> aPointC)
+{
+    const Vec<N_dimension, T_number> ab = aPointB - aPointA;
+    const Vec<N_dimension, T_number> ac = aPointC - aPointA;
+
+    // Vertex region A
+    const Vec<N_dimension, T_number> ap = aPosition - aPointA;
+    const T_number d1 = ab.dot(ap);
+    const T_number d2 = ac.dot(ap);
+    if (d1 <= T_number{0} && d2 <= T_number{0})
+    {
+        return aPointA;
+    }
+
+    // Vertex region B
+    const Vec<N_dimension, T_number> bp = aPosition - aPointB;
+    const T_number d3 = ab.dot(bp);
+    const T_number d4 = ac.dot(bp);
+    if (d3 >= T_number{0} && d4 <= d3)
+    {
+        return aPointB;
+    }
+
+    // Edge region AB
+    const T_number vc = d1 * d4 - d3 * d2;
+    if (vc <= T_number{0} && d1 >= T_number{0} && d3 <= T_number{0})
+    {
+        return aPointA + (d1 / (d1 - d3)) * ab;
+    }
+
+    // Vertex region C
+    const Vec<N_dimension, T_number> cp = aPosition - aPointC;
+    const T_number d5 = ab.dot(cp);
+    const T_number d6 = ac.dot(cp);
+    if (d6 >= T_number{0} && d5 <= d6)
+    {
+        return aPointC;
+    }
+
+    // Edge region AC
+    const T_number vb = d5 * d2 - d1 * d6;
+    if (vb <= T_number{0} && d2 >= T_number{0} && d6 <= T_number{0})
+    {
+        return aPointA + (d2 / (d2 - d6)) * ac;
+    }
+
+    // Edge region BC
+    const T_number va = d3 * d6 - d5 * d4;
+    if (va <= T_number{0} && (d4 - d3) >= T_number{0} && (d5 - d6) >= T_number{0})
+    {
+        return aPointB + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (aPointC - aPointB);
+    }
+
+    // Face region
+    const T_number denominator = T_number{1} / (va + vb + vc);
+    return aPointA + (vb * denominator) * ab + (vc * denominator) * ac;
+}
+
+
+template <int N_dimension, class T_number>
+void closestPoint(std::span<const Position<N_dimension, T_number>> aPositions,
+                  Position<N_dimension, T_number> aPointA,
+                  Position<N_dimension, T_number> aPointB,
+                  Position<N_dimension, T_number> aPointC,
+                  std::span<Position<N_dimension, T_number>> aResults)
+{
+    assert(aPositions.size() == aResults.size());
+    for (std::size_t positionId = 0; positionId != aPositions.size(); ++positionId)
+    {
+        aResults[positionId] = closestPoint(aPositions[positionId], aPointA, aPointB, aPointC);
+    }
+}
+
+
+template <int N_dimension, class T_number>
+ClosestPoints<N_dimension, T_number> closestPoints(const Segment<N_dimension, T_number> & aFirst,
+                                                   const Segment<N_dimension, T_number> & aSecond)
+{
+    const Vec<N_dimension, T_number> d1 = aFirst.direction();
+    const Vec<N_dimension, T_number> d2 = aSecond.direction();
+    const Vec<N_dimension, T_number> r = aFirst.mA - aSecond.mA;
+    const T_number a = d1.getNormSquared();
+    const T_number e = d2.getNormSquared();
+    const T_number f = d2.dot(r);
+
+    // Squared lengths below epsilon are considered degenerate segments (i.e. points).
+    const T_number epsilon = std::numeric_limits<T_number>::epsilon();
+
+    T_number s{0};
+    T_number t{0};
+    if (a <= epsilon && e <= epsilon)
+    {
+        // Both segments are points
+    }
+    else if (a <= epsilon)
+    {
+        t = std::clamp(f / e, T_number{0}, T_number{1});
+    }
+    else
+    {
+        const T_number c = d1.dot(r);
+        if (e <= epsilon)
+        {
+            s = std::clamp(-c / a, T_number{0}, T_number{1});
+        }
+        else
+        {
+            const T_number b = d1.dot(d2);
+            const T_number denominator = a * e - b * b;
+            // For parallel segments, pick an arbitrary s (here 0).
+            if (denominator != T_number{0})
+            {
+                s = std::clamp((b * f - c * e) / denominator, T_number{0}, T_number{1});
+            }
+
+            t = (b * s + f) / e;
+            // If t is out of [0, 1], clamp it and recompute s for this new t.
+            if (t < T_number{0})
+            {
+                t = T_number{0};
+                s = std::clamp(-c / a, T_number{0}, T_number{1});
+            }
+            else if (t > T_number{1})
+            {
+                t = T_number{1};
+                s = std::clamp((b - c) / a, T_number{0}, T_number{1});
+            }
+        }
+    }
+
+    const Position<N_dimension, T_number> onFirst = aFirst.mA + s * d1;
+    const Position<N_dimension, T_number> onSecond = aSecond.mA + t * d2;
+    return {onFirst, onSecond, (onFirst - onSecond).getNormSquared()};
+}
+
+
+template <int N_dimension, class T_number>
+void closestPoints(const Segment<N_dimension, T_number> & aFirst,
+                   std::span<const Segment<N_dimension, T_number>> aSeconds,
+                   std::span<ClosestPoints<N_dimension, T_number>> aResults)
+{
+    assert(aSeconds.size() == aResults.size());
+    for (std::size_t segmentId = 0; segmentId != aSeconds.size(); ++segmentId)
+    {
+        aResults[segmentId] = closestPoints(aFirst, aSeconds[segmentId]);
+    }
+}
+
+
+template <class T_number>
+ClosestPoints<3, T_number> closestPoints(const Segment<3, T_number> & aSegment, const Box<T_number> & aBox)
+{
+    const Position<3, T_number> low = aBox.mPosition;
+    const Position<3, T_number> high = aBox.mPosition + aBox.mDimension.template as<Vec>();
+    const Vec<3, T_number> direction = aSegment.direction();
+
+    // Parameters where the segment crosses a slab plane, delimiting the quadratic pieces.
+    std::array<T_number, 8> breaks;
+    std::size_t breakCount = 0;
+    breaks[breakCount++] = T_number{0};
+    breaks[breakCount++] = T_number{1};
+    for (std::size_t axis = 0; axis != 3; ++axis)
+    {
+        if (direction[axis] != T_number{0})
+        {
+            for (T_number plane : {low[axis], high[axis]})
+            {
+                const T_number parameter = (plane - aSegment.mA[axis]) / direction[axis];
+                if (parameter > T_number{0} && parameter < T_number{1})
+                {
+                    breaks[breakCount++] = parameter;
+                }
+            }
+        }
+    }
+    std::sort(breaks.begin(), breaks.begin() + breakCount);
+
+    T_number bestParameter{0};
+    T_number bestDistanceSquared = distanceSquared(aSegment.mA, aBox);
+    for (std::size_t pieceId = 0; pieceId + 1 < breakCount; ++pieceId)
+    {
+        const T_number begin = breaks[pieceId];
+        const T_number end = breaks[pieceId + 1];
+        const Position<3, T_number> middle = aSegment.at((begin + end) / 2);
+
+        // On this piece, each axis contributes either nothing, or its squared distance to a fixed plane.
+        T_number slope{0};
+        T_number offset{0};
+        for (std::size_t axis = 0; axis != 3; ++axis)
+        {
+            T_number plane;
+            if (middle[axis] < low[axis])
+            {
+                plane = low[axis];
+            }
+            else if (middle[axis] > high[axis])
+            {
+                plane = high[axis];
+            }
+            else
+            {
+                continue;
+            }
+            slope += direction[axis] * direction[axis];
+            offset += direction[axis] * (aSegment.mA[axis] - plane);
+        }
+
+        const T_number parameter = slope > T_number{0} ? std::clamp(-offset / slope, begin, end) : begin;
+        const T_number candidate = distanceSquared(aSegment.at(parameter), aBox);
+        if (candidate < bestDistanceSquared)
+        {
+            bestDistanceSquared = candidate;
+            bestParameter = parameter;
+        }
+    }
+
+    const Position<3, T_number> onSegment = aSegment.at(bestParameter);
+    return {onSegment, aBox.closestPoint(onSegment), bestDistanceSquared};
+}
+
+
+template <class T_number>
+void closestPoints(const Box<T_number> & aBox,
+                   std::span<const Segment<3, T_number>> aSegments,
+                   std::span<ClosestPoints<3, T_number>> aResults)
+{
+    assert(aSegments.size() == aResults.size());
+    for (std::size_t segmentId = 0; segmentId != aSegments.size(); ++segmentId)
+    {
+        aResults[segmentId] = closestPoints(aSegments[segmentId], aBox);
+    }
+}
+
+
+template <class T_number>
+T_number distanceSquared(Position<3, T_number> aPosition, const Box<T_number> & aBox)
+{
+    T_number result{0};
+    for (std::size_t axis = 0; axis != 3; ++axis)
+    {
+        const T_number low = aBox.mPosition[axis];
+        const T_number high = low + aBox.mDimension[axis];
+        // At most one of the two terms is positive.
+        const T_number excess = std::max(low - aPosition[axis], T_number{0})
+                                + std::max(aPosition[axis] - high, T_number{0});
+        result += excess * excess;
+    }
+    return result;
+}
+
+
+template <class T_number>
+void distanceSquared(const Box<T_number> & aBox,
+                     std::span<const Position<3, T_number>> aPositions,
+                     std::span<T_number> aResults)
+{
+    assert(aPositions.size() == aResults.size());
+    for (std::size_t positionId = 0; positionId != aPositions.size(); ++positionId)
+    {
+        aResults[positionId] = distanceSquared(aPositions[positionId], aBox);
+    }
+}
+
+
+template <class T_number>
+T_number distanceSquared(const Box<T_number> & aLhs, const Box<T_number> & aRhs)
+{
+    T_number result{0};
+    for (std::size_t axis = 0; axis != 3; ++axis)
+    {
+        const T_number lhsLow = aLhs.mPosition[axis];
+        const T_number rhsLow = aRhs.mPosition[axis];
+        const T_number gap = std::max(lhsLow - (rhsLow + aRhs.mDimension[axis]), T_number{0})
+                             + std::max(rhsLow - (lhsLow + aLhs.mDimension[axis]), T_number{0});
+        result += gap * gap;
+    }
+    return result;
+}
+
+
+template <class T_number>
+void distanceSquared(const Box<T_number> & aBox,
+                     std::span<const Box<T_number>> aBoxes,
+                     std::span<T_number> aResults)
+{
+    assert(aBoxes.size() == aResults.size());
+    for (std::size_t boxId = 0; boxId != aBoxes.size(); ++boxId)
+    {
+        aResults[boxId] = distanceSquared(aBox, aBoxes[boxId]);
+    }
+}
+
+
+template <class T_number>
+bool overlaps(const Sphere<3, T_number> & aSphere, const Box<T_number> & aBox)
+{
+    return distanceSquared(aSphere.mCenter, aBox) <= aSphere.mRadius * aSphere.mRadius;
+}
+
+
+template <class T_number>
+void overlaps(const Box<T_number> & aBox,
+              std::span<const Sphere<3, T_number>> aSpheres,
+              std::span<bool> aResults)
+{
+    assert(aSpheres.size() == aResults.size());
+    for (std::size_t sphereId = 0; sphereId != aSpheres.size(); ++sphereId)
+    {
+        aResults[sphereId] = overlaps(aSpheres[sphereId], aBox);
+    }
+}
+
+
+} // namespace math
+} // namespace ad
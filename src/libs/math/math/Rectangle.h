@@ -2,6 +2,10 @@
 
 #include "Vector.h"
 
+#include <algorithm>
+#include <cassert>
+#include <span>
+
 namespace ad {
 namespace math {
 
@@ -86,6 +90,9 @@ struct Rectangle
     /// \brief Construct a Rectangle of provided dimension, centered on origin (0, 0).
     static Rectangle CenterOnOrigin(Size<2, T_number> aDimension);
 
+    /// \brief Construct the smallest Rectangle containing all of `aPoints`, which must not be empty.
+    static Rectangle FromPoints(std::span<const Position<2, T_number>> aPoints);
+
     template <class T_positionValue>
     bool contains(Position<2, T_positionValue> aPosition) const;
 
@@ -113,6 +120,25 @@ Rectangle<T_number> Rectangle<T_number>::CenterOnOrigin(Size<2, T_number> aDimen
 }
 
 
+template <class T_number>
+Rectangle<T_number> Rectangle<T_number>::FromPoints(std::span<const Position<2, T_number>> aPoints)
+{
+    assert(!aPoints.empty());
+
+    // see Box::FromPoints(), the loop is not vectorized either.
+    Position<2, T_number> low = aPoints.front();
+    Position<2, T_number> high = low;
+    for (const Position<2, T_number> & point : aPoints)
+    {
+        low.x() = std::min(low.x(), point.x());
+        low.y() = std::min(low.y(), point.y());
+        high.x() = std::max(high.x(), point.x());
+        high.y() = std::max(high.y(), point.y());
+    }
+    return {low, (high - low).template as<Size>()};
+}
+
+
 template <class T_number>
 template <class T_positionValue>
 bool Rectangle<T_number>::contains(Position<2, T_positionValue> aPosition) const
@@ -0,0 +1,393 @@
+#pragma once
+
+
+#include "Rectangle.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Pack rectangles in a bin, maintaining its "skyline" (the top contour of placed rectangles).
+///
+/// Each rectangle is placed at the lowest position where it fits (bottom-left heuristic).
+/// The search is a single pass over the skyline segments, sliding a window the width of the
+/// inserted rectangle and maintaining the window maximum in a monotonic queue.
+///
+/// It is fast and memory-light, but the space below overhangs is lost.
+template <class T_number = int>
+class SkylinePacker
+{
+    static_assert(std::is_integral_v<T_number>, "Packing is implemented for integral coordinates.");
+
+public:
+    using value_type = T_number;
+
+    explicit SkylinePacker(Size<2, T_number> aBinSize);
+
+    /// \brief Place a rectangle of `aSize` in the bin.
+    /// \return The placed rectangle, or an empty optional if it does not fit.
+    std::optional<Rectangle<T_number>> insert(Size<2, T_number> aSize);
+
+    /// \brief Remove all placed rectangles.
+    void reset();
+
+    Size<2, T_number> binSize() const
+    { return mBinSize; }
+
+    /// \brief The summed area of all the placed rectangles.
+    T_number usedArea() const
+    { return mUsedArea; }
+
+private:
+    struct Segment
+    {
+        T_number x;
+        T_number y;
+        T_number width;
+
+        T_number xMax() const
+        { return x + width; }
+    };
+
+    Size<2, T_number> mBinSize;
+    std::vector<Segment> mSkyline;
+    T_number mUsedArea{0};
+};
+
+
+/// \brief Pack rectangles in a bin, maintaining the list of maximal free rectangles.
+///
+/// Each rectangle is placed in the free rectangle where it leaves the shortest leftover side
+/// (best short side fit), which gives tighter packings than SkylinePacker, at a higher cost.
+template <class T_number = int>
+class MaxRectsPacker
+{
+    static_assert(std::is_integral_v<T_number>, "Packing is implemented for integral coordinates.");
+
+public:
+    using value_type = T_number;
+
+    explicit MaxRectsPacker(Size<2, T_number> aBinSize);
+
+    /// \brief Place a rectangle of `aSize` in the bin.
+    /// \return The placed rectangle, or an empty optional if it does not fit.
+    std::optional<Rectangle<T_number>> insert(Size<2, T_number> aSize);
+
+    /// \brief Remove all placed rectangles.
+    void reset();
+
+    Size<2, T_number> binSize() const
+    { return mBinSize; }
+
+    /// \brief The summed area of all the placed rectangles.
+    T_number usedArea() const
+    { return mUsedArea; }
+
+    std::span<const Rectangle<T_number>> freeRectangles() const
+    { return mFreeRectangles; }
+
+private:
+    /// \brief Remove all free rectangles intersecting `aPlaced`, storing the free space around
+    /// `aPlaced` as new rectangles in mSplit.
+    void splitFreeRectangles(const Rectangle<T_number> & aPlaced);
+
+    /// \brief Move the rectangles from mSplit to the free rectangles,
+    /// except the ones contained in another free rectangle.
+    void pruneFreeRectangles();
+
+    Size<2, T_number> mBinSize;
+    std::vector<Rectangle<T_number>> mFreeRectangles;
+    // Scratch storage for the rectangles resulting from a split.
+    std::vector<Rectangle<T_number>> mSplit;
+    T_number mUsedArea{0};
+};
+
+
+/// \brief Insert all `aSizes` in `aPacker`, by decreasing height then width.
+///
+/// Sorting usually produces significantly denser packings than inserting in arbitrary order.
+/// \return The placements, in the order of `aSizes`.
+template <class T_packer>
+std::vector<std::optional<Rectangle<typename T_packer::value_type>>>
+insertBatch(T_packer & aPacker, std::span<const Size<2, typename T_packer::value_type>> aSizes);
+
+
+//
+// Implementations
+//
+template <class T_number>
+SkylinePacker<T_number>::SkylinePacker(Size<2, T_number> aBinSize) :
+    mBinSize{aBinSize}
+{
+    reset();
+}
+
+
+template <class T_number>
+void SkylinePacker<T_number>::reset()
+{
+    mSkyline.assign(1, Segment{T_number{0}, T_number{0}, mBinSize.width()});
+    mUsedArea = 0;
+}
+
+
+template <class T_number>
+std::optional<Rectangle<T_number>> SkylinePacker<T_number>::insert(Size<2, T_number> aSize)
+{
+    if (aSize.width() <= 0 || aSize.height() <= 0 || aSize.width() > mBinSize.width())
+    {
+        return std::nullopt;
+    }
+
+    // Sliding window [first, last) of segments covering [mSkyline[first].x, mSkyline[first].x + width),
+    // with the indices of decreasing heights in the window kept in `maxima`.
+    std::size_t bestFirst = mSkyline.size();
+    T_number bestY = std::numeric_limits<T_number>::max();
+    std::deque<std::size_t> maxima;
+    std::size_t last = 0;
+    for (std::size_t first = 0; first != mSkyline.size(); ++first)
+    {
+        const T_number xEnd = mSkyline[first].x + aSize.width();
+        if (xEnd > mBinSize.width())
+        {
+            break;
+        }
+
+        while (last != mSkyline.size() && mSkyline[last].x < xEnd)
+        {
+            while (!maxima.empty() && mSkyline[maxima.back()].y <= mSkyline[last].y)
+            {
+                maxima.pop_back();
+            }
+            maxima.push_back(last++);
+        }
+        if (maxima.front() < first)
+        {
+            maxima.pop_front();
+        }
+
+        const T_number y = mSkyline[maxima.front()].y;
+        if (y + aSize.height() <= mBinSize.height() && y < bestY)
+        {
+            bestY = y;
+            bestFirst = first;
+        }
+    }
+
+    if (bestFirst == mSkyline.size())
+    {
+        return std::nullopt;
+    }
+
+    Rectangle<T_number> placed{{mSkyline[bestFirst].x, bestY}, aSize};
+
+    // The new segment replaces the entirely covered segments [bestFirst, covered),
+    // and shortens the following segment if it is partially covered.
+    const T_number xEnd = placed.xMax();
+    std::size_t covered = bestFirst;
+    while (covered != mSkyline.size() && mSkyline[covered].xMax() <= xEnd)
+    {
+        ++covered;
+    }
+    if (covered != mSkyline.size() && mSkyline[covered].x < xEnd)
+    {
+        mSkyline[covered].width = mSkyline[covered].xMax() - xEnd;
+        mSkyline[covered].x = xEnd;
+    }
+
+    const Segment top{placed.x(), placed.yMax(), aSize.width()};
+    if (covered == bestFirst)
+    {
+        mSkyline.insert(mSkyline.begin() + bestFirst, top);
+    }
+    else
+    {
+        mSkyline[bestFirst] = top;
+        mSkyline.erase(mSkyline.begin() + bestFirst + 1, mSkyline.begin() + covered);
+    }
+
+    // Merge with neighbours at the same height
+    if (bestFirst + 1 != mSkyline.size() && mSkyline[bestFirst + 1].y == mSkyline[bestFirst].y)
+    {
+        mSkyline[bestFirst].width += mSkyline[bestFirst + 1].width;
+        mSkyline.erase(mSkyline.begin() + bestFirst + 1);
+    }
+    if (bestFirst != 0 && mSkyline[bestFirst - 1].y == mSkyline[bestFirst].y)
+    {
+        mSkyline[bestFirst - 1].width += mSkyline[bestFirst].width;
+        mSkyline.erase(mSkyline.begin() + bestFirst);
+    }
+
+    mUsedArea += placed.area();
+    return placed;
+}
+
+
+template <class T_number>
+MaxRectsPacker<T_number>::MaxRectsPacker(Size<2, T_number> aBinSize) :
+    mBinSize{aBinSize}
+{
+    reset();
+}
+
+
+template <class T_number>
+void MaxRectsPacker<T_number>::reset()
+{
+    mFreeRectangles.assign(1, Rectangle<T_number>::AtOrigin(mBinSize));
+    mUsedArea = 0;
+}
+
+
+template <class T_number>
+std::optional<Rectangle<T_number>> MaxRectsPacker<T_number>::insert(Size<2, T_number> aSize)
+{
+    if (aSize.width() <= 0 || aSize.height() <= 0)
+    {
+        return std::nullopt;
+    }
+
+    const Rectangle<T_number> * best = nullptr;
+    T_number bestShortSide = std::numeric_limits<T_number>::max();
+    T_number bestLongSide = std::numeric_limits<T_number>::max();
+    for (const Rectangle<T_number> & free : mFreeRectangles)
+    {
+        if (free.width() >= aSize.width() && free.height() >= aSize.height())
+        {
+            T_number leftoverX = free.width() - aSize.width();
+            T_number leftoverY = free.height() - aSize.height();
+            T_number shortSide = std::min(leftoverX, leftoverY);
+            T_number longSide = std::max(leftoverX, leftoverY);
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+            {
+                best = &free;
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+            }
+        }
+    }
+
+    if (best == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    Rectangle<T_number> placed{best->origin(), aSize};
+    splitFreeRectangles(placed);
+    pruneFreeRectangles();
+
+    mUsedArea += placed.area();
+    return placed;
+}
+
+
+template <class T_number>
+void MaxRectsPacker<T_number>::splitFreeRectangles(const Rectangle<T_number> & aPlaced)
+{
+    // Compact the free rectangles not intersecting aPlaced at the front,
+    // and collect the split rectangles in the scratch storage.
+    std::size_t kept = 0;
+    for (const Rectangle<T_number> free : mFreeRectangles)
+    {
+        if (aPlaced.xMin() >= free.xMax() || aPlaced.xMax() <= free.xMin()
+            || aPlaced.yMin() >= free.yMax() || aPlaced.yMax() <= free.yMin())
+        {
+            mFreeRectangles[kept++] = free;
+            continue;
+        }
+
+        // Up to four maximal rectangles remain around the intersection.
+        if (aPlaced.xMin() > free.xMin())
+        {
+            mSplit.push_back({free.origin(), {aPlaced.xMin() - free.xMin(), free.height()}});
+        }
+        if (aPlaced.xMax() < free.xMax())
+        {
+            mSplit.push_back({{aPlaced.xMax(), free.y()}, {free.xMax() - aPlaced.xMax(), free.height()}});
+        }
+        if (aPlaced.yMin() > free.yMin())
+        {
+            mSplit.push_back({free.origin(), {free.width(), aPlaced.yMin() - free.yMin()}});
+        }
+        if (aPlaced.yMax() < free.yMax())
+        {
+            mSplit.push_back({{free.x(), aPlaced.yMax()}, {free.width(), free.yMax() - aPlaced.yMax()}});
+        }
+    }
+    mFreeRectangles.resize(kept);
+}
+
+
+template <class T_number>
+void MaxRectsPacker<T_number>::pruneFreeRectangles()
+{
+    auto contains = [](const Rectangle<T_number> & aOuter, const Rectangle<T_number> & aInner)
+    {
+        return aInner.xMin() >= aOuter.xMin() && aInner.xMax() <= aOuter.xMax()
+            && aInner.yMin() >= aOuter.yMin() && aInner.yMax() <= aOuter.yMax();
+    };
+
+    // The kept free rectangles were not containing each other before the split,
+    // and cannot be contained in a split rectangle (it is a subset of a previous free rectangle).
+    // So only the split rectangles have to be tested.
+    const std::size_t keptCount = mFreeRectangles.size();
+    for (std::size_t splitId = 0; splitId != mSplit.size(); ++splitId)
+    {
+        const Rectangle<T_number> & candidate = mSplit[splitId];
+        bool redundant =
+            std::any_of(mFreeRectangles.begin(), mFreeRectangles.begin() + keptCount,
+                        [&](const Rectangle<T_number> & aOther){ return contains(aOther, candidate); });
+
+        for (std::size_t otherId = 0; !redundant && otherId != mSplit.size(); ++otherId)
+        {
+            // When two split rectangles are equal, only the first one is kept.
+            redundant = (otherId != splitId)
+                        && contains(mSplit[otherId], candidate)
+                        && (otherId < splitId || !contains(candidate, mSplit[otherId]));
+        }
+
+        if (!redundant)
+        {
+            mFreeRectangles.push_back(candidate);
+        }
+    }
+    mSplit.clear();
+}
+
+
+template <class T_packer>
+std::vector<std::optional<Rectangle<typename T_packer::value_type>>>
+insertBatch(T_packer & aPacker, std::span<const Size<2, typename T_packer::value_type>> aSizes)
+{
+    using T_number = typename T_packer::value_type;
+
+    std::vector<std::size_t> order(aSizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t aLhs, std::size_t aRhs)
+    {
+        return aSizes[aLhs].height() > aSizes[aRhs].height()
+            || (aSizes[aLhs].height() == aSizes[aRhs].height() && aSizes[aLhs].width() > aSizes[aRhs].width());
+    });
+
+    std::vector<std::optional<Rectangle<T_number>>> placements(aSizes.size());
+    for (std::size_t index : order)
+    {
+        placements[index] = aPacker.insert(aSizes[index]);
+    }
+    return placements;
+}
+
+
+} // namespace math
+} // namespace ad
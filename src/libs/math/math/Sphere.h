@@ -0,0 +1,278 @@
+#pragma once
+
+
+#include "Utilities.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief A ball of arbitrary dimension (i.e. a disc in 2D), defined by its center and radius.
+template <int N_dimension, class T_number = real_number>
+struct Sphere
+{
+    using Position_t = Position<N_dimension, T_number>;
+
+    template <class T_positionValue>
+    bool contains(Position<N_dimension, T_positionValue> aPosition) const
+    { return (aPosition - mCenter).getNormSquared() <= mRadius * mRadius; }
+
+    /// \brief If the sphere does not include `aPosition`, grow it just enough so it does.
+    ///
+    /// The sphere is extended on the side of `aPosition`, so it still contains the initial sphere.
+    void extendTo(Position_t aPosition);
+
+    bool operator==(const Sphere & aRhs) const
+    { return mCenter == aRhs.mCenter && mRadius == aRhs.mRadius; }
+    bool operator!=(const Sphere & aRhs) const
+    { return !(*this == aRhs); }
+
+    /// \brief Fast approximate bounding sphere, in two passes over the points.
+    ///
+    /// The initial sphere is spanned by two distant points, then grown to include each point.
+    /// The result is usually within 5 to 20% of the minimal bounding sphere radius.
+    /// \see Ritter, Graphics Gems p301
+    static Sphere FromPointsRitter(std::span<const Position_t> aPoints);
+
+    /// \brief Exact minimal bounding sphere, in expected linear time.
+    ///
+    /// Implements Welzl's randomized algorithm, with the recursion unrolled over the points.
+    /// The remaining recursion depth is bounded by the number of support points (N_dimension + 1).
+    /// \note Allocates a shuffled copy of the point indices.
+    static Sphere FromPointsWelzl(std::span<const Position_t> aPoints);
+
+    Position_t mCenter;
+    T_number mRadius;
+};
+
+
+namespace detail {
+
+
+    /// \brief The smallest sphere whose boundary goes through all of the (at most N+1) positions.
+    ///
+    /// This is the circumsphere whose center lies in the affine hull of the positions.
+    /// If the positions are not affinely independent, return the sphere spanned by the two
+    /// most distant positions instead.
+    template <int N_dimension, class T_number>
+    Sphere<N_dimension, T_number> circumsphere(const Position<N_dimension, T_number> * aPositions,
+                                               std::size_t aCount)
+    {
+        using Sphere_t = Sphere<N_dimension, T_number>;
+        assert(aCount >= 1 && aCount <= N_dimension + 1);
+
+        if (aCount == 1)
+        {
+            return Sphere_t{aPositions[0], T_number{0}};
+        }
+
+        // center = p0 + sum(lambda_i * v_i), with v_i = p_i - p0.
+        // Equidistance to p0 and p_i leads to the system 2 * (v_i . v_j) * lambda_j = v_i . v_i
+        const std::size_t size = aCount - 1;
+        auto v = makeFilledArray<N_dimension>(Vec<N_dimension, T_number>::Zero());
+        std::array<std::array<T_number, N_dimension + 1>, N_dimension> system;
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            v[i] = aPositions[i + 1] - aPositions[0];
+        }
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                system[i][j] = 2 * v[i].dot(v[j]);
+            }
+            system[i][size] = v[i].getNormSquared();
+        }
+
+        T_number scale{0};
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            scale = std::max(scale, system[i][i]);
+        }
+
+        // Gaussian elimination with partial pivoting
+        bool degenerate = false;
+        for (std::size_t column = 0; column != size && !degenerate; ++column)
+        {
+            std::size_t pivot = column;
+            for (std::size_t row = column + 1; row != size; ++row)
+            {
+                if (std::abs(system[row][column]) > std::abs(system[pivot][column]))
+                {
+                    pivot = row;
+                }
+            }
+            std::swap(system[pivot], system[column]);
+
+            // Relative to the squared lengths, so the test does not depend on the unit.
+            if (std::abs(system[column][column]) <= 64 * std::numeric_limits<T_number>::epsilon() * scale)
+            {
+                degenerate = true;
+                break;
+            }
+
+            for (std::size_t row = column + 1; row != size; ++row)
+            {
+                T_number factor = system[row][column] / system[column][column];
+                for (std::size_t k = column; k != size + 1; ++k)
+                {
+                    system[row][k] -= factor * system[column][k];
+                }
+            }
+        }
+
+        if (degenerate)
+        {
+            Sphere_t result{aPositions[0], T_number{0}};
+            for (std::size_t i = 0; i != aCount; ++i)
+            {
+                for (std::size_t j = i + 1; j != aCount; ++j)
+                {
+                    T_number radius = (aPositions[j] - aPositions[i]).getNorm() / 2;
+                    if (radius > result.mRadius)
+                    {
+                        result = Sphere_t{aPositions[i] + (aPositions[j] - aPositions[i]) / 2, radius};
+                    }
+                }
+            }
+            return result;
+        }
+
+        Position<N_dimension, T_number> center = aPositions[0];
+        std::array<T_number, N_dimension> lambdas;
+        for (std::size_t row = size; row-- != 0;)
+        {
+            T_number accumulator = system[row][size];
+            for (std::size_t k = row + 1; k != size; ++k)
+            {
+                accumulator -= system[row][k] * lambdas[k];
+            }
+            lambdas[row] = accumulator / system[row][row];
+            center += lambdas[row] * v[row];
+        }
+        return Sphere_t{center, (aPositions[0] - center).getNorm()};
+    }
+
+
+    /// \brief Tolerant containment test, so numerical errors do not invalidate support points.
+    template <int N_dimension, class T_number>
+    bool containsWithTolerance(const Sphere<N_dimension, T_number> & aSphere,
+                               Position<N_dimension, T_number> aPosition)
+    {
+        const T_number tolerance = 1 + 64 * std::numeric_limits<T_number>::epsilon();
+        return (aPosition - aSphere.mCenter).getNorm() <= aSphere.mRadius * tolerance;
+    }
+
+
+    /// \brief Minimal sphere enclosing the `aCount` first points in `aOrder`,
+    /// with the `aSupportCount` first positions of `aSupport` on its boundary.
+    template <int N_dimension, class T_number>
+    Sphere<N_dimension, T_number> welzlWithSupport(std::span<const Position<N_dimension, T_number>> aPoints,
+                                                   const std::vector<std::size_t> & aOrder,
+                                                   std::size_t aCount,
+                                                   std::array<Position<N_dimension, T_number>, N_dimension + 1> & aSupport,
+                                                   std::size_t aSupportCount)
+    {
+        if (aSupportCount == N_dimension + 1)
+        {
+            return circumsphere(aSupport.data(), aSupportCount);
+        }
+
+        // Without support, start from an empty sphere (negative radius) which contains no point.
+        Sphere<N_dimension, T_number> sphere =
+            aSupportCount == 0 ? Sphere<N_dimension, T_number>{aSupport[0], T_number{-1}}
+                               : circumsphere(aSupport.data(), aSupportCount);
+
+        for (std::size_t orderId = 0; orderId != aCount; ++orderId)
+        {
+            const Position<N_dimension, T_number> & point = aPoints[aOrder[orderId]];
+            if (!containsWithTolerance(sphere, point))
+            {
+                aSupport[aSupportCount] = point;
+                sphere = welzlWithSupport(aPoints, aOrder, orderId, aSupport, aSupportCount + 1);
+            }
+        }
+        return sphere;
+    }
+
+
+} // namespace detail
+
+
+//
+// Implementations
+//
+template <int N_dimension, class T_number>
+void Sphere<N_dimension, T_number>::extendTo(Position_t aPosition)
+{
+    Vec<N_dimension, T_number> toPosition = aPosition - mCenter;
+    T_number distance = toPosition.getNorm();
+    if (distance > mRadius)
+    {
+        T_number newRadius = (mRadius + distance) / 2;
+        mCenter += ((newRadius - mRadius) / distance) * toPosition;
+        mRadius = newRadius;
+    }
+}
+
+
+template <int N_dimension, class T_number>
+Sphere<N_dimension, T_number> Sphere<N_dimension, T_number>::FromPointsRitter(std::span<const Position_t> aPoints)
+{
+    assert(!aPoints.empty());
+
+    auto farthestFrom = [&](const Position_t & aOrigin)
+    {
+        return *std::max_element(aPoints.begin(), aPoints.end(),
+                                 [&](const Position_t & aLhs, const Position_t & aRhs)
+                                 {
+                                     return (aLhs - aOrigin).getNormSquared() < (aRhs - aOrigin).getNormSquared();
+                                 });
+    };
+
+    const Position_t y = farthestFrom(aPoints.front());
+    const Position_t z = farthestFrom(y);
+
+    Sphere result{y + (z - y) / 2, (z - y).getNorm() / 2};
+    for (const Position_t & point : aPoints)
+    {
+        result.extendTo(point);
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+Sphere<N_dimension, T_number> Sphere<N_dimension, T_number>::FromPointsWelzl(std::span<const Position_t> aPoints)
+{
+    assert(!aPoints.empty());
+
+    // Expected linear time relies on a random order, a fixed seed keeps results reproducible.
+    std::vector<std::size_t> order(aPoints.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::minstd_rand{static_cast<unsigned int>(aPoints.size())});
+
+    auto support = makeFilledArray<N_dimension + 1>(aPoints.front());
+    return detail::welzlWithSupport(aPoints, order, aPoints.size(), support, 0);
+}
+
+
+template <int N_dimension, class T_number>
+std::ostream & operator<<(std::ostream & os, const Sphere<N_dimension, T_number> & aSphere)
+{
+    return os << "[ {" << aSphere.mCenter << "}, " << aSphere.mRadius << " ]";
+}
+
+
+} // namespace math
+} // namespace ad
@@ -0,0 +1,315 @@
+#pragma once
+
+
+#include "Barycentric.h"
+#include "Rectangle.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace ad {
+namespace math {
+
+
+/// \brief Incremental edge function rasterizer for 2D triangles.
+///
+/// The triangle setup (edge functions, orientation, fill rule) is done once at construction,
+/// the edge functions are then stepped by additions along each row of pixels.
+///
+/// Pixel (x, y) covers [x, x+1) x [y, y+1), and is sampled at its center (x + 0.5, y + 0.5).
+/// The top-left fill rule is applied: a pixel center exactly on an edge is covered only if
+/// the edge is a left edge, or a top edge (horizontal, with the interior below it, Y pointing up).
+/// This way, pixels on an edge shared by two triangles are rasterized exactly once.
+///
+/// \note The fill rule relies on exact evaluation of the edge functions at pixel centers.
+/// This is the case for floating point vertex positions snapped to a sub-pixel grid
+/// (e.g. 1/256th of a pixel), which is the recommended usage.
+template <class T_number>
+class TriangleRasterizer
+{
+public:
+    using Coordinates = typename Barycentric<T_number>::Coordinates;
+
+    /// \brief A horizontal run of `N_lanes` pixels, starting at a multiple of `N_lanes` in x.
+    ///
+    /// The barycentric coordinates are stored as structure of arrays.
+    template <int N_lanes>
+    struct Block
+    {
+        static_assert(N_lanes > 0 && N_lanes <= 32, "The coverage mask holds at most 32 lanes.");
+
+        bool isCovered(int aLane) const
+        { return (mCoverage & (std::uint32_t{1} << aLane)) != 0; }
+
+        int mX;
+        int mY;
+        /// \brief Bit i is set if pixel (mX + i, mY) is covered.
+        std::uint32_t mCoverage;
+        std::array<T_number, N_lanes> mAlpha;
+        std::array<T_number, N_lanes> mBeta;
+        std::array<T_number, N_lanes> mGamma;
+    };
+
+    /// \note The triangle can be given in either winding order.
+    TriangleRasterizer(Position<2, T_number> aPointA, Position<2, T_number> aPointB, Position<2, T_number> aPointC);
+
+    /// \brief A degenerate (zero area) triangle does not cover any pixel.
+    bool isDegenerate() const
+    { return mDoubleArea == T_number{0}; }
+
+    /// \brief The smallest rectangle of pixels containing all pixels with a center in the triangle bounding box.
+    ///
+    /// It might have a zero dimension.
+    Rectangle<int> getPixelBounds() const;
+
+    /// \brief Invoke `aVisitor(int x, int y, Coordinates)` for each pixel in `aRegion` covered by the triangle.
+    ///
+    /// Pixels are visited row by row, by increasing x.
+    template <class F_visitor>
+    void rasterize(Rectangle<int> aRegion, F_visitor && aVisitor) const;
+
+    /// \brief Invoke `aVisitor(const Block<N_lanes> &)` for each block in `aRegion` with at least a covered pixel.
+    ///
+    /// Blocks are aligned on multiples of `N_lanes` in x (e.g. to map onto the tiles of an occlusion buffer),
+    /// pixels outside of `aRegion` are never marked covered.
+    /// The lanes of a block are computed independently of each other, in loops the compiler can vectorize.
+    template <int N_lanes, class F_visitor>
+    void rasterizeBlocks(Rectangle<int> aRegion, F_visitor && aVisitor) const;
+
+private:
+    /// \brief Rows and columns of pixels both in `aRegion` and the triangle pixel bounds, as [first, last).
+    struct Span
+    {
+        int xFirst;
+        int xLast;
+        int yFirst;
+        int yLast;
+    };
+
+    Span getSpan(Rectangle<int> aRegion) const;
+
+    T_number evaluate(std::size_t aEdge, T_number aX, T_number aY) const
+    { return mA[aEdge] * aX + mB[aEdge] * aY + mC[aEdge]; }
+
+    bool isInside(std::size_t aEdge, T_number aValue) const
+    { return (aValue > T_number{0}) | ((aValue == T_number{0}) & mTopLeft[aEdge]); }
+
+private:
+    // Edge i is opposite to vertex i, its function is positive inside the triangle.
+    std::array<T_number, 3> mA;
+    std::array<T_number, 3> mB;
+    std::array<T_number, 3> mC;
+    std::array<bool, 3> mTopLeft;
+
+    T_number mDoubleArea;
+    T_number mInverseDoubleArea;
+
+    Position<2, T_number> mLow;
+    Position<2, T_number> mHigh;
+};
+
+
+//
+// Implementations
+//
+template <class T_number>
+TriangleRasterizer<T_number>::TriangleRasterizer(Position<2, T_number> aPointA,
+                                                 Position<2, T_number> aPointB,
+                                                 Position<2, T_number> aPointC) :
+    mA{aPointB.y() - aPointC.y(), aPointC.y() - aPointA.y(), aPointA.y() - aPointB.y()},
+    mB{aPointC.x() - aPointB.x(), aPointA.x() - aPointC.x(), aPointB.x() - aPointA.x()},
+    mC{aPointB.x() * aPointC.y() - aPointC.x() * aPointB.y(),
+       aPointC.x() * aPointA.y() - aPointA.x() * aPointC.y(),
+       aPointA.x() * aPointB.y() - aPointB.x() * aPointA.y()},
+    mDoubleArea{mC[0] + mC[1] + mC[2]},
+    mInverseDoubleArea{0},
+    mLow{std::min({aPointA.x(), aPointB.x(), aPointC.x()}), std::min({aPointA.y(), aPointB.y(), aPointC.y()})},
+    mHigh{std::max({aPointA.x(), aPointB.x(), aPointC.x()}), std::max({aPointA.y(), aPointB.y(), aPointC.y()})}
+{
+    static_assert(std::is_floating_point<T_number>::value, "Not yet implement for non-floating point coordinates");
+
+    // Clockwise triangle: flip the edge functions so they are positive inside.
+    if (mDoubleArea < T_number{0})
+    {
+        for (std::size_t edge = 0; edge != 3; ++edge)
+        {
+            mA[edge] = -mA[edge];
+            mB[edge] = -mB[edge];
+            mC[edge] = -mC[edge];
+        }
+        mDoubleArea = -mDoubleArea;
+    }
+
+    if (!isDegenerate())
+    {
+        mInverseDoubleArea = T_number{1} / mDoubleArea;
+    }
+
+    for (std::size_t edge = 0; edge != 3; ++edge)
+    {
+        // (a, b) is the inward normal of the edge.
+        mTopLeft[edge] = (mA[edge] > T_number{0}) || (mA[edge] == T_number{0} && mB[edge] < T_number{0});
+    }
+}
+
+
+template <class T_number>
+Rectangle<int> TriangleRasterizer<T_number>::getPixelBounds() const
+{
+    // Pixels whose center (x + 0.5) is in [low, high]
+    Position<2, int> first{
+        static_cast<int>(std::ceil(mLow.x() - T_number{0.5})),
+        static_cast<int>(std::ceil(mLow.y() - T_number{0.5})),
+    };
+    Position<2, int> last{
+        static_cast<int>(std::floor(mHigh.x() - T_number{0.5})) + 1,
+        static_cast<int>(std::floor(mHigh.y() - T_number{0.5})) + 1,
+    };
+    return {first, {std::max(0, last.x() - first.x()), std::max(0, last.y() - first.y())}};
+}
+
+
+template <class T_number>
+auto TriangleRasterizer<T_number>::getSpan(Rectangle<int> aRegion) const -> Span
+{
+    const Rectangle<int> bounds = getPixelBounds();
+    return {
+        std::max(bounds.xMin(), aRegion.xMin()),
+        std::min(bounds.xMax(), aRegion.xMax()),
+        std::max(bounds.yMin(), aRegion.yMin()),
+        std::min(bounds.yMax(), aRegion.yMax()),
+    };
+}
+
+
+template <class T_number>
+template <class F_visitor>
+void TriangleRasterizer<T_number>::rasterize(Rectangle<int> aRegion, F_visitor && aVisitor) const
+{
+    if (isDegenerate())
+    {
+        return;
+    }
+
+    const Span span = getSpan(aRegion);
+    const T_number xStart = static_cast<T_number>(span.xFirst) + T_number{0.5};
+
+    for (int y = span.yFirst; y < span.yLast; ++y)
+    {
+        // Each row is evaluated directly, so errors do not accumulate across rows.
+        const T_number yCenter = static_cast<T_number>(y) + T_number{0.5};
+        std::array<T_number, 3> w{evaluate(0, xStart, yCenter),
+                                  evaluate(1, xStart, yCenter),
+                                  evaluate(2, xStart, yCenter)};
+
+        bool entered = false;
+        for (int x = span.xFirst; x < span.xLast; ++x)
+        {
+            if (isInside(0, w[0]) & isInside(1, w[1]) & isInside(2, w[2]))
+            {
+                entered = true;
+                aVisitor(x, y, Coordinates{
+                    w[0] * mInverseDoubleArea,
+                    w[1] * mInverseDoubleArea,
+                    w[2] * mInverseDoubleArea,
+                });
+            }
+            // The triangle is convex: once exited, the remaining of the row is outside.
+            else if (entered)
+            {
+                break;
+            }
+
+            w[0] += mA[0];
+            w[1] += mA[1];
+            w[2] += mA[2];
+        }
+    }
+}
+
+
+template <class T_number>
+template <int N_lanes, class F_visitor>
+void TriangleRasterizer<T_number>::rasterizeBlocks(Rectangle<int> aRegion, F_visitor && aVisitor) const
+{
+    if (isDegenerate())
+    {
+        return;
+    }
+
+    const Span span = getSpan(aRegion);
+    if (span.xFirst >= span.xLast)
+    {
+        return;
+    }
+
+    // Aligned block start, rounding toward negative infinity.
+    const int xAligned = span.xFirst - (((span.xFirst % N_lanes) + N_lanes) % N_lanes);
+
+    // Offset of each lane relative to the first lane in a block.
+    std::array<std::array<T_number, N_lanes>, 3> laneSteps;
+    for (std::size_t edge = 0; edge != 3; ++edge)
+    {
+        for (int lane = 0; lane != N_lanes; ++lane)
+        {
+            laneSteps[edge][lane] = mA[edge] * static_cast<T_number>(lane);
+        }
+    }
+    const std::array<T_number, 3> blockSteps{mA[0] * N_lanes, mA[1] * N_lanes, mA[2] * N_lanes};
+
+    Block<N_lanes> block;
+    std::array<std::array<T_number, N_lanes>, 3> w;
+    for (int y = span.yFirst; y < span.yLast; ++y)
+    {
+        const T_number yCenter = static_cast<T_number>(y) + T_number{0.5};
+        const T_number xStart = static_cast<T_number>(xAligned) + T_number{0.5};
+        std::array<T_number, 3> base{evaluate(0, xStart, yCenter),
+                                     evaluate(1, xStart, yCenter),
+                                     evaluate(2, xStart, yCenter)};
+
+        bool entered = false;
+        for (int x = xAligned; x < span.xLast; x += N_lanes)
+        {
+            std::uint32_t coverage = 0;
+            for (int lane = 0; lane != N_lanes; ++lane)
+            {
+                w[0][lane] = base[0] + laneSteps[0][lane];
+                w[1][lane] = base[1] + laneSteps[1][lane];
+                w[2][lane] = base[2] + laneSteps[2][lane];
+                const bool inRegion = (x + lane >= span.xFirst) & (x + lane < span.xLast);
+                const bool inside = isInside(0, w[0][lane]) & isInside(1, w[1][lane]) & isInside(2, w[2][lane]);
+                coverage |= static_cast<std::uint32_t>(inRegion & inside) << lane;
+            }
+
+            if (coverage != 0)
+            {
+                entered = true;
+                block.mX = x;
+                block.mY = y;
+                block.mCoverage = coverage;
+                for (int lane = 0; lane != N_lanes; ++lane)
+                {
+                    block.mAlpha[lane] = w[0][lane] * mInverseDoubleArea;
+                    block.mBeta[lane]  = w[1][lane] * mInverseDoubleArea;
+                    block.mGamma[lane] = w[2][lane] * mInverseDoubleArea;
+                }
+                aVisitor(static_cast<const Block<N_lanes> &>(block));
+            }
+            else if (entered)
+            {
+                break;
+            }
+
+            base[0] += blockSteps[0];
+            base[1] += blockSteps[1];
+            base[2] += blockSteps[2];
+        }
+    }
+}
+
+
+}} // namespace ad::math
@@ -0,0 +1,452 @@
+#pragma once
+
+
+#include "Box.h"
+#include "Range.h"
+#include "Rectangle.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+
+namespace ad {
+namespace math {
+
+
+namespace detail {
+
+
+    template <int N_dimension, class T_number>
+    struct AxisAlignedBounds;
+
+    template <class T_number>
+    struct AxisAlignedBounds<2, T_number>
+    {
+        using type = Rectangle<T_number>;
+    };
+
+    template <class T_number>
+    struct AxisAlignedBounds<3, T_number>
+    {
+        using type = Box<T_number>;
+    };
+
+
+    /// \brief Default job launcher for UniformGrid::buildParallel().
+    ///
+    /// Runs job 0 on the calling thread, and each other job on its own std::thread.
+    struct ThreadLauncher
+    {
+        template <class F_job>
+        void operator()(std::size_t aJobCount, F_job && aJob) const
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(aJobCount - 1);
+            for (std::size_t job = 1; job < aJobCount; ++job)
+            {
+                threads.emplace_back([&aJob, job](){ aJob(job); });
+            }
+            aJob(0);
+            for (std::thread & thread : threads)
+            {
+                thread.join();
+            }
+        }
+    };
+
+
+} // namespace detail
+
+
+/// \brief Axis aligned bounding type for a given dimension (i.e. Rectangle in 2D, Box in 3D).
+template <int N_dimension, class T_number>
+using AxisAlignedBounds_t = typename detail::AxisAlignedBounds<N_dimension, T_number>::type;
+
+
+/// \brief Broadphase structure partitioning a fixed region of space in cubic cells of equal size.
+///
+/// The points are bucketed by a counting sort: the grid stores the point indices sorted by cell,
+/// alongside a copy of the positions in the same order, so queries read contiguous memory.
+/// It is intended to be rebuilt entirely each time the points move (e.g. every frame).
+///
+/// \note Points outside of the bounds are attributed to the closest border cell,
+/// so queries remain exact (but will be slower if many points are outside).
+template <int N_dimension, class T_number = real_number>
+class UniformGrid
+{
+    static_assert(N_dimension == 2 || N_dimension == 3, "Grids are implemented for dimensions 2 and 3.");
+
+public:
+    using Position_t = Position<N_dimension, T_number>;
+    using Bounds_t = AxisAlignedBounds_t<N_dimension, T_number>;
+    using Cell_t = std::array<int, N_dimension>;
+    using Index_t = std::uint32_t;
+
+    /// \param aBounds The region covered by the grid, it is rounded up to a whole number of cells.
+    /// \param aCellSize The edge length of each (square or cubic) cell.
+    /// It should usually be close to the query radius.
+    UniformGrid(Bounds_t aBounds, T_number aCellSize);
+
+    /// \brief Bucket `aPoints`, discarding the content from any previous build.
+    void build(std::span<const Position_t> aPoints);
+
+    /// \brief Same result as build(), splitting the work in `aJobCount` jobs.
+    ///
+    /// \param aLauncher Callable as `aLauncher(aJobCount, aJob)`, which must invoke
+    /// `aJob(jobIndex)` for each job index in [0, aJobCount) and return once they are all done.
+    /// It allows client code to dispatch to its own job system,
+    /// the default launcher starts a std::thread per job.
+    template <class T_launcher = detail::ThreadLauncher>
+    void buildParallel(std::span<const Position_t> aPoints,
+                       std::size_t aJobCount,
+                       T_launcher && aLauncher = T_launcher{});
+
+    Size<N_dimension, int> cellCounts() const
+    { return mCellCounts; }
+
+    std::size_t cellCount() const
+    { return mCellStarts.size() - 1; }
+
+    std::size_t pointCount() const
+    { return mSortedIndices.size(); }
+
+    /// \brief The cell containing `aPosition`, or the closest border cell if it is outside the grid.
+    Cell_t cellOf(Position_t aPosition) const;
+
+    std::size_t linearIndex(Cell_t aCell) const;
+
+    Bounds_t cellBounds(Cell_t aCell) const;
+
+    /// \brief The indices (in the built points) of points contained in the cell.
+    std::span<const Index_t> pointsInCell(Cell_t aCell) const;
+
+    /// \brief Invoke `aVisitor(index)` for each built point within `aRadius` of `aCenter`.
+    template <class F_visitor>
+    void queryRadius(Position_t aCenter, T_number aRadius, F_visitor && aVisitor) const;
+
+    /// \brief Invoke `aVisitor(indexA, indexB)` exactly once for each pair of distinct built points
+    /// that are within `aRadius` of each other.
+    template <class F_visitor>
+    void forEachPair(T_number aRadius, F_visitor && aVisitor) const;
+
+private:
+    int cellCoordinate(T_number aValue, std::size_t aAxis) const;
+
+    std::size_t linearCellOf(Position_t aPosition) const
+    { return linearIndex(cellOf(aPosition)); }
+
+    /// \brief Invoke `aVisitor(cellLinearIndex)` for each cell in the inclusive range [aLow, aHigh].
+    template <class F_visitor>
+    void forEachCell(Cell_t aLow, Cell_t aHigh, F_visitor && aVisitor) const;
+
+    /// \brief Allocate the storage for a build of `aPointCount` points.
+    void prepare(std::size_t aPointCount);
+
+    Position_t mOrigin;
+    T_number mCellSize;
+    T_number mInverseCellSize;
+    Size<N_dimension, int> mCellCounts;
+
+    // Cell `c` contains the sorted points in [mCellStarts[c], mCellStarts[c+1]).
+    std::vector<Index_t> mCellStarts;
+    std::vector<Index_t> mSortedIndices;
+    std::vector<Position_t> mSortedPositions;
+    // Scratch storage, the linear cell index of each input point.
+    std::vector<Index_t> mPointCells;
+};
+
+
+//
+// Implementations
+//
+template <int N_dimension, class T_number>
+UniformGrid<N_dimension, T_number>::UniformGrid(Bounds_t aBounds, T_number aCellSize) :
+    mOrigin{aBounds.origin()},
+    mCellSize{aCellSize},
+    mInverseCellSize{T_number{1} / aCellSize},
+    mCellCounts{Size<N_dimension, int>::Zero()}
+{
+    assert(aCellSize > T_number{0});
+
+    std::size_t cellCount = 1;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        mCellCounts[axis] = std::max(
+            1,
+            static_cast<int>(std::ceil(aBounds.dimension()[axis] * mInverseCellSize)));
+        cellCount *= mCellCounts[axis];
+    }
+    mCellStarts.assign(cellCount + 1, 0);
+}
+
+
+template <int N_dimension, class T_number>
+int UniformGrid<N_dimension, T_number>::cellCoordinate(T_number aValue, std::size_t aAxis) const
+{
+    // Clamp in the floating point domain first, so far away values cannot overflow the integer.
+    T_number scaled = std::clamp((aValue - mOrigin[aAxis]) * mInverseCellSize,
+                                 T_number{0},
+                                 static_cast<T_number>(mCellCounts[aAxis] - 1));
+    return static_cast<int>(scaled);
+}
+
+
+template <int N_dimension, class T_number>
+auto UniformGrid<N_dimension, T_number>::cellOf(Position_t aPosition) const -> Cell_t
+{
+    Cell_t cell;
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        cell[axis] = cellCoordinate(aPosition[axis], axis);
+    }
+    return cell;
+}
+
+
+template <int N_dimension, class T_number>
+std::size_t UniformGrid<N_dimension, T_number>::linearIndex(Cell_t aCell) const
+{
+    // Same layout as MultiRange: the first axis varies fastest.
+    std::size_t result = aCell[N_dimension - 1];
+    for (int axis = N_dimension - 2; axis >= 0; --axis)
+    {
+        result = result * mCellCounts[axis] + aCell[axis];
+    }
+    return result;
+}
+
+
+template <int N_dimension, class T_number>
+auto UniformGrid<N_dimension, T_number>::cellBounds(Cell_t aCell) const -> Bounds_t
+{
+    Position_t origin = mOrigin;
+    Size<N_dimension, T_number> dimension = Size<N_dimension, T_number>::Zero();
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        origin[axis] += aCell[axis] * mCellSize;
+        dimension[axis] = mCellSize;
+    }
+    return {origin, dimension};
+}
+
+
+template <int N_dimension, class T_number>
+auto UniformGrid<N_dimension, T_number>::pointsInCell(Cell_t aCell) const -> std::span<const Index_t>
+{
+    std::size_t cell = linearIndex(aCell);
+    return {mSortedIndices.data() + mCellStarts[cell], mSortedIndices.data() + mCellStarts[cell + 1]};
+}
+
+
+template <int N_dimension, class T_number>
+void UniformGrid<N_dimension, T_number>::prepare(std::size_t aPointCount)
+{
+    assert(aPointCount <= std::numeric_limits<Index_t>::max());
+    std::fill(mCellStarts.begin(), mCellStarts.end(), 0);
+    mPointCells.resize(aPointCount);
+    mSortedIndices.resize(aPointCount);
+    mSortedPositions.resize(aPointCount, Position_t::Zero());
+}
+
+
+template <int N_dimension, class T_number>
+void UniformGrid<N_dimension, T_number>::build(std::span<const Position_t> aPoints)
+{
+    prepare(aPoints.size());
+
+    // Histogram, offset by one so the exclusive prefix sum is computed in place.
+    for (std::size_t pointId = 0; pointId != aPoints.size(); ++pointId)
+    {
+        Index_t cell = static_cast<Index_t>(linearCellOf(aPoints[pointId]));
+        mPointCells[pointId] = cell;
+        ++mCellStarts[cell + 1];
+    }
+
+    for (std::size_t cell = 1; cell != mCellStarts.size(); ++cell)
+    {
+        mCellStarts[cell] += mCellStarts[cell - 1];
+    }
+
+    // Scatter, using a copy of the cell starts as write cursors.
+    std::vector<Index_t> cursors(mCellStarts.begin(), mCellStarts.end() - 1);
+    for (std::size_t pointId = 0; pointId != aPoints.size(); ++pointId)
+    {
+        Index_t destination = cursors[mPointCells[pointId]]++;
+        mSortedIndices[destination] = static_cast<Index_t>(pointId);
+        mSortedPositions[destination] = aPoints[pointId];
+    }
+}
+
+
+template <int N_dimension, class T_number>
+template <class T_launcher>
+void UniformGrid<N_dimension, T_number>::buildParallel(std::span<const Position_t> aPoints,
+                                                       std::size_t aJobCount,
+                                                       T_launcher && aLauncher)
+{
+    aJobCount = std::clamp<std::size_t>(aJobCount, 1, std::max<std::size_t>(1, aPoints.size()));
+
+    prepare(aPoints.size());
+
+    const std::size_t cells = cellCount();
+    const std::size_t chunkSize = (aPoints.size() + aJobCount - 1) / aJobCount;
+    auto chunkBegin = [&](std::size_t aJob)
+    {
+        return std::min(aJob * chunkSize, aPoints.size());
+    };
+
+    // Each job counts its own chunk in a private histogram (job major).
+    std::vector<Index_t> histograms(aJobCount * cells, 0);
+    aLauncher(aJobCount, [&](std::size_t aJob)
+    {
+        Index_t * histogram = histograms.data() + aJob * cells;
+        for (std::size_t pointId = chunkBegin(aJob); pointId != chunkBegin(aJob + 1); ++pointId)
+        {
+            Index_t cell = static_cast<Index_t>(linearCellOf(aPoints[pointId]));
+            mPointCells[pointId] = cell;
+            ++histogram[cell];
+        }
+    });
+
+    // Turn the histograms into per-job write cursors.
+    // Within a cell, the earlier jobs come first, which makes the result identical to build().
+    Index_t accumulated = 0;
+    for (std::size_t cell = 0; cell != cells; ++cell)
+    {
+        mCellStarts[cell] = accumulated;
+        for (std::size_t job = 0; job != aJobCount; ++job)
+        {
+            Index_t count = histograms[job * cells + cell];
+            histograms[job * cells + cell] = accumulated;
+            accumulated += count;
+        }
+    }
+    mCellStarts[cells] = accumulated;
+
+    aLauncher(aJobCount, [&](std::size_t aJob)
+    {
+        Index_t * cursors = histograms.data() + aJob * cells;
+        for (std::size_t pointId = chunkBegin(aJob); pointId != chunkBegin(aJob + 1); ++pointId)
+        {
+            Index_t destination = cursors[mPointCells[pointId]]++;
+            mSortedIndices[destination] = static_cast<Index_t>(pointId);
+            mSortedPositions[destination] = aPoints[pointId];
+        }
+    });
+}
+
+
+template <int N_dimension, class T_number>
+template <class F_visitor>
+void UniformGrid<N_dimension, T_number>::forEachCell(Cell_t aLow, Cell_t aHigh, F_visitor && aVisitor) const
+{
+    Size<N_dimension, int> extent = Size<N_dimension, int>::Zero();
+    for (std::size_t axis = 0; axis != N_dimension; ++axis)
+    {
+        extent[axis] = aHigh[axis] - aLow[axis] + 1;
+    }
+
+    for (MultiRange<int, N_dimension> range{extent}; range != range; ++range)
+    {
+        Cell_t cell = *range;
+        for (std::size_t axis = 0; axis != N_dimension; ++axis)
+        {
+            cell[axis] += aLow[axis];
+        }
+        aVisitor(linearIndex(cell));
+    }
+}
+
+
+template <int N_dimension, class T_number>
+template <class F_visitor>
+void UniformGrid<N_dimension, T_number>::queryRadius(Position_t aCenter,
+                                                     T_number aRadius,
+                                                     F_visitor && aVisitor) const
+{
+    Vec<N_dimension, T_number> reach = Vec<N_dimension, T_number>::Zero();
+    std::fill(reach.begin(), reach.end(), aRadius);
+    const T_number radiusSquared = aRadius * aRadius;
+
+    forEachCell(cellOf(aCenter - reach), cellOf(aCenter + reach), [&](std::size_t aCell)
+    {
+        for (Index_t sorted = mCellStarts[aCell]; sorted != mCellStarts[aCell + 1]; ++sorted)
+        {
+            if ((mSortedPositions[sorted] - aCenter).getNormSquared() <= radiusSquared)
+            {
+                aVisitor(mSortedIndices[sorted]);
+            }
+        }
+    });
+}
+
+
+template <int N_dimension, class T_number>
+template <class F_visitor>
+void UniformGrid<N_dimension, T_number>::forEachPair(T_number aRadius, F_visitor && aVisitor) const
+{
+    const T_number radiusSquared = aRadius * aRadius;
+    const int reach = static_cast<int>(std::ceil(aRadius * mInverseCellSize));
+
+    for (MultiRange<int, N_dimension> range{mCellCounts}; range != range; ++range)
+    {
+        const Cell_t cell = *range;
+        const std::size_t current = linearIndex(cell);
+        const Index_t currentBegin = mCellStarts[current];
+        const Index_t currentEnd = mCellStarts[current + 1];
+        if (currentBegin == currentEnd)
+        {
+            continue;
+        }
+
+        // Pairs within the current cell.
+        for (Index_t a = currentBegin; a != currentEnd; ++a)
+        {
+            for (Index_t b = a + 1; b != currentEnd; ++b)
+            {
+                if ((mSortedPositions[b] - mSortedPositions[a]).getNormSquared() <= radiusSquared)
+                {
+                    aVisitor(mSortedIndices[a], mSortedIndices[b]);
+                }
+            }
+        }
+
+        // Pairs with neighbour cells, only visiting the neighbours of greater linear index
+        // so each pair of cells is visited once.
+        Cell_t low;
+        Cell_t high;
+        for (std::size_t axis = 0; axis != N_dimension; ++axis)
+        {
+            low[axis] = std::max(0, cell[axis] - reach);
+            high[axis] = std::min(mCellCounts[axis] - 1, cell[axis] + reach);
+        }
+        forEachCell(low, high, [&](std::size_t aNeighbour)
+        {
+            if (aNeighbour <= current)
+            {
+                return;
+            }
+            for (Index_t a = currentBegin; a != currentEnd; ++a)
+            {
+                for (Index_t b = mCellStarts[aNeighbour]; b != mCellStarts[aNeighbour + 1]; ++b)
+                {
+                    if ((mSortedPositions[b] - mSortedPositions[a]).getNormSquared() <= radiusSquared)
+                    {
+                        aVisitor(mSortedIndices[a], mSortedIndices[b]);
+                    }
+                }
+            }
+        });
+    }
+}
+
+
+} // namespace math
+} // namespace ad
@@ -1,7 +1,9 @@
 #pragma once
 
 
+#include <array>
 #include <cmath>
+#include <utility>
 
 
 namespace ad {
@@ -34,6 +36,22 @@ std::index_sequence<(N_offset + VN_indices)...> addSequenceOffset(std::index_seq
 }
 
 
+template <class T_value, std::size_t... VN_indices>
+constexpr std::array<T_value, sizeof...(VN_indices)> makeFilledArray(const T_value & aValue,
+                                                                     std::index_sequence<VN_indices...>)
+{
+    return {{(static_cast<void>(VN_indices), aValue)...}};
+}
+
+
+template <class T_parameter, class F_function, std::size_t... VN_indices>
+constexpr auto makeSampledArray(F_function && aFunction, std::index_sequence<VN_indices...>)
+{
+    constexpr T_parameter lastIndex = static_cast<T_parameter>(sizeof...(VN_indices) - 1);
+    return std::array{aFunction(static_cast<T_parameter>(VN_indices) / lastIndex)...};
+}
+
+
 } // namespace detail
 
 
@@ -53,4 +71,28 @@ auto makeIndexSequence()
 }
 
 
+/// \brief Return an array of `N_size` copies of `aValue`.
+///
+/// Notably useful for element types which are not default constructible (e.g. Vec, Position).
+template <std::size_t N_size, class T_value>
+constexpr std::array<T_value, N_size> makeFilledArray(const T_value & aValue)
+{
+    return detail::makeFilledArray(aValue, std::make_index_sequence<N_size>());
+}
+
+
+/// \brief Return an array of the values of `aFunction` at `N_size` parameters evenly spaced over [0, 1].
+///
+/// It is a constant expression when `aFunction` is, notably to generate lookup tables at compile time:
+/// \code
+/// constexpr auto ramp = makeSampledArray<256>([](double t){ return ease::SmoothStep<double>{}.ease(t); });
+/// \endcode
+template <std::size_t N_size, class T_parameter = double, class F_function>
+constexpr auto makeSampledArray(F_function && aFunction)
+{
+    static_assert(N_size >= 2, "Sampling requires both ends of the parameter range.");
+    return detail::makeSampledArray<T_parameter>(aFunction, std::make_index_sequence<N_size>());
+}
+
+
 }} // namespace ad::math
@@ -239,8 +239,8 @@ struct addition_trait<Position<N_dimension, T_number>, Vec<N_dimension, T_number
 {};
 
 template <int N_dimension, class T_number>
-Vec<N_dimension, T_number> operator-(Position<N_dimension, T_number> aLhs,
-                                     Position<N_dimension, T_number> aRhs)
+constexpr Vec<N_dimension, T_number> operator-(Position<N_dimension, T_number> aLhs,
+                                               Position<N_dimension, T_number> aRhs)
 {
     Vec<N_dimension, T_number> result = static_cast<Vec<N_dimension, T_number>>(aLhs);
     return (result -= static_cast<Vec<N_dimension, T_number>>(aRhs));